@@ -55,6 +55,10 @@ def tvm_callback_cce_postproc(code, block_dim=1):
     else:
         title_dict = dict()
     title_dict["blockDim"] = block_dim
+    # tile factors of a kernel built with enable_host_tiling, so that a process loading the kernel can compute them
+    host_tiling = akg.tvm.get_global_func("akg.host_tiling.save")(kernel_name)
+    if host_tiling:
+        title_dict["hostTiling"] = host_tiling
 
     # bin file without suffix
     bin_file_name = ""
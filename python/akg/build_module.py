@@ -143,3 +143,24 @@ def build(inputs, args, target=None, shape_params=None, name="default_function",
 
     tmp_target = target if target is not None else 'cce'
     return _api_internal._BuildToModule(tmp_rst, tmp_target)
+
+
+def build_with_shape_dispatch(name, generic, specializations, buckets, target=None):
+    """
+    Build a generic dynamic-shape kernel and its bucket specializations into one module.
+
+    Args:
+        name (str): entry name of the module, the generated host dispatcher.
+        generic (BuildRst): result of build_to_func for the dynamic-shape kernel, named differently from name.
+        specializations (list[BuildRst]): results of build_to_func taking the arguments of generic.
+        buckets (list[dict]): buckets[i] maps shape var names to the upper bounds specializations[i] is built for.
+        target (str): target of the device code, cce by default.
+
+    Returns:
+        Module whose entry takes the same arguments as the generic kernel and calls the smallest bucket that
+        covers the shape arguments, or the generic kernel when none does.
+    """
+    if len(specializations) != len(buckets):
+        raise ValueError("each specialization needs one shape bucket")
+    tmp_target = target if target is not None else 'cce'
+    return _api_internal._BuildToModuleWithDispatch(name, generic, list(specializations), list(buckets), tmp_target)
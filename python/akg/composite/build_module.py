@@ -79,13 +79,22 @@ def generate_trait(desc):
     dtype = generate_dtype_trait()
     return compute, shape, dtype
 
-def _build_to_func(desc_s, desc_d, attr=None):
+def get_trait(desc_s):
+    """ generate trait of kernel description in json format, same as generate_trait without parsing in python """
+    return tuple(t.value for t in tvm.get_global_func("composite_trait")(desc_s))
+
+def parse(desc_s):
+    """ parse the compute description in json format once, the result has its process and trait """
+    return tvm.get_global_func("composite_parse")(desc_s)
+
+def _build_to_func(desc_s, desc_d=None, attr=None, parsed=None):
     """
     build kernel with compute description in json format
     Args:
        desc_s : str of compute description
-       desc_d : dict of compute description
+       desc_d : dict of compute description, not needed since the trait is computed from desc_s
        attr   : dict of build attributes
+       parsed : result of parse(desc_s), desc_s is parsed here when it is None
 
     Returns:
        Module.
@@ -102,7 +111,9 @@ def _build_to_func(desc_s, desc_d, attr=None):
     # turn 'enable_auto_inline' off for composite op by default.
     if 'enable_auto_inline' not in attr:
         attr['enable_auto_inline'] = False
-    compute, shape, dtype = generate_trait(desc_d)
+    if parsed is None:
+        parsed = parse(desc_s)
+    compute, shape, dtype = (t.value for t in parsed.trait)
     repo_attr = get_repo([compute, shape, dtype, 'metadata', 'attrs'], {})
     if not repo_attr:
         repo_attr = get_repo([compute, 'metadata', 'attrs'], {})
@@ -113,14 +124,15 @@ def _build_to_func(desc_s, desc_d, attr=None):
         tiling = get_repo([compute, shape, dtype, 'dim'])
         if tiling:
             attr['dim'] = tiling
-    func = tvm.get_global_func("composite_with_json_to_func")
-    return func(desc_s, attr)
-
-def _build(desc_s, desc_d, attr=None):
-    if desc_d['process'] == 'gpu':
-        func = tvm.get_global_func("composite_with_json")
-        return func(desc_s, attr)
-    rst = _build_to_func(desc_s, desc_d, attr)
+    func = tvm.get_global_func("composite_parsed_to_func")
+    return func(parsed, attr)
+
+def _build(desc_s, desc_d=None, attr=None):
+    parsed = parse(desc_s)
+    if parsed.process in ('gpu', 'cpu'):
+        func = tvm.get_global_func("composite_parsed_build")
+        return func(parsed, attr)
+    rst = _build_to_func(desc_s, desc_d, attr, parsed)
     return _api_internal._BuildToModule(rst)
 
 def build(kernel_desc, attr=None):
@@ -135,12 +147,10 @@ def build(kernel_desc, attr=None):
     """
     if isinstance(kernel_desc, str):
         desc_s = kernel_desc
-        desc_d = json.loads(kernel_desc)
     else:
         assert isinstance(kernel_desc, dict)
         desc_s = json.dumps(kernel_desc)
-        desc_d = kernel_desc
-    return _build(desc_s, desc_d, attr)
+    return _build(desc_s, attr=attr)
 
 def get_tiling_space(kernel_desc, level=1, attr=None):
     """
@@ -180,3 +190,68 @@ def build_cuda(outputs, args, sch_name, kernel_name):
             mod = tvm.build(s, args, cuda, name = kernel_name)
             dump_cuda_meta.dump(mod, kernel_name, s, list(args))
             return mod
+
+def _cpu_vector_lanes(dtype):
+    """lanes of a 256-bit vector register for dtype"""
+    bits = tvm.ndarray.TVMType(dtype).bits
+    return max(256 // max(bits, 8), 1)
+
+def _schedule_cpu_stage(s, op):
+    """parallelize the outer spatial axes of op and vectorize its innermost spatial axis when it divides evenly"""
+    axes = list(s[op].op.axis)
+    if not axes:
+        return
+    lanes = _cpu_vector_lanes(op.output(0).dtype)
+    extent = axes[-1].dom.extent
+    vectorize = isinstance(extent, tvm.expr.IntImm) and extent.value % lanes == 0
+    if op.reduce_axis:
+        if vectorize and len(axes) > 1:
+            # reduce into a vector of the innermost spatial axis
+            outer = s[op].fuse(*axes[:-1])
+            inner_o, inner_i = s[op].split(axes[-1], factor=lanes)
+            s[op].reorder(outer, inner_o, *(list(op.reduce_axis) + [inner_i]))
+            s[op].parallel(outer)
+            s[op].vectorize(inner_i)
+        else:
+            s[op].parallel(s[op].fuse(*axes))
+        return
+    if vectorize:
+        inner_o, inner_i = s[op].split(axes[-1], factor=lanes)
+        s[op].parallel(s[op].fuse(*(axes[:-1] + [inner_o])))
+        s[op].vectorize(inner_i)
+    else:
+        s[op].parallel(s[op].fuse(*axes))
+
+def schedule_cpu(outputs):
+    """
+    cpu schedule of a composite kernel: elementwise ops are inlined into their consumers, so every
+    chain ends in an output or a reduction; these remaining stages are parallelized over their outer
+    axes and vectorized along the innermost one
+    """
+    s = tvm.create_schedule([t.op for t in outputs])
+    output_ops = set(t.op for t in outputs)
+    visited = set()
+    stages = []
+
+    def traverse(op):
+        if op in visited or not isinstance(op, tvm.tensor.ComputeOp):
+            return
+        visited.add(op)
+        for t in op.input_tensors:
+            traverse(t.op)
+        if op not in output_ops and not op.reduce_axis:
+            s[op].compute_inline()
+        else:
+            stages.append(op)
+
+    for t in outputs:
+        traverse(t.op)
+    for op in stages:
+        _schedule_cpu_stage(s, op)
+    return s
+
+@tvm.register_func("akg_build_cpu_module")
+def build_cpu(outputs, args, kernel_name):
+    with tvm.target.create("llvm") as llvm:
+        s = schedule_cpu(list(outputs))
+        return tvm.build(s, list(args), llvm, name=kernel_name)
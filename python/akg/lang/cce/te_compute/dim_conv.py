@@ -18,7 +18,6 @@
 
 import akg.tvm
 import akg
-from akg import backend as tvm_cce
 from akg.backend import cce_params as param
 
 output_name_suffix = [0]
@@ -65,6 +64,11 @@ def compute_five2four(inputs, raw_shape_4d):
                           dtype=[inputs.dtype], name="output_" + hex(output_name_suffix[0]))
 
 
+def ub_size():
+    """size in bytes of the unified buffer in the hardware profile, which falls back to the product section"""
+    return akg.tvm.get_global_func("cce.hardware_profile_memory_size")("local.UB")
+
+
 def decl_memory(buffer_scope):
     """
     memory declaration
@@ -80,7 +84,7 @@ def decl_memory(buffer_scope):
         return akg.tvm.make.node("MemoryInfo",
                                  unit_bits=32 * 8,
                                  max_simd_bits=32 * 8,
-                                 max_num_bits=tvm_cce.CceProductParams().get_params_("Unified_Buffer") * 8,
+                                 max_num_bits=ub_size() * 8,
                                  head_address=akg.tvm.const(0, 'int32'))
 
 
@@ -213,14 +217,14 @@ def get_vnchwconv_cube_buf_max(actual_col_size, is_four2five):
         cube_size, tail_cube_size.
     """
     actual_cube_buf_size = ((actual_col_size - 1) // 16 + 1) * 16 * 16 * 2  # Byte
-    ub_cut_upper_limit = (tvm_cce.CceProductParams().get_params_("Unified_Buffer")) // 2  # Byte
+    ub_cut_upper_limit = ub_size() // 2  # Byte
     if actual_cube_buf_size > ub_cut_upper_limit:
         if is_four2five:
             tail_cube_size = actual_cube_buf_size % ub_cut_upper_limit
             return (ub_cut_upper_limit // 2), (tail_cube_size // 2)  # fp16
         if actual_col_size % 16 != 0:
             # remain ubuf C0*C0*type_len(fp16) = 512 Byte
-            ub_cut_upper_limit = (tvm_cce.CceProductParams().get_params_("Unified_Buffer") - 512) // 2  # Byte
+            ub_cut_upper_limit = (ub_size() - 512) // 2  # Byte
             ub_cut_upper_limit = ub_cut_upper_limit // (2 * 16 * 16) * (2 * 16 * 16)  # Byte
         tail_cube_size = actual_cube_buf_size % ub_cut_upper_limit
         return (ub_cut_upper_limit // 2), (tail_cube_size // 2)  # fp16
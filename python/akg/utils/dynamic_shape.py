@@ -122,3 +122,106 @@ def create_dynamic_shape_node(tensor_name, pos, dyn_shape_limit=-1, poly_upper_b
                              pos=pos,
                              dyn_shape_limit=dyn_shape_limit,
                              poly_upper_bound=poly_upper_bound)
+
+
+# attrs that only steer shape specialization and are not passed down to the kernels
+SHAPE_BUCKET_ATTRS = ("enable_shape_specialization", "shape_buckets", "shape_histogram", "max_shape_buckets")
+DEFAULT_MAX_SHAPE_BUCKETS = 4
+
+
+def _shape_var_limits(shape_vars, tensors, dynamic_shape_nodes):
+    """map shape var name to the upper bound given by DynamicShapeNode, if any."""
+    var_names = set(v.name for v in shape_vars)
+    tensor_shapes = dict()
+    for t in to_expanded_list(tensors):
+        if isinstance(t, akg.tvm.tensor.Tensor):
+            tensor_shapes[t.op.name] = t.shape
+    limits = dict()
+    for node in dynamic_shape_nodes:
+        if node.tensor_name in var_names and node.poly_upper_bound > 0:
+            # set by set_poly_upper_bound_for_tensor, tensor_name is the name of the var itself
+            limits[node.tensor_name] = node.poly_upper_bound
+            continue
+        shape = tensor_shapes.get(node.tensor_name)
+        if shape is None or node.pos >= len(shape) or node.dyn_shape_limit <= 0:
+            continue
+        dim = shape[node.pos]
+        if isinstance(dim, akg.tvm.expr.Var) and dim.name in var_names:
+            limits[dim.name] = min(limits.get(dim.name, node.dyn_shape_limit), node.dyn_shape_limit)
+    return limits
+
+
+def _c0_shape_vars(shape_vars, tensors):
+    """map shape var name to C0 for the vars in the innermost axis of NC1HWC0 tensors, C0 is not tiled."""
+    var_names = set(v.name for v in shape_vars)
+    c0_vars = dict()
+    for t in to_expanded_list(tensors):
+        if not isinstance(t, akg.tvm.tensor.Tensor) or len(t.shape) != 5:
+            continue
+        dim = t.shape[-1]
+        if isinstance(dim, akg.tvm.expr.Var) and dim.name in var_names:
+            c0_vars[dim.name] = 32 if t.dtype in ("int8", "uint8") else 16
+    return c0_vars
+
+
+def select_shape_buckets(shape_vars, tensors, attrs):
+    """
+    Choose the static shapes a dynamic-shape kernel is specialized for.
+
+    Sources in order of priority:
+        attrs["shape_buckets"]: explicit list of dict {var name: value}.
+        attrs["shape_histogram"]: list of (dict {var name: value}, count), the most frequent buckets are taken.
+        attrs["dynamic_shape"]: DynamicShapeNode limits, powers of two up to the limit are taken, largest first.
+            C0 of NC1HWC0 tensors keeps its fixed value, the other vars step down from their own limits and stay
+            at 1 once they reach it.
+    At most attrs["max_shape_buckets"] buckets are returned and each of them binds every shape var to its upper
+    bound: a call runs the smallest bucket whose values are all >= its shape.
+    """
+    max_buckets = attrs.get("max_shape_buckets", DEFAULT_MAX_SHAPE_BUCKETS)
+    var_names = [v.name for v in shape_vars]
+    if attrs.get("shape_buckets"):
+        candidates = [dict(b) for b in attrs["shape_buckets"]]
+    elif attrs.get("shape_histogram"):
+        histogram = sorted(attrs["shape_histogram"], key=lambda item: item[1], reverse=True)
+        candidates = [dict(item[0]) for item in histogram]
+    else:
+        limits = _shape_var_limits(shape_vars, tensors, attrs.get("dynamic_shape", []))
+        if any(name not in limits for name in var_names):
+            return []
+        c0_vars = _c0_shape_vars(shape_vars, tensors)
+        values = dict()
+        for name in var_names:
+            if name in c0_vars:
+                values[name] = [min(c0_vars[name], limits[name])]
+                continue
+            values[name] = []
+            power = 1
+            while power <= limits[name]:
+                values[name].insert(0, power)
+                power *= 2
+        num = max(len(v) for v in values.values()) if values else 0
+        candidates = [dict((name, values[name][min(i, len(values[name]) - 1)]) for name in var_names)
+                      for i in range(num)]
+
+    buckets = []
+    for bucket in candidates:
+        if any(name not in bucket for name in var_names) or bucket in buckets:
+            continue
+        buckets.append(dict((name, int(bucket[name])) for name in var_names))
+        if len(buckets) >= max_buckets:
+            break
+    return buckets
+
+
+def bucket_shape_limits(bucket, tensors):
+    """DynamicShapeNodes bounding the shape vars named in bucket by its values, for the vars and the tensor axes."""
+    nodes = [create_dynamic_shape_node(tensor_name=name, pos=0, poly_upper_bound=value + 1)
+             for name, value in bucket.items()]
+    for t in to_expanded_list(tensors):
+        if not isinstance(t, akg.tvm.tensor.Tensor):
+            continue
+        for pos, dim in enumerate(t.shape):
+            if isinstance(dim, akg.tvm.expr.Var) and dim.name in bucket:
+                nodes.append(create_dynamic_shape_node(tensor_name=t.op.name, pos=pos,
+                                                       dyn_shape_limit=bucket[dim.name]))
+    return nodes
@@ -26,6 +26,7 @@ import time
 import random
 import subprocess
 import re
+import json
 from timeit import default_timer as timer
 from threading import Thread
 from functools import reduce
@@ -41,6 +42,7 @@ from akg.utils import result_analysis as ra_util
 from akg.utils import format_transform as ft_util
 from akg.utils import custom_tiling as ct_util
 from akg.utils import validation_check as vc_util
+from akg.utils import dynamic_shape as ds_util
 from akg.utils.dsl_create import TensorUtils
 from akg.utils import dump_cuda_meta
 
@@ -435,8 +437,9 @@ def mod_launch(mod, args, outputs=(-1,), tuning=False, device_id=0, expect=None)
     """
 
     gc.collect()
-    if mod.imported_modules[0].type_key == 'cuda':
-        ctx = akg.tvm.context('cuda', device_id)
+    # composite kernels built for "process": "cpu" are plain llvm modules
+    if mod.type_key == 'llvm' or mod.imported_modules[0].type_key == 'cuda':
+        ctx = akg.tvm.cpu(0) if mod.type_key == 'llvm' else akg.tvm.context('cuda', device_id)
         mod_args = [akg.tvm.nd.array(a, ctx) for a in args]
         mod(*mod_args)
         out_list = [mod_args[len(args) + i if i < 0 else i].asnumpy() for i in outputs]
@@ -480,6 +483,49 @@ def mod_launch(mod, args, outputs=(-1,), tuning=False, device_id=0, expect=None)
     raise ValueError("mode must be aic, rpc, aic_cloud, ca, compile_cloud, compile_mini, cpu, csim, ccesim or cdiff")
 
 
+def load_host_tiling(kernel_name, json_file=None):
+    """
+    Register the host tiling written to the kernel json, for kernels that were not lowered in this process.
+
+    Args:
+        kernel_name (str): name of the kernel.
+        json_file (str): kernel json, kernel_meta/<kernel_name>.json by default.
+
+    Returns:
+        bool, whether the kernel json holds a host tiling.
+    """
+    if json_file is None:
+        json_file = os.path.join("kernel_meta", kernel_name + ".json")
+    if not os.path.isfile(json_file):
+        return False
+    with open(json_file, "r") as f:
+        host_tiling = json.load(f).get("hostTiling")
+    if not host_tiling:
+        return False
+    akg.tvm.get_global_func("akg.host_tiling.load")(kernel_name, host_tiling)
+    return True
+
+
+def get_host_tiling_args(kernel_name, shape_args):
+    """
+    Tile factors of a dynamic-shape kernel built with attrs["enable_host_tiling"].
+
+    Args:
+        kernel_name (str): name of the kernel, its kernel json is read when it was not lowered in this process.
+        shape_args (list): values of the shape vars, in the order they are passed to the kernel.
+
+    Returns:
+        list of int, to be passed right after the shape arguments. Empty when the kernel needs no host tiling.
+    """
+    tile_vars = akg.tvm.get_global_func("akg.host_tiling.tile_vars")(kernel_name)
+    if not tile_vars and load_host_tiling(kernel_name):
+        tile_vars = akg.tvm.get_global_func("akg.host_tiling.tile_vars")(kernel_name)
+    if not tile_vars:
+        return []
+    factors = akg.tvm.get_global_func("akg.host_tiling.eval")(kernel_name, *[int(s) for s in shape_args])
+    return [factor.value for factor in factors]
+
+
 def gen_kernel_name(input_shapes, input_types, op_attrs=None, kernel_name=""):
     """generate kernel name."""
     dir_max_length = 250
@@ -592,9 +638,48 @@ def recursive_copy(obj):
     return obj
 
 
+def build_shape_specialized(op_func, input_shapes, input_types, op_attrs, kernel_name, attrs,
+                            sch, op_var, shape_var, polyhedral, binds, dump_ir):
+    """
+    Build a dynamic-shape op once per shape bucket plus the generic kernel.
+
+    A bucket kernel keeps the shape vars as arguments, bounded by the values of its bucket, so it runs every
+    shape the bucket covers. The returned module takes the same arguments as the generic kernel: its entry
+    calls the smallest bucket that covers the shape arguments and falls back to the generic kernel otherwise.
+    """
+    generic_attrs = dict((k, v) for k, v in attrs.items() if k not in ds_util.SHAPE_BUCKET_ATTRS)
+    buckets = ds_util.select_shape_buckets(shape_var, op_var, attrs)
+    if not buckets:
+        logging.warning("no shape bucket found for %s, build the generic dynamic kernel only", kernel_name)
+        return akg.build(sch, op_var, "cce", shape_var, name=kernel_name, attrs=generic_attrs,
+                         polyhedral=polyhedral, binds=binds)
+
+    specs = []
+    spec_buckets = []
+    for bucket in buckets:
+        spec_name = "%s_bucket%d" % (kernel_name, len(specs))
+        spec_attrs = recursive_copy(generic_attrs)
+        spec_attrs["dynamic_shape"] = list(generic_attrs.get("dynamic_shape", [])) + \
+            ds_util.bucket_shape_limits(bucket, op_var)
+        try:
+            spec = op_build(op_func, input_shapes, input_types, op_attrs, spec_name, spec_attrs,
+                            dump_ir=dump_ir, dump_cce=False, polyhedral=polyhedral, build_to_func=True)
+        except (TypeError, ValueError, RuntimeError) as e:
+            logging.warning("skip shape bucket %s of %s: %s", bucket, kernel_name, e)
+            continue
+        specs.append(spec)
+        spec_buckets.append(bucket)
+        logging.info("specialize %s for shape bucket %s as %s", kernel_name, bucket, spec_name)
+
+    # the generic kernel is lowered last: external calls of dynamic kernels are collected by the last lowering
+    generic = akg.build_to_func(sch, op_var, shape_var, name=kernel_name + "_generic", attrs=generic_attrs,
+                                polyhedral=polyhedral, binds=binds)
+    return akg.build_with_shape_dispatch(kernel_name, generic, specs, spec_buckets, "cce")
+
+
 def op_build(op_func, input_shapes, input_types, op_attrs=None, kernel_name="",
              attrs=None, log_cce=False, dump_ir=True, dump_cce=True,
-             polyhedral=True, tuning=False):
+             polyhedral=True, tuning=False, build_to_func=False):
     """
     Return module built from op_func with given inputs.
 
@@ -610,6 +695,13 @@ def op_build(op_func, input_shapes, input_types, op_attrs=None, kernel_name="",
         dump_cce (bool): False by default.
         polyhedral (bool): True by default.
         tuning (bool): False by default.
+        build_to_func (bool): return the lowered BuildRst instead of the module, False by default.
+
+    Note:
+        With attrs["enable_shape_specialization"] a dynamic-shape op is also compiled for the shape buckets
+        chosen by dynamic_shape.select_shape_buckets, see build_shape_specialized.
+        With attrs["enable_host_tiling"] the tile factors of a dynamic-shape kernel are kernel arguments,
+        see get_host_tiling_args.
 
     Return:
         module.
@@ -773,7 +865,15 @@ def op_build(op_func, input_shapes, input_types, op_attrs=None, kernel_name="",
             irf.write(akg.tvm.lower(s, op_var, shape_var, simple_mode=True))
         return mod
     with akg.build_config(add_lower_pass=cce.debug_mode(0), dump_pass_ir=dump_ir):
-        mod = akg.build(s, op_var, "cce", shape_var, name=kernel_name, attrs=attrs, polyhedral=polyhedral, binds=binds)
+        if build_to_func:
+            return akg.build_to_func(s, op_var, shape_var, name=kernel_name, attrs=attrs, polyhedral=polyhedral,
+                                     binds=binds)
+        if shape_var and attrs.get("enable_shape_specialization"):
+            mod = build_shape_specialized(op_func, input_shapes, input_types, op_attrs, kernel_name, attrs,
+                                          s, op_var, shape_var, polyhedral, binds, dump_ir)
+        else:
+            mod = akg.build(s, op_var, "cce", shape_var, name=kernel_name, attrs=attrs, polyhedral=polyhedral,
+                            binds=binds)
         if mod is None:
             return None
         source_code = mod.imported_modules[0].get_source()
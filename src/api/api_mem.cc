@@ -19,7 +19,7 @@
 #include <tvm/target_info.h>
 
 #include "codegen/pass_mgr.h"
-#include "contrib/cce_parm/cceconf.h"
+#include "contrib/cce_parm/hardware_profile.h"
 
 namespace akg {
 namespace ir {
@@ -27,61 +27,46 @@ using air::runtime::TVMArgs;
 using air::runtime::TVMRetValue;
 
 TVM_REGISTER_API("tvm.info.mem.local.L1").set_body([](const TVMArgs args, TVMRetValue *ret) {
-  cceconf::CceConf *conf = cceconf::CceConf::getInstance();
-  CHECK(conf);
-
   auto node = air::make_node<air::MemoryInfoNode>();
   node->unit_bits = 2 * 16 * 16 * 8;
   node->max_simd_bits = 2 * 16 * 16 * 8;
-  node->max_num_bits = conf->getBufferValue("L1_Buffer") * 8;
+  node->max_num_bits = cceconf::HardwareProfile::getInstance()->getMemorySize("local.L1") * 8;
   node->head_address = air::make_const(air::Int(32), 0);
   *ret = air::MemoryInfo(node);
 });
 
 TVM_REGISTER_API("tvm.info.mem.local.UB").set_body([](const TVMArgs args, TVMRetValue *ret) {
-  cceconf::CceConf *conf = cceconf::CceConf::getInstance();
-  CHECK(conf);
-
   auto node = air::make_node<air::MemoryInfoNode>();
   node->unit_bits = 32 * 8;
   node->max_simd_bits = 32 * 8;
-  node->max_num_bits = conf->getBufferValue("Unified_Buffer") * 8;
+  node->max_num_bits = cceconf::HardwareProfile::getInstance()->getMemorySize("local.UB") * 8;
   node->head_address = air::make_const(air::Int(32), 0);
   *ret = air::MemoryInfo(node);
 });
 
 TVM_REGISTER_API("tvm.info.mem.local.L0A").set_body([](const TVMArgs args, TVMRetValue *ret) {
-  cceconf::CceConf *conf = cceconf::CceConf::getInstance();
-  CHECK(conf);
-
   auto node = air::make_node<air::MemoryInfoNode>();
   node->unit_bits = 2 * 16 * 16 * 8;
   node->max_simd_bits = 2 * 16 * 16 * 8;
-  node->max_num_bits = conf->getBufferValue("L0A_Buffer") * 8;
+  node->max_num_bits = cceconf::HardwareProfile::getInstance()->getMemorySize("local.L0A") * 8;
   node->head_address = air::make_const(air::Int(32), 0);
   *ret = air::MemoryInfo(node);
 });
 
 TVM_REGISTER_API("tvm.info.mem.local.L0B").set_body([](const TVMArgs args, TVMRetValue *ret) {
-  cceconf::CceConf *conf = cceconf::CceConf::getInstance();
-  CHECK(conf);
-
   auto node = air::make_node<air::MemoryInfoNode>();
   node->unit_bits = 2 * 16 * 16 * 8;
   node->max_simd_bits = 2 * 16 * 16 * 8;
-  node->max_num_bits = conf->getBufferValue("L0B_Buffer") * 8;
+  node->max_num_bits = cceconf::HardwareProfile::getInstance()->getMemorySize("local.L0B") * 8;
   node->head_address = air::make_const(air::Int(32), 0);
   *ret = air::MemoryInfo(node);
 });
 
 TVM_REGISTER_API("tvm.info.mem.local.L0C").set_body([](const TVMArgs args, TVMRetValue *ret) {
-  cceconf::CceConf *conf = cceconf::CceConf::getInstance();
-  CHECK(conf);
-
   auto node = air::make_node<air::MemoryInfoNode>();
   node->unit_bits = 2 * 16 * 16 * 8;
   node->max_simd_bits = 2 * 16 * 16 * 8;
-  node->max_num_bits = conf->getBufferValue("L0C_Buffer") * 8;
+  node->max_num_bits = cceconf::HardwareProfile::getInstance()->getMemorySize("local.L0C") * 8;
   node->head_address = air::make_const(air::Int(32), 0);
   *ret = air::MemoryInfo(node);
 });
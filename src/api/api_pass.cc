@@ -80,6 +80,36 @@ TVM_REGISTER_API("ir_pass.ToThreeAddress").set_body([](const TVMArgs args, TVMRe
   }
 });
 
+TVM_REGISTER_API("ir_pass.EstimatePerformance").set_body([](const TVMArgs args, TVMRetValue *ret) {
+  CHECK_EQ(args.size(), 1);
+  if (args[0].IsObjectRef<LoweredFunc>()) {
+    LoweredFunc func = args[0];
+    *ret = EstimatePerformance(func->body);
+  } else {
+    *ret = EstimatePerformance(args[0].operator Stmt());
+  }
+});
+
+// features of a batch of candidates, each a Stmt or a LoweredFunc
+TVM_REGISTER_API("ir_pass.ExtractFeatures").set_body([](const TVMArgs args, TVMRetValue *ret) {
+  CHECK_EQ(args.size(), 1);
+  Array<NodeRef> candidates = args[0];
+  Array<Array<Expr>> features;
+  for (const auto &cand : candidates) {
+    if (const auto func = cand.as<air::LoweredFuncNode>()) {
+      features.push_back(ExtractFeatures(func->body));
+    } else {
+      features.push_back(ExtractFeatures(air::Downcast<Stmt>(cand)));
+    }
+  }
+  *ret = features;
+});
+
+TVM_REGISTER_API("ir_pass.FeatureNames").set_body([](const TVMArgs args, TVMRetValue *ret) {
+  CHECK_EQ(args.size(), 0);
+  *ret = FeatureNames();
+});
+
 #define REGISTER_PASS(PassName) TVM_REGISTER_API("ir_pass." #PassName).set_body_typed(PassName);
 
 REGISTER_PASS(SinkIfStmt);
@@ -99,9 +129,11 @@ REGISTER_PASS(EmitInsnDebug);
 REGISTER_PASS(RewriteMultiValueFunc);
 REGISTER_PASS(RenameRealize);
 REGISTER_PASS(InjectSync);
+REGISTER_PASS(PipeListSchedule);
 REGISTER_PASS(MathIntrinRewrite);
 REGISTER_PASS(InvariantHoist);
 REGISTER_PASS(ElimDMA);
+REGISTER_PASS(CoalesceDma);
 REGISTER_PASS(InjectAttr);
 REGISTER_PASS(InjectPipe);
 REGISTER_PASS(HoistInsn);
@@ -21,6 +21,7 @@
 #include <numeric>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -29,6 +30,7 @@
 #include "ir_pass.h"
 #include "schedule_pass.h"
 #include "codegen/pass_mgr.h"
+#include "codegen/host_tiling.h"
 #include "composite/util.h"
 
 namespace akg {
@@ -481,7 +483,7 @@ NodeRef Lower(Schedule sch, const Array<NodeRef> &in_args, const Array<NodeRef>
 
   // Phase 0
   if (polyhedral && global_attrs.GetBoolAttr(kEnableAutoInline, true)) {
-    akg::schedule::AutoInline(sch);
+    akg::schedule::AutoInline(sch, global_attrs.GetBoolAttr(kEnableInlineCostModel, false));
   }
   auto new_sch = sch.normalize();
   auto bounds = air::schedule::InferBound(new_sch);
@@ -601,15 +603,36 @@ NodeRef Lower(Schedule sch, const Array<NodeRef> &in_args, const Array<NodeRef>
   const int max_enter_poly_times = global_attrs.GetIntAttr(kMaxNumRetryPoly, need_micro_tuning ? 4 : 1);
   int enter_count = 0;
   Stmt stmt_before_poly = stmt;
+  // the tiling analysis kept for a retry does not outlive the compile, also when a retry fails for good
+  struct TilingRetryCacheGuard {
+    ~TilingRetryCacheGuard() { ir::ClearTilingRetryCache(); }
+  } retry_cache_guard;
   while (enter_count < max_enter_poly_times) {
     if (!aicpu && polyhedral) {
       Array<NodeRef> poly_res = NEXT_PASS(AutoPoly, stmt_before_poly, binds_0, global_attrs, false, is_dynamic);
       enter_count++;
-      CHECK_EQ(poly_res.size(), 2);
+      CHECK_EQ(poly_res.size(), 3);
       stmt = air::Downcast<Stmt>(poly_res[0]);
       Array<air::Var> tiling_params = air::Downcast<Array<air::Var>>(poly_res[1]);
+      Array<NodeRef> host_tiling = air::Downcast<Array<NodeRef>>(poly_res[2]);
+      CHECK_EQ(host_tiling.size(), 2);
+      Array<air::Var> host_tile_vars = air::Downcast<Array<air::Var>>(host_tiling[0]);
+      std::unordered_set<std::string> host_tile_names;
+      for (const auto &var : host_tile_vars) {
+        host_tile_names.insert(var->name_hint);
+      }
       for (const auto &var : tiling_params) {
-        arg_list_0.push_back(var);
+        if (host_tile_names.count(var->name_hint) == 0) {
+          arg_list_0.push_back(var);
+        }
+      }
+      if (global_attrs.GetBoolAttr(kEnableHostTiling, false) && !host_tile_vars.empty()) {
+        // tile factors are evaluated on the host at launch and passed right after the shape vars
+        for (const auto &var : host_tile_vars) {
+          arg_list_0.push_back(var);
+        }
+        HostTilingRegistry::GetInstance()->Set(name, shape_vars, host_tile_vars,
+                                               air::Downcast<Array<Expr>>(host_tiling[1]));
       }
 
       if (global_attrs.GetBoolAttr(kTileSizeIsVar, false)) {
@@ -767,7 +790,8 @@ NodeRef Lower(Schedule sch, const Array<NodeRef> &in_args, const Array<NodeRef>
       } else {
         int block_dim = enable_multicore == 1 ? -1 : enable_multicore;
         stmt = NEXT_PASS(InjectMultiCore, stmt, block_dim, global_attrs.GetIntAttr(kMergeOuterLoop, 0), is_dynamic,
-                         global_attrs.GetBoolAttr(kMultiCoreScalarRerrange, false));
+                         global_attrs.GetBoolAttr(kMultiCoreScalarRerrange, false),
+                         global_attrs.GetBoolAttr(kMultiCoreBalance, false));
       }
     }
     if (!is_dynamic) {
@@ -807,12 +831,15 @@ NodeRef Lower(Schedule sch, const Array<NodeRef> &in_args, const Array<NodeRef>
     stmt = NEXT_PASS(SetVectorMaskDefault, stmt);
     stmt = NEXT_PASS(ElimVectorMask, stmt);
     stmt = NEXT_PASS(ElimDMA, stmt);
+    if (global_attrs.GetBoolAttr(kEnableCoalesceDma, true)) {
+      stmt = NEXT_PASS(CoalesceDma, stmt);
+    }
     if (!is_dynamic) {
       stmt = NEXT_PASS(MultiCorePartition, stmt);
     }
 
     if (global_attrs.GetBoolAttr(kEnableDoubleBuffer, true)) {
-      stmt = NEXT_PASS(AutoDoubleBuffer, stmt);
+      stmt = NEXT_PASS(AutoDoubleBuffer, stmt, global_attrs.GetBoolAttr(kEnableSoftwarePipeline, false));
     }
     stmt = NEXT_PASS(InjectAccessPtrMSG, stmt);
     if (!aicpu) {
@@ -853,6 +880,9 @@ NodeRef Lower(Schedule sch, const Array<NodeRef> &in_args, const Array<NodeRef>
 
   stmt = NEXT_PASS(SpecialValueReplacer, stmt);
   stmt = NEXT_PASS(Simplify, stmt);
+  if (!aicpu && global_attrs.GetBoolAttr(kEnablePipeListSchedule, true)) {
+    stmt = NEXT_PASS(PipeListSchedule, stmt);
+  }
   if (!aicpu) {
     stmt = NEXT_PASS(InjectSync, stmt);
   }
@@ -908,6 +938,9 @@ NodeRef Lower(Schedule sch, const Array<NodeRef> &in_args, const Array<NodeRef>
   }
   PassMgr::SetArgs(arg_list_0);
   LoweredFunc lowered_func = NEXT_PASS(MakeAPI, stmt, name, arg_list_0, 0, config->restricted_func);
+  if (!aicpu && global_attrs.GetBoolAttr(kEnablePerfEstimate, false)) {
+    LOG(INFO) << "estimated cycles of " << name << ": " << ir::EstimatePerformance(lowered_func->body);
+  }
 
   LOG(INFO) << *pass_timer;
   pass_timer->Clear();
@@ -1020,21 +1053,9 @@ void CreateCce(const std::string &code, const std::string &kernel_name) {
 }
 }  // namespace
 
-air::runtime::Module BuildToModule(const NodeRef &ref, const std::string &target_name) {
-  CHECK(!target_name.empty()) << "target_name is empty.";
-
-  auto build_rst = Downcast<BuildRst>(ref);
-  auto res = build_rst->rst;
-
-  Array<LoweredFunc> lowered_func_list;
-  if (res->IsInstance<LoweredFuncNode>()) {
-    LoweredFunc lowered_func = air::Downcast<LoweredFunc>(res);
-    lowered_func_list.push_back(lowered_func);
-  }
-  if (lowered_func_list.empty()) {
-    return air::runtime::Module(nullptr);
-  }
-
+namespace {
+air::runtime::Module BuildLoweredFuncs(const Array<LoweredFunc> &lowered_func_list, const std::string &target_name,
+                                       const std::string &kernel_name) {
   Map<std::string, Array<LoweredFunc>> target_flist;
   target_flist.Set(target_name, lowered_func_list);
 
@@ -1066,12 +1087,117 @@ air::runtime::Module BuildToModule(const NodeRef &ref, const std::string &target
     auto mod0 = mhost->imports()[0];
     CHECK(mod0.defined());
 
-    CreateCce(mod0->GetSource(), build_rst->kernel_name);
+    CreateCce(mod0->GetSource(), kernel_name);
   }
 
   return mhost;
 }
 
+/*
+ * Host function named `name` with the same packed signature as `generic`. Each specialization is compiled for
+ * shape vars bounded by its bucket and takes the same arguments as `generic`. The call goes to the smallest
+ * bucket, by number of elements, whose values are all >= the scalar shape arguments, or to the generic dynamic
+ * kernel when no bucket covers the shape.
+ */
+LoweredFunc MakeShapeDispatcher(const std::string &name, const LoweredFunc &generic, const Array<LoweredFunc> &specs,
+                                const Array<Map<std::string, Expr>> &buckets) {
+  CHECK_EQ(specs.size(), buckets.size()) << "each specialization needs one shape bucket";
+  CHECK_NE(generic->name, name) << "dispatcher and generic kernel must have different names";
+  Array<NodeRef> api_args;
+  Array<Expr> call_args;
+  std::unordered_map<std::string, Var> scalar_args;
+  for (const auto &arg : generic->args_real) {
+    Var v(arg->name_hint, arg.type());
+    api_args.push_back(v);
+    call_args.push_back(v);
+    if (!arg.type().is_handle()) {
+      scalar_args[arg->name_hint] = v;
+    }
+  }
+  auto make_call = [&call_args](const std::string &callee) {
+    Array<Expr> args{StringImm::make(callee)};
+    for (const auto &arg : call_args) {
+      args.push_back(arg);
+    }
+    return Evaluate::make(Call::make(Int(32), air::ir::intrinsic::tvm_call_packed, args, Call::Intrinsic));
+  };
+
+  // the first covering bucket in this order is the smallest one
+  std::vector<size_t> order(specs.size());
+  std::vector<int64_t> volume(specs.size(), 1);
+  for (size_t i = 0; i < specs.size(); ++i) {
+    order[i] = i;
+    for (const auto &it : buckets[i]) {
+      const auto imm = it.second.as<IntImm>();
+      CHECK(imm != nullptr) << "bucket value of shape var " << it.first << " is not an integer";
+      volume[i] *= imm->value;
+    }
+  }
+  std::stable_sort(order.begin(), order.end(), [&volume](size_t a, size_t b) { return volume[a] < volume[b]; });
+
+  Stmt body = make_call(generic->name);
+  for (auto i = order.rbegin(); i != order.rend(); ++i) {
+    const auto &spec = specs[*i];
+    CHECK_EQ(spec->args_real.size(), generic->args_real.size())
+      << "specialization " << spec->name << " must take the arguments of " << generic->name;
+    Expr cond = air::const_true();
+    for (const auto &it : buckets[*i]) {
+      auto var_it = scalar_args.find(it.first);
+      CHECK(var_it != scalar_args.end()) << "shape var " << it.first << " is not an argument of " << generic->name;
+      cond = cond && (var_it->second <= air::ir::Cast::make(var_it->second.type(), it.second));
+    }
+    body = IfThenElse::make(air::ir::Simplify(cond), make_call(spec->name), body);
+  }
+  return air::ir::MakeAPI(body, name, api_args, 0, true);
+}
+}  // namespace
+
+air::runtime::Module BuildToModule(const NodeRef &ref, const std::string &target_name) {
+  CHECK(!target_name.empty()) << "target_name is empty.";
+
+  auto build_rst = Downcast<BuildRst>(ref);
+  auto res = build_rst->rst;
+
+  Array<LoweredFunc> lowered_func_list;
+  if (res->IsInstance<LoweredFuncNode>()) {
+    LoweredFunc lowered_func = air::Downcast<LoweredFunc>(res);
+    lowered_func_list.push_back(lowered_func);
+  }
+  if (lowered_func_list.empty()) {
+    return air::runtime::Module(nullptr);
+  }
+
+  return BuildLoweredFuncs(lowered_func_list, target_name, build_rst->kernel_name);
+}
+
+air::runtime::Module BuildToModuleWithDispatch(const std::string &name, const NodeRef &generic_ref,
+                                               const Array<NodeRef> &spec_refs,
+                                               const Array<Map<std::string, Expr>> &buckets,
+                                               const std::string &target_name) {
+  CHECK(!target_name.empty()) << "target_name is empty.";
+  auto generic_rst = Downcast<BuildRst>(generic_ref);
+  CHECK(generic_rst->rst->IsInstance<LoweredFuncNode>()) << "generic kernel " << generic_rst->kernel_name
+                                                         << " is not lowered to a function";
+  LoweredFunc generic = Downcast<LoweredFunc>(generic_rst->rst);
+
+  Array<LoweredFunc> specs;
+  Array<Map<std::string, Expr>> spec_buckets;
+  for (size_t i = 0; i < spec_refs.size(); ++i) {
+    auto spec_rst = Downcast<BuildRst>(spec_refs[i]);
+    if (!spec_rst->rst->IsInstance<LoweredFuncNode>()) {
+      LOG(WARNING) << "skip shape specialization " << spec_rst->kernel_name << ", it is not lowered to a function";
+      continue;
+    }
+    specs.push_back(Downcast<LoweredFunc>(spec_rst->rst));
+    spec_buckets.push_back(buckets[i]);
+  }
+
+  Array<LoweredFunc> lowered_func_list = specs;
+  lowered_func_list.push_back(generic);
+  lowered_func_list.push_back(MakeShapeDispatcher(name, generic, specs, spec_buckets));
+  return BuildLoweredFuncs(lowered_func_list, target_name, name);
+}
+
 air::runtime::Module BuildModule(const Schedule &inputs, const Array<NodeRef> &in_args,
                                   const Array<NodeRef> &shape_vars, const std::string &target_name,
                                   const std::string &name, const Map<Tensor, Buffer> &in_binds,
@@ -1084,6 +1210,8 @@ air::runtime::Module BuildModule(const Schedule &inputs, const Array<NodeRef> &i
 
 TVM_REGISTER_API("_BuildModule").set_body_typed(BuildModule);
 TVM_REGISTER_API("_BuildToFunc").set_body_typed(BuildToFunc);
+TVM_REGISTER_API("_BuildToModuleWithDispatch").set_body_typed(BuildToModuleWithDispatch);
+TVM_REGISTER_API("_MakeShapeDispatcher").set_body_typed(MakeShapeDispatcher);
 TVM_REGISTER_API("_BuildToModule").set_body([](const TVMArgs &args, TVMRetValue *ret) {
   if (args.size() == 1) {
     *ret = BuildToModule(args[0]);
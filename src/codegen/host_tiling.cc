@@ -0,0 +1,207 @@
+/**
+ * Copyright 2026 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "codegen/host_tiling.h"
+
+#include <tvm/node/serialization.h>
+
+#include <algorithm>
+
+#include "poly/tiling_algorithm.h"
+
+namespace akg {
+namespace {
+// memoized shapes per kernel, the table is dropped when it grows beyond this
+constexpr size_t kMaxHostTilingEntries = 4096;
+
+// Same algorithm as the feature library implementation in src/feature_lib.
+int64_t FindDivisibleTilingFactor(int64_t mem_limit, int64_t shape) {
+  if (shape <= mem_limit) {
+    return shape;
+  }
+  if (mem_limit <= 0) {
+    return 1;
+  }
+  for (int64_t div = std::max<int64_t>(2, shape / mem_limit); div * div < shape; ++div) {
+    if (shape % div == 0) {
+      return shape / div;
+    }
+  }
+  return 1;
+}
+
+int64_t Gcd(int64_t a, int64_t b) {
+  while (b != 0) {
+    int64_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+class HostTilingEvaluator : public IRMutator {
+ public:
+  explicit HostTilingEvaluator(const std::unordered_map<std::string, int64_t> &values) : values_(values) {}
+  ~HostTilingEvaluator() override = default;
+
+  bool Eval(const Expr &e, int64_t *res) {
+    Expr value = air::ir::Simplify(Mutate(e));
+    if (auto imm = value.as<IntImm>()) {
+      *res = imm->value;
+      return true;
+    }
+    return false;
+  }
+
+ private:
+  Expr Mutate_(const Variable *op, const Expr &e) final {
+    auto it = values_.find(op->name_hint);
+    if (it != values_.end()) {
+      return air::make_const(op->type, it->second);
+    }
+    return e;
+  }
+
+  Expr Mutate_(const Call *op, const Expr &e) final {
+    Expr expr = IRMutator::Mutate_(op, e);
+    op = expr.as<Call>();
+    CHECK(op);
+    bool is_find = op->name == tiling_algorithm::intrinsic::FL_find_divisible_tiling_factor;
+    bool is_gcd = op->name == tiling_algorithm::intrinsic::FL_get_gcd;
+    if ((!is_find && !is_gcd) || op->args.size() != 2U) {
+      return expr;
+    }
+    auto a = air::ir::Simplify(op->args[0]).as<IntImm>();
+    auto b = air::ir::Simplify(op->args[1]).as<IntImm>();
+    if (a == nullptr || b == nullptr) {
+      return expr;
+    }
+    int64_t res = is_find ? FindDivisibleTilingFactor(a->value, b->value) : Gcd(a->value, b->value);
+    return air::make_const(op->type, res);
+  }
+
+  const std::unordered_map<std::string, int64_t> &values_;
+};
+}  // namespace
+
+HostTiling::HostTiling(const Array<NodeRef> &shape_vars, const Array<Var> &tile_vars, const Array<Expr> &tile_values)
+    : shape_vars_(shape_vars), tile_vars_(tile_vars), tile_values_(tile_values) {
+  CHECK_EQ(tile_vars.size(), tile_values.size());
+  for (const auto &node : shape_vars) {
+    auto var = node.as<Variable>();
+    CHECK(var) << "shape var should be a Variable, but got " << node;
+    shape_names_.push_back(var->name_hint);
+  }
+}
+
+std::vector<int64_t> HostTiling::Eval(const std::vector<int64_t> &shape_values) {
+  CHECK_EQ(shape_values.size(), shape_names_.size()) << "host tiling expects one value per shape var";
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = table_.find(shape_values);
+    if (it != table_.end()) {
+      return it->second;
+    }
+  }
+
+  std::unordered_map<std::string, int64_t> values;
+  for (size_t i = 0; i < shape_names_.size(); ++i) {
+    values[shape_names_[i]] = shape_values[i];
+  }
+  // tile factors may refer to each other, evaluate until every factor is known
+  std::vector<bool> solved(tile_vars_.size(), false);
+  std::vector<int64_t> res(tile_vars_.size(), 0);
+  size_t num_solved = 0;
+  bool progress = true;
+  while (num_solved < tile_vars_.size() && progress) {
+    progress = false;
+    for (size_t i = 0; i < tile_vars_.size(); ++i) {
+      if (solved[i]) continue;
+      HostTilingEvaluator evaluator(values);
+      if (evaluator.Eval(tile_values_[i], &res[i])) {
+        CHECK_GT(res[i], 0) << "invalid tile factor " << res[i] << " for " << tile_vars_[i] << " = "
+                            << tile_values_[i];
+        values[tile_vars_[i]->name_hint] = res[i];
+        solved[i] = true;
+        ++num_solved;
+        progress = true;
+      }
+    }
+  }
+  for (size_t i = 0; i < tile_vars_.size(); ++i) {
+    CHECK(solved[i]) << "cannot evaluate tile factor " << tile_vars_[i] << " = " << tile_values_[i] << " on host";
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (table_.size() >= kMaxHostTilingEntries) {
+    table_.clear();
+  }
+  table_[shape_values] = res;
+  return res;
+}
+
+std::string HostTiling::SaveJson() const {
+  return air::SaveJSON(Array<NodeRef>{shape_vars_, tile_vars_, tile_values_});
+}
+
+void HostTilingRegistry::Set(const std::string &kernel_name, const Array<NodeRef> &shape_vars,
+                             const Array<Var> &tile_vars, const Array<Expr> &tile_values) {
+  std::unique_ptr<HostTiling> tiling(new HostTiling(shape_vars, tile_vars, tile_values));
+  std::lock_guard<std::mutex> lock(mutex_);
+  tilings_[kernel_name] = std::move(tiling);
+}
+
+void HostTilingRegistry::Load(const std::string &kernel_name, const std::string &json) {
+  auto saved = air::Downcast<Array<NodeRef>>(air::LoadJSON(json));
+  CHECK_EQ(saved.size(), 3U) << "host tiling of " << kernel_name << " should hold shape vars, tile vars and values";
+  Set(kernel_name, air::Downcast<Array<NodeRef>>(saved[0]), air::Downcast<Array<Var>>(saved[1]),
+      air::Downcast<Array<Expr>>(saved[2]));
+}
+
+HostTiling *HostTilingRegistry::Get(const std::string &kernel_name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = tilings_.find(kernel_name);
+  return it == tilings_.end() ? nullptr : it->second.get();
+}
+
+TVM_REGISTER_API("akg.host_tiling.tile_vars").set_body([](const TVMArgs &args, TVMRetValue *ret) {
+  HostTiling *tiling = HostTilingRegistry::GetInstance()->Get(args[0].operator std::string());
+  *ret = tiling == nullptr ? Array<Var>() : tiling->tile_vars();
+});
+
+TVM_REGISTER_API("akg.host_tiling.save").set_body([](const TVMArgs &args, TVMRetValue *ret) {
+  HostTiling *tiling = HostTilingRegistry::GetInstance()->Get(args[0].operator std::string());
+  *ret = tiling == nullptr ? std::string() : tiling->SaveJson();
+});
+
+TVM_REGISTER_API("akg.host_tiling.load").set_body([](const TVMArgs &args, TVMRetValue *ret) {
+  HostTilingRegistry::GetInstance()->Load(args[0].operator std::string(), args[1].operator std::string());
+});
+
+TVM_REGISTER_API("akg.host_tiling.eval").set_body([](const TVMArgs &args, TVMRetValue *ret) {
+  std::string kernel_name = args[0];
+  HostTiling *tiling = HostTilingRegistry::GetInstance()->Get(kernel_name);
+  CHECK(tiling) << "kernel " << kernel_name << " is not built with enable_host_tiling";
+  std::vector<int64_t> shape_values;
+  for (int i = 1; i < args.size(); ++i) {
+    shape_values.push_back(args[i].operator int64_t());
+  }
+  Array<Expr> res;
+  for (auto factor : tiling->Eval(shape_values)) {
+    res.push_back(air::make_const(air::Int(64), factor));
+  }
+  *ret = res;
+});
+}  // namespace akg
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2026 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CODEGEN_HOST_TILING_H_
+#define CODEGEN_HOST_TILING_H_
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "tvm.h"
+
+namespace akg {
+/*!
+ * \brief Tiling decision of one dynamic-shape kernel, evaluated on the host.
+ *
+ *  With attrs["enable_host_tiling"], the tile factors that the dynamic tiling solver would compute at the top of
+ *  the kernel become scalar kernel arguments placed right after the shape arguments. The expressions are kept here
+ *  and evaluated for the concrete shape at launch; results are memoized per shape, so the table stays compact.
+ *  The expressions are also written to the kernel json, so a kernel loaded in another process can evaluate them.
+ */
+class HostTiling {
+ public:
+  HostTiling() = default;
+  HostTiling(const Array<NodeRef> &shape_vars, const Array<Var> &tile_vars, const Array<Expr> &tile_values);
+
+  /*! \brief tile factors for the given shape values, in the order of tile_vars() */
+  std::vector<int64_t> Eval(const std::vector<int64_t> &shape_values);
+
+  const Array<Var> &tile_vars() const { return tile_vars_; }
+  size_t num_shape_vars() const { return shape_names_.size(); }
+
+  /*! \brief shape vars, tile vars and tile values as a node json, read back by HostTilingRegistry::Load */
+  std::string SaveJson() const;
+
+ private:
+  Array<NodeRef> shape_vars_;
+  std::vector<std::string> shape_names_;
+  Array<Var> tile_vars_;
+  Array<Expr> tile_values_;
+  std::map<std::vector<int64_t>, std::vector<int64_t>> table_;
+  std::mutex mutex_;
+};
+
+/*! \brief Host tiling of the kernels lowered in this process, keyed by kernel name */
+class HostTilingRegistry {
+ public:
+  static HostTilingRegistry *GetInstance() {
+    static HostTilingRegistry registry;
+    return &registry;
+  }
+
+  void Set(const std::string &kernel_name, const Array<NodeRef> &shape_vars, const Array<Var> &tile_vars,
+           const Array<Expr> &tile_values);
+  /*! \brief register the host tiling saved by HostTiling::SaveJson for kernel_name */
+  void Load(const std::string &kernel_name, const std::string &json);
+  HostTiling *Get(const std::string &kernel_name);
+
+ private:
+  HostTilingRegistry() = default;
+
+  std::unordered_map<std::string, std::unique_ptr<HostTiling>> tilings_;
+  std::mutex mutex_;
+};
+}  // namespace akg
+#endif  // CODEGEN_HOST_TILING_H_
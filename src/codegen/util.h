@@ -37,6 +37,9 @@ constexpr auto kEnableIsolateMinMax = "enable_isolate_min_max";
 constexpr auto kEnableDmaSink = "enable_dma_sink";
 constexpr auto kCoarsenImg2Col = "coarsenImg2Col";
 constexpr auto kEnableHoistInsn = "enable_hoist_insn";
+constexpr auto kEnablePipeListSchedule = "enable_pipe_list_schedule";
+constexpr auto kEnablePerfEstimate = "enable_perf_estimate";
+constexpr auto kEnableCoalesceDma = "enable_coalesce_dma";
 constexpr auto kEnableInvariantHoist = "enable_invariant_hoist";
 constexpr auto kEnablePostPolyLoopPartition = "enable_post_poly_loop_partition";
 constexpr auto kEnablePreStorageWriteSimplify = "enable_pre_storage_write_simplify";
@@ -45,12 +48,14 @@ constexpr auto kExtentToCond = "extent_to_cond";
 constexpr auto kEnableMulticore = "enable_multicore";
 constexpr auto kMergeOuterLoop = "merge_outer_loop_for_multicore";
 constexpr auto kMultiCoreLoopMaxDepth = "multicore_loop_max_depth";
+constexpr auto kMultiCoreBalance = "multicore_balance";
 constexpr auto kMultiCoreScalarRerrange = "multicore_scalar_rearrange";
 constexpr auto kMultiCoreLoopSwitchHoist = "multicore_loop_switch_hoist";
 constexpr auto kRecordCore = "record_core";
 constexpr auto kEnableBisectOptimize = "enable_bisect_optimize";
 constexpr auto kEnableCoverProtectOptimize = "enable_cover_protect_optimize";
 constexpr auto kEnableDoubleBuffer = "enable_double_buffer";
+constexpr auto kEnableSoftwarePipeline = "enable_software_pipeline";
 constexpr auto kEnableUnrollLoop = "enable_unroll_loop";
 constexpr auto kAlgebraSimplify = "enable_algebra_simplify";
 constexpr auto kPromoteCommonExpr = "promote_common_expr";
@@ -75,6 +80,7 @@ constexpr auto kEleminateOutmostForCond = "eleminate_outmost_for_cond";
 constexpr auto kDisableHalfToFloatSumOpt = "disable_half_to_float_sum_opt";
 constexpr auto kAkgTargetHostName = "stackvm";
 constexpr auto kEnableAutoInline = "enable_auto_inline";
+constexpr auto kEnableInlineCostModel = "enable_inline_cost_model";
 constexpr auto kEnableFeatureLibrary = "enable_feature_library";
 constexpr auto kEnableFeatureLibraryPrePoly = "enable_feature_library_pre_poly";
 constexpr auto kEnableHoistCondWrite = "enable_hoist_cond_write";
@@ -83,6 +89,11 @@ constexpr size_t kMaxNumOfPassTimeToPrint = 5;
 constexpr auto kIsDynamic = "is_dynamic";
 constexpr auto kEnableConvAnalyzeAlign = "enable_conv_analyze_align";
 constexpr auto kEnableHoistAllocate = "enable_hoist_allocate";
+constexpr auto kPolyFootprintThreads = "poly_footprint_threads";
+constexpr auto kMemInferBatch = "mem_infer_batch";
+constexpr auto kMemInferReference = "mem_infer_reference";
+constexpr auto kTilingUBLimit = "tiling_ub_limit";
+constexpr auto kEnableAccessSummary = "enable_access_summary";
 constexpr auto kEnableScalarAlign = "enable_scalar_align";
 constexpr auto kEnableStrideKernelOp = "enable_stride_kernel_op";
 constexpr auto kTileSizeIsVar = "pragma_tilesize_is_var";
@@ -96,6 +107,7 @@ constexpr auto kUBRatio = "ub_ratio";
 constexpr auto kErrorInfo = "";
 constexpr auto kErrorScope = "";
 constexpr auto kAllocBits = "alloc_bits";
+constexpr auto kEnableHostTiling = "enable_host_tiling";
 
 static std::unordered_map<std::string, int> help_tiling_level = {
   {"None", 0},
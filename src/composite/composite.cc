@@ -21,210 +21,83 @@
 #include "build_module.h"
 #include "common/array_api.h"
 #include "composite/util.h"
+#include "composite/stream_parser.h"
 #include "codegen/util.h"
 #include "dmlc/logging.h"
 #include "dmlc/common.h"
-#include "picojson.h"
 #include "topi/broadcast.h"
 #include "topi/elemwise.h"
 
 namespace akg {
-static void create_op_inputs(const picojson::array &arr, Array<NodeRef> *current_op_inputs,
-                             std::unordered_map<std::string, Tensor> *tensor_index_map) {
-  CHECK(current_op_inputs) << "input current_op_inputs is invalid.";
-  CHECK(tensor_index_map) << "input tensor_index_map is invalid.";
-  for (auto i = arr.begin(); i != arr.end(); ++i) {
-    CHECK(i->is<picojson::array>());
-    const picojson::array &arr_t = i->get<picojson::array>();
-    for (auto j = arr_t.begin(); j != arr_t.end(); ++j) {
-      CHECK(j->is<picojson::object>());
-      const picojson::object &obj = j->get<picojson::object>();
-      std::string tensor_name;
+static Type get_type(const std::string &dtype_str) {
+  if (dtype_str.empty()) {
+    return Type();
+  }
+  auto it = type_mapping.find(dtype_str);
+  if (it == type_mapping.end()) {
+    LOG(FATAL) << "Not support dtype str " << dtype_str;
+  }
+  return it->second;
+}
+
+static void create_op_input(const TensorDesc &tensor, Array<NodeRef> *current_op_inputs,
+                            std::unordered_map<std::string, Tensor> *tensor_index_map) {
+  Type type = get_type(tensor.data_type);
+  if (!tensor.has_value()) {
+    auto it = tensor_index_map->find(tensor.name);
+    if (it == tensor_index_map->end()) {
       Array<Expr> shape;
-      Type type;
-      picojson::value tensor_value;
-      bool has_tensor_value = false;
-      for (auto k = obj.begin(); k != obj.end(); ++k) {
-        if (k->first == "tensor_name") {
-          CHECK(k->second.is<std::string>());
-          tensor_name = k->second.get<std::string>();
-          continue;
-        }
-        if (k->first == "shape") {
-          CHECK(k->second.is<picojson::array>());
-          const picojson::array &arr_s = k->second.get<picojson::array>();
-          for (auto l = arr_s.begin(); l != arr_s.end(); ++l) {
-            CHECK(l->is<int64_t>());
-            shape.push_back(Expr(static_cast<int>(l->get<int64_t>())));
-          }
-          continue;
-        }
-        if (k->first == "data_type") {
-          CHECK(k->second.is<std::string>());
-          std::string dtype_str = k->second.get<std::string>();
-          if (type_mapping.find(dtype_str) == type_mapping.end()) {
-            LOG(FATAL) << "Not support dtype str " << dtype_str;
-          }
-          type = type_mapping[dtype_str];
-          continue;
-        }
-        if (k->first == "value" && !k->second.is<picojson::null>()) {
-          tensor_value = k->second;
-          has_tensor_value = true;
-        }
+      for (auto dim : tensor.shape) {
+        shape.push_back(Expr(static_cast<int>(dim)));
       }
+      it = tensor_index_map->emplace(tensor.name, placeholder(shape, type, tensor.name)).first;
+    }
+    current_op_inputs->push_back(it->second);
+    return;
+  }
+  CHECK_EQ(tensor.shape.size(), 1) << "We should not make a expr for a not const tensor.";
+  CHECK_EQ(tensor.shape[0], 1) << "We should not make a expr for a not const tensor.";
+  if (tensor.value_kind == TensorDesc::kFloat) {
+    current_op_inputs->push_back(make_const(type, tensor.float_value));
+  } else if (tensor.value_kind == TensorDesc::kInt) {
+    current_op_inputs->push_back(make_const(type, tensor.int_value));
+  } else {
+    CHECK(0) << "Unknown value type of tensor: " << tensor.name;
+  }
+}
 
-      if (!has_tensor_value) {
-        if (tensor_index_map->count(tensor_name) == 0) {
-          Tensor t = placeholder(shape, type, tensor_name);
-          (*tensor_index_map)[tensor_name] = t;
-        }
-        current_op_inputs->push_back((*tensor_index_map)[tensor_name]);
-      } else {
-        CHECK_EQ(shape.size(), 1) << "We should not make a expr for a not const tensor.";
-        CHECK(Equal(shape[0], Expr(1))) << "We should not make a expr for a not const tensor.";
-        CHECK(!tensor_value.is<picojson::null>()) << "We should has default value of tensor(expr): " << tensor_name;
-        if (tensor_value.is<double>()) {
-          current_op_inputs->push_back(make_const(type, tensor_value.get<double>()));
-        } else if (tensor_value.is<int64_t>()) {
-          current_op_inputs->push_back(make_const(type, tensor_value.get<int64_t>()));
-        } else {
-          CHECK(0) << "Unknown value type of tensor: " << tensor_name;
-        }
-      }
+static void create_op_inputs(const std::vector<std::vector<TensorDesc>> &input_desc, Array<NodeRef> *current_op_inputs,
+                             std::unordered_map<std::string, Tensor> *tensor_index_map) {
+  CHECK(current_op_inputs) << "input current_op_inputs is invalid.";
+  CHECK(tensor_index_map) << "input tensor_index_map is invalid.";
+  for (const auto &group : input_desc) {
+    for (const auto &tensor : group) {
+      create_op_input(tensor, current_op_inputs, tensor_index_map);
     }
   }
 }
 
-static void create_op_inputs(const picojson::array &arr, Array<NodeRef> *current_op_inputs,
+static void create_op_inputs(const std::vector<std::vector<TensorDesc>> &input_desc, Array<NodeRef> *current_op_inputs,
                              std::unordered_map<std::string, Tensor> *tensor_index_map,
                              std::map<std::string, Array<NodeRef>> *output_with_input) {
   CHECK(current_op_inputs) << "current_op_inputs is invalid.";
   CHECK(tensor_index_map) << "tensor_index_map is invalid.";
   CHECK(output_with_input) << "output_with_input is invalid.";
-  for (auto i = arr.begin(); i != arr.end(); ++i) {
-    CHECK(i->is<picojson::array>());
-    const picojson::array &arr_t = i->get<picojson::array>();
-    for (auto j = arr_t.begin(); j != arr_t.end(); ++j) {
-      CHECK(j->is<picojson::object>());
-      const picojson::object &obj = j->get<picojson::object>();
-      std::string tensor_name;
-      Array<Expr> shape;
-      Type type;
-      picojson::value tensor_value;
-      bool has_tensor_value = false;
-      for (auto k = obj.begin(); k != obj.end(); ++k) {
-        if (k->first == "tensor_name") {
-          CHECK(k->second.is<std::string>());
-          tensor_name = k->second.get<std::string>();
-          continue;
-        }
-        if (k->first == "shape") {
-          CHECK(k->second.is<picojson::array>());
-          const picojson::array &arr_s = k->second.get<picojson::array>();
-          for (auto l = arr_s.begin(); l != arr_s.end(); ++l) {
-            CHECK(l->is<int64_t>());
-            shape.push_back(Expr(static_cast<int>(l->get<int64_t>())));
-          }
-          continue;
-        }
-        if (k->first == "data_type") {
-          CHECK(k->second.is<std::string>());
-          std::string dtype_str = k->second.get<std::string>();
-          if (type_mapping.find(dtype_str) == type_mapping.end()) {
-            LOG(FATAL) << "Not support dtype str " << dtype_str;
-          }
-          type = type_mapping[dtype_str];
-          continue;
-        }
-        if (k->first == "value" && !k->second.is<picojson::null>()) {
-          tensor_value = k->second;
-          has_tensor_value = true;
-        }
-      }
-
-      if (output_with_input->count(tensor_name) != 0) {
-        for (auto item : (*output_with_input)[tensor_name]) {
+  for (const auto &group : input_desc) {
+    for (const auto &tensor : group) {
+      auto it = output_with_input->find(tensor.name);
+      if (it != output_with_input->end()) {
+        for (const auto &item : it->second) {
           current_op_inputs->push_back(item);
         }
         continue;
       }
-
-      if (!has_tensor_value) {
-        if (tensor_index_map->count(tensor_name) == 0) {
-          Tensor t = placeholder(shape, type, tensor_name);
-          (*tensor_index_map)[tensor_name] = t;
-        }
-        current_op_inputs->push_back((*tensor_index_map)[tensor_name]);
-      } else {
-        CHECK_EQ(shape.size(), 1) << "We should not make a expr for a not const tensor.";
-        CHECK(Equal(shape[0], Expr(1))) << "We should not make a expr for a not const tensor.";
-        CHECK(!tensor_value.is<picojson::null>()) << "We should has default value of tensor(expr): " << tensor_name;
-        if (tensor_value.is<double>()) {
-          current_op_inputs->push_back(make_const(type, tensor_value.get<double>()));
-        } else if (tensor_value.is<int64_t>()) {
-          current_op_inputs->push_back(make_const(type, tensor_value.get<int64_t>()));
-        } else {
-          CHECK(0) << "Unknown value type of tensor: " << tensor_name;
-        }
-      }
-    }
-  }
-}
-
-// will parse more info for check output tensor
-static void parse_output_label(const picojson::array &arr, std::vector<std::string> *output_tensor_name) {
-  CHECK(output_tensor_name) << "input output_tensor_name is invalid.";
-  for (auto i = arr.begin(); i != arr.end(); ++i) {
-    CHECK(i->is<picojson::object>());
-    const picojson::object &obj = i->get<picojson::object>();
-    for (auto j = obj.begin(); j != obj.end(); ++j) {
-      if (j->first != "tensor_name") {
-        continue;
-      }
-      CHECK(j->second.is<std::string>());
-      output_tensor_name->push_back(j->second.get<std::string>());
+      create_op_input(tensor, current_op_inputs, tensor_index_map);
     }
   }
 }
 
-static void parse_attrs(const picojson::array &arr, Array<NodeRef> *attrs_arr) {
-  CHECK(attrs_arr) << "input attrs_arr is invalid.";
-  for (auto i = arr.begin(); i != arr.end(); ++i) {
-    CHECK(i->is<picojson::object>());
-    const picojson::object &obj = i->get<picojson::object>();
-    for (auto j = obj.begin(); j != obj.end(); ++j) {
-      if (j->first != "value") {
-        continue;
-      }
-
-      if (j->second.is<picojson::array>()) {
-        Array<NodeRef> arr_v;
-        const picojson::array &arr_s = j->second.get<picojson::array>();
-        for (auto l = arr_s.begin(); l != arr_s.end(); ++l) {
-          if (l->is<int64_t>()) {
-            arr_v.push_back(Integer(static_cast<int>(l->get<int64_t>())));
-          } else if (l->is<std::string>()) {
-            arr_v.push_back(StringImm::make(l->get<std::string>()));
-          } else {
-            LOG(FATAL) << "Not parsed type in array attr.";
-          }
-        }
-        attrs_arr->push_back(arr_v);
-      } else if (j->second.is<bool>()) {
-        attrs_arr->push_back(make_const(Int(1), j->second.get<bool>()));
-      } else if (j->second.is<int64_t>()) {
-        attrs_arr->push_back(Integer(static_cast<int>(j->second.get<int64_t>())));
-      } else if (j->second.is<std::string>()) {
-        attrs_arr->push_back(StringImm::make(j->second.get<std::string>()));
-      } else {
-        LOG(FATAL) << "Not parsed type in attrs.";
-      }
-    }
-  }
-}
-
-void extract_op_info(const picojson::array &arr, std::unordered_map<std::string, Tensor> *tensor_index_map,
+void extract_op_info(const std::vector<OpDesc> &op_desc, std::unordered_map<std::string, Tensor> *tensor_index_map,
                      Map<Tensor, Buffer> *in_binds, std::unordered_set<std::string> *fake_output) {
   CHECK(tensor_index_map) << "input tensor_index_map is invalid.";
   CHECK(in_binds) << "input in_binds is invalid.";
@@ -237,88 +110,50 @@ void extract_op_info(const picojson::array &arr, std::unordered_map<std::string,
   std::vector<std::string> output_tensor_labels;
   std::map<std::string, Array<NodeRef>> output_tensor_labels_with_input;
 
-  for (auto i = arr.begin(); i != arr.end(); ++i) {
-    CHECK(i->is<picojson::object>());
-    const picojson::object &v_t = i->get<picojson::object>();
-    std::string op_name;
-
-    for (auto j = v_t.begin(); j != v_t.end(); ++j) {
-      if (j->first == "fusion") {
-        fusionOpName = j->second.get<std::string>();
-        break;
-      }
-    }
-
-    for (auto j = v_t.begin(); j != v_t.end(); ++j) {
-      if (j->first == "name") {
-        CHECK(j->second.is<std::string>());
-        op_name = j->second.get<std::string>();
-        break;
-      }
+  for (const auto &op : op_desc) {
+    if (op.has_fusion) {
+      fusionOpName = op.fusion;
     }
+    std::string op_name = op.name;
+    bool in_fusion = !fusionOpName.empty() && fusionOpName.find("_end") == std::string::npos;
 
-    for (auto j = v_t.begin(); j != v_t.end(); ++j) {
-      if (j->first == "input_desc") {
-        CHECK(j->second.is<picojson::array>());
-        const picojson::array &local_arr = j->second.get<picojson::array>();
-        if (!fusionOpName.empty() && fusionOpName.find("_end") == std::string::npos) {
-          if (op_name == "ZerosLike") {
-            // ZerosLike directly transform to zero
-            Type type;
-            CHECK_EQ(local_arr.size(), 1);
-            const picojson::array &arr_t = local_arr[0].get<picojson::array>();
-            for (auto jx = arr_t.begin(); jx != arr_t.end(); ++jx) {
-              CHECK(jx->is<picojson::object>());
-              const picojson::object &obj = jx->get<picojson::object>();
-              for (auto k = obj.begin(); k != obj.end(); ++k) {
-                if (k->first == "data_type") {
-                  CHECK(k->second.is<std::string>());
-                  std::string dtype_str = k->second.get<std::string>();
-                  if (type_mapping.find(dtype_str) == type_mapping.end()) {
-                    LOG(FATAL) << "Not support dtype str " << dtype_str;
-                  }
-                  type = type_mapping[dtype_str];
-                  break;
-                }
-              }
+    if (op.has_input_desc) {
+      if (in_fusion) {
+        if (op_name == "ZerosLike") {
+          // ZerosLike directly transform to zero
+          CHECK_EQ(op.input_desc.size(), 1);
+          Type type;
+          for (const auto &tensor : op.input_desc[0]) {
+            if (!tensor.data_type.empty()) {
+              type = get_type(tensor.data_type);
+              break;
             }
-            current_op_inputs.push_back(make_zero(type));
-          } else {
-            create_op_inputs(local_arr, &current_op_inputs, tensor_index_map);
           }
+          current_op_inputs.push_back(make_zero(type));
         } else {
-          create_op_inputs(local_arr, &final_op_inputs, tensor_index_map, &output_tensor_labels_with_input);
+          create_op_inputs(op.input_desc, &current_op_inputs, tensor_index_map);
         }
-        break;
+      } else {
+        create_op_inputs(op.input_desc, &final_op_inputs, tensor_index_map, &output_tensor_labels_with_input);
       }
     }
 
-    for (auto j = v_t.begin(); j != v_t.end(); ++j) {
-      if (j->first == "output_desc") {
-        CHECK(j->second.is<picojson::array>());
-        const picojson::array &local_arr = j->second.get<picojson::array>();
-        parse_output_label(local_arr, &output_tensor_labels);
-        if (!fusionOpName.empty() && fusionOpName.find("_end") == std::string::npos) {
-          for (auto &output : output_tensor_labels) {
-            output_tensor_labels_with_input[output] = current_op_inputs;
-          }
-        }
-        break;
+    // will parse more info for check output tensor
+    for (const auto &output : op.output_desc) {
+      output_tensor_labels.push_back(output.name);
+    }
+    if (in_fusion) {
+      for (auto &output : output_tensor_labels) {
+        output_tensor_labels_with_input[output] = current_op_inputs;
       }
     }
 
-    for (auto j = v_t.begin(); j != v_t.end(); ++j) {
-      if (j->first == "attr") {
-        if (j->second.is<picojson::array>()) {
-          const picojson::array &local_arr = j->second.get<picojson::array>();
-          parse_attrs(local_arr, &attrs_arr);
-        }
-        break;
-      }
+    for (const auto &attr : op.attrs) {
+      attrs_arr.push_back(attr);
     }
 
     if (!fusionOpName.empty()) {
-      if (fusionOpName.find("_end") == std::string::npos) {
+      if (in_fusion) {
         current_op_inputs = {};
         output_tensor_labels.clear();
         continue;
@@ -364,89 +199,51 @@ void extract_op_info(const picojson::array &arr, std::unordered_map<std::string,
   }
 }
 
-void extract_op_info(const picojson::value &v, Array<Tensor> *ops, Array<NodeRef> *args, std::string *kernel_name,
+void extract_op_info(const CompositeDesc &desc, Array<Tensor> *ops, Array<NodeRef> *args, std::string *kernel_name,
                      Map<Tensor, Buffer> *in_binds) {
   CHECK(ops) << "input ops is invalid.";
   CHECK(args) << "input args is invalid.";
   CHECK(kernel_name) << "input kernel_name is invalid.";
   CHECK(in_binds) << "input in_binds is invalid.";
-  picojson::array input_desc;
-  picojson::array output_desc;
-  picojson::array op_desc;
-  CHECK(v.is<picojson::object>());
-
-  const picojson::value::object &obj = v.get<picojson::object>();
-  for (auto i = obj.begin(); i != obj.end(); ++i) {
-    if (i->first == "op") {
-      CHECK(i->second.is<std::string>());
-      *kernel_name = i->second.get<std::string>();
-    } else if (i->first == "input_desc") {
-      CHECK(i->second.is<picojson::array>());
-      input_desc = i->second.get<picojson::array>();
-    } else if (i->first == "output_desc") {
-      CHECK(i->second.is<picojson::array>());
-      output_desc = i->second.get<picojson::array>();
-    } else if (i->first == "op_desc") {
-      CHECK(i->second.is<picojson::array>());
-      op_desc = i->second.get<picojson::array>();
-    }
-  }
+  *kernel_name = desc.op;
 
   std::unordered_map<std::string, Tensor> tensor_index_map;
   std::unordered_set<std::string> fake_output;
-  extract_op_info(op_desc, &tensor_index_map, in_binds, &fake_output);
+  extract_op_info(desc.op_desc, &tensor_index_map, in_binds, &fake_output);
 
-  for (auto i = input_desc.begin(); i != input_desc.end(); ++i) {
-    CHECK(i->is<picojson::array>());
-    const picojson::array &arr_t = i->get<picojson::array>();
-    CHECK(arr_t.begin()->is<picojson::object>());
-    const picojson::object &local_obj = arr_t.begin()->get<picojson::object>();
-    for (auto j = local_obj.begin(); j != local_obj.end(); ++j) {
-      if (j->first != "tensor_name") continue;
-      CHECK(j->second.is<std::string>());
-      const std::string &tensor_name = j->second.get<std::string>();
-      auto iter = tensor_index_map.find(tensor_name);
-      if (iter != tensor_index_map.end()) {
-        args->push_back(iter->second);
-      } else {
-        LOG(FATAL) << "Tensor " << tensor_name << " not built.";
-      }
+  for (const auto &group : desc.input_desc) {
+    CHECK(!group.empty());
+    const std::string &tensor_name = group.front().name;
+    auto iter = tensor_index_map.find(tensor_name);
+    if (iter != tensor_index_map.end()) {
+      args->push_back(iter->second);
+    } else {
+      LOG(FATAL) << "Tensor " << tensor_name << " not built.";
     }
   }
 
-  for (auto i = output_desc.begin(); i != output_desc.end(); ++i) {
-    CHECK(i->is<picojson::object>());
-    const picojson::object &local_obj = i->get<picojson::object>();
-    for (auto j = local_obj.begin(); j != local_obj.end(); ++j) {
-      if (j->first != "tensor_name") continue;
-      CHECK(j->second.is<std::string>());
-      const std::string &tensor_name = j->second.get<std::string>();
-      auto iter = tensor_index_map.find(tensor_name);
-      if (iter != tensor_index_map.end()) {
-        ops->push_back(iter->second);
-        if (!fake_output.count(tensor_name)) {
-          args->push_back(iter->second);
-        }
-      } else {
-        LOG(FATAL) << "Tensor " << tensor_name << " not built.";
+  for (const auto &output : desc.output_desc) {
+    const std::string &tensor_name = output.name;
+    auto iter = tensor_index_map.find(tensor_name);
+    if (iter != tensor_index_map.end()) {
+      ops->push_back(iter->second);
+      if (!fake_output.count(tensor_name)) {
+        args->push_back(iter->second);
       }
+    } else {
+      LOG(FATAL) << "Tensor " << tensor_name << " not built.";
     }
   }
 }
 
-NodeRef composite_with_json_to_func(const std::string &json_str, Map<std::string, NodeRef> attrs) {
-  picojson::value v;
-  std::string err = picojson::parse(v, json_str);
-  if (!err.empty()) {
-    LOG(ERROR) << "json parse error, error message: " << err;
-  }
+static NodeRef composite_desc_to_func(const CompositeDesc &desc, Map<std::string, NodeRef> attrs) {
   const char *akg_dump_pass_ir = getenv("MS_AKG_DUMP_IR");
   Array<Tensor> tensors;
   Array<NodeRef> args;
   Array<NodeRef> shape_vars;
   Map<Tensor, Buffer> in_binds;
   std::string kernel_name;
-  extract_op_info(v, &tensors, &args, &kernel_name, &in_binds);
+  extract_op_info(desc, &tensors, &args, &kernel_name, &in_binds);
   Array<Operation> ops;
   std::for_each(tensors.begin(), tensors.end(), [&ops](const Tensor &t) { ops.push_back(t->op); });
   Schedule sch = create_schedule(ops);
@@ -459,12 +256,12 @@ NodeRef composite_with_json_to_func(const std::string &json_str, Map<std::string
   return build_rst;
 }
 
-std::string get_process(const std::string &json_str) {
-  size_t pos = json_str.find("\"process\"");
-  if (pos != std::string::npos && json_str.find("gpu", pos) != std::string::npos) {
-    return "gpu";
-  }
-  return "aicore";
+NodeRef composite_with_json_to_func(const std::string &json_str, Map<std::string, NodeRef> attrs) {
+  return composite_desc_to_func(ParseCompositeDesc(json_str), attrs);
+}
+
+NodeRef composite_parsed_to_func(const ParsedComposite &parsed, Map<std::string, NodeRef> attrs) {
+  return composite_desc_to_func(parsed->desc, attrs);
 }
 
 std::string get_schedule(Array<Tensor> &outputs) {
@@ -476,43 +273,56 @@ std::string get_schedule(Array<Tensor> &outputs) {
   return "injective";
 }
 
-Module composite_with_json_gpu(const std::string &json_str, Map<std::string, NodeRef> attrs) {
-  picojson::value v;
-  std::string err = picojson::parse(v, json_str);
-  if (!err.empty()) {
-    LOG(ERROR) << "json parse error, error message: " << err;
-  }
+Module composite_with_json_gpu(const CompositeDesc &desc, Map<std::string, NodeRef> attrs) {
   Array<Tensor> tensors;
   Array<NodeRef> args;
   Map<Tensor, Buffer> in_binds;
   std::string kernel_name;
-  extract_op_info(v, &tensors, &args, &kernel_name, &in_binds);
+  extract_op_info(desc, &tensors, &args, &kernel_name, &in_binds);
   const auto* build_func = air::runtime::Registry::Get("akg_build_gpu_module");
   CHECK(build_func != nullptr);
   std::string sch = get_schedule(tensors);
   return (*build_func)(tensors, args, sch, kernel_name);
 }
 
-Module composite_with_json(const std::string &json_str, Map<std::string, NodeRef> attrs) {
-  if (get_process(json_str) == "gpu") {
-    return composite_with_json_gpu(json_str, attrs);
+Module composite_with_json_cpu(const CompositeDesc &desc, Map<std::string, NodeRef> attrs) {
+  Array<Tensor> tensors;
+  Array<NodeRef> args;
+  Map<Tensor, Buffer> in_binds;
+  std::string kernel_name;
+  extract_op_info(desc, &tensors, &args, &kernel_name, &in_binds);
+  const auto* build_func = air::runtime::Registry::Get("akg_build_cpu_module");
+  CHECK(build_func != nullptr);
+  return (*build_func)(tensors, args, kernel_name);
+}
+
+Module composite_desc_build(const CompositeDesc &desc, Map<std::string, NodeRef> attrs) {
+  if (desc.process == "gpu") {
+    return composite_with_json_gpu(desc, attrs);
+  }
+  if (desc.process == "cpu") {
+    return composite_with_json_cpu(desc, attrs);
   }
-  auto build_rst = composite_with_json_to_func(json_str, attrs);
+  auto build_rst = composite_desc_to_func(desc, attrs);
   return BuildToModule(build_rst);
 }
 
+Module composite_with_json(const std::string &json_str, Map<std::string, NodeRef> attrs) {
+  return composite_desc_build(ParseCompositeDesc(json_str), attrs);
+}
+
+Module composite_parsed_build(const ParsedComposite &parsed, Map<std::string, NodeRef> attrs) {
+  return composite_desc_build(parsed->desc, attrs);
+}
+
 NodeRef composite_lower(const std::string &json_str, Map<std::string, NodeRef> attrs) {
-  picojson::value v;
-  std::string err = picojson::parse(v, json_str);
-  if (!err.empty()) {
-    LOG(ERROR) << "json parse error, error message: " << err;
-  }
+  CompositeDesc desc = ParseCompositeDesc(json_str);
   Array<Tensor> tensors;
   Array<NodeRef> args;
   Array<NodeRef> shape_vars;
   Map<Tensor, Buffer> in_binds;
   std::string kernel_name;
-  extract_op_info(v, &tensors, &args, &kernel_name, &in_binds);
+  extract_op_info(desc, &tensors, &args, &kernel_name, &in_binds);
   Array<Operation> ops;
   std::for_each(tensors.begin(), tensors.end(), [&ops](const Tensor &t) { ops.push_back(t->op); });
   Schedule sch = create_schedule(ops);
@@ -524,6 +334,9 @@ NodeRef composite_lower(const std::string &json_str, Map<std::string, NodeRef> a
 
 TVM_REGISTER_GLOBAL("composite_with_json_to_func").set_body_typed(composite_with_json_to_func);
 TVM_REGISTER_GLOBAL("composite_with_json").set_body_typed(composite_with_json);
+TVM_REGISTER_GLOBAL("composite_parsed_to_func").set_body_typed(composite_parsed_to_func);
+TVM_REGISTER_GLOBAL("composite_parsed_build").set_body_typed(composite_parsed_build);
+TVM_REGISTER_GLOBAL("composite_get_process").set_body_typed(GetCompositeProcess);
 
 TVM_REGISTER_GLOBAL("composite_lower").set_body_typed(composite_lower);
 }  // namespace akg
@@ -0,0 +1,551 @@
+/**
+ * Copyright 2026 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "composite/stream_parser.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+
+#include "dmlc/logging.h"
+
+namespace akg {
+namespace {
+inline bool IsDigit(char c) { return isdigit(static_cast<unsigned char>(c)) != 0; }
+
+/*!
+ * \brief Pull reader over a json text.
+ *
+ *  Objects and arrays are visited through callbacks, so the caller decides per key whether a value is read
+ *  into its own structure or skipped. Nothing is materialized beyond what the callbacks keep.
+ */
+class JsonReader {
+ public:
+  explicit JsonReader(const std::string &str) : str_(str) {}
+
+  char Peek() {
+    SkipSpace();
+    return pos_ < str_.size() ? str_[pos_] : '\0';
+  }
+
+  void Expect(char c) {
+    if (Peek() != c) {
+      Fail(std::string("expect '") + c + "'");
+    }
+    ++pos_;
+  }
+
+  // calls on_key(key) for every member, on_key has to consume the value
+  template <typename F>
+  void ReadObject(F on_key) {
+    Expect('{');
+    if (Peek() == '}') {
+      ++pos_;
+      return;
+    }
+    std::string key;
+    while (true) {
+      ReadString(&key);
+      Expect(':');
+      on_key(key);
+      char c = Peek();
+      ++pos_;
+      if (c == '}') break;
+      if (c != ',') Fail("expect ',' or '}' in object");
+    }
+  }
+
+  // calls on_item() for every element, on_item has to consume the value
+  template <typename F>
+  void ReadArray(F on_item) {
+    Expect('[');
+    if (Peek() == ']') {
+      ++pos_;
+      return;
+    }
+    while (true) {
+      on_item();
+      char c = Peek();
+      ++pos_;
+      if (c == ']') break;
+      if (c != ',') Fail("expect ',' or ']' in array");
+    }
+  }
+
+  void ReadString(std::string *out) {
+    Expect('"');
+    out->clear();
+    while (true) {
+      if (pos_ >= str_.size()) Fail("unterminated string");
+      // copy the plain run in one go
+      size_t run = pos_;
+      while (run < str_.size() && str_[run] != '"' && str_[run] != '\\') ++run;
+      out->append(str_, pos_, run - pos_);
+      pos_ = run;
+      if (pos_ >= str_.size()) Fail("unterminated string");
+      if (str_[pos_++] == '"') return;
+      if (pos_ >= str_.size()) Fail("unterminated escape");
+      char c = str_[pos_++];
+      switch (c) {
+        case '"':
+        case '\\':
+        case '/':
+          out->push_back(c);
+          break;
+        case 'b':
+          out->push_back('\b');
+          break;
+        case 'f':
+          out->push_back('\f');
+          break;
+        case 'n':
+          out->push_back('\n');
+          break;
+        case 'r':
+          out->push_back('\r');
+          break;
+        case 't':
+          out->push_back('\t');
+          break;
+        case 'u':
+          AppendUtf8(ReadCodePoint(), out);
+          break;
+        default:
+          Fail("invalid escape");
+      }
+    }
+  }
+
+  std::string ReadString() {
+    std::string res;
+    ReadString(&res);
+    return res;
+  }
+
+  // reads a number, integers that fit in int64 are returned as kInt, anything else as kFloat
+  TensorDesc::ValueKind ReadNumber(int64_t *int_value, double *float_value) {
+    SkipSpace();
+    size_t begin = pos_;
+    bool is_int = true;
+    if (pos_ < str_.size() && str_[pos_] == '-') ++pos_;
+    while (pos_ < str_.size()) {
+      char c = str_[pos_];
+      if (c == '.' || c == 'e' || c == 'E') {
+        is_int = false;
+      } else if (!IsDigit(c) && c != '+' && c != '-') {
+        break;
+      }
+      ++pos_;
+    }
+    if (pos_ == begin) Fail("expect a number");
+    std::string text(str_, begin, pos_ - begin);
+    if (is_int) {
+      errno = 0;
+      char *end = nullptr;
+      long long res = strtoll(text.c_str(), &end, 10);
+      if (errno == 0 && *end == '\0') {
+        *int_value = static_cast<int64_t>(res);
+        *float_value = static_cast<double>(res);
+        return TensorDesc::kInt;
+      }
+    }
+    char *end = nullptr;
+    *float_value = strtod(text.c_str(), &end);
+    if (*end != '\0') Fail("invalid number " + text);
+    return TensorDesc::kFloat;
+  }
+
+  int64_t ReadInt() {
+    int64_t int_value = 0;
+    double float_value = 0.0;
+    if (ReadNumber(&int_value, &float_value) != TensorDesc::kInt) Fail("expect an integer");
+    return int_value;
+  }
+
+  bool ReadBool() {
+    if (Match("true")) return true;
+    if (Match("false")) return false;
+    Fail("expect a bool");
+    return false;
+  }
+
+  void ReadNull() {
+    if (!Match("null")) Fail("expect null");
+  }
+
+  void SkipValue() {
+    switch (Peek()) {
+      case '{':
+        ReadObject([this](const std::string &) { SkipValue(); });
+        break;
+      case '[':
+        ReadArray([this]() { SkipValue(); });
+        break;
+      case '"': {
+        std::string ignored;
+        ReadString(&ignored);
+        break;
+      }
+      case 't':
+      case 'f':
+        static_cast<void>(ReadBool());
+        break;
+      case 'n':
+        ReadNull();
+        break;
+      default: {
+        int64_t int_value = 0;
+        double float_value = 0.0;
+        static_cast<void>(ReadNumber(&int_value, &float_value));
+      }
+    }
+  }
+
+  void ExpectEnd() {
+    if (Peek() != '\0') Fail("unexpected trailing characters");
+  }
+
+  void Fail(const std::string &msg) const { LOG(FATAL) << "json parse error at offset " << pos_ << ": " << msg; }
+
+ private:
+  void SkipSpace() {
+    while (pos_ < str_.size() && isspace(static_cast<unsigned char>(str_[pos_]))) ++pos_;
+  }
+
+  bool Match(const char *word) {
+    SkipSpace();
+    size_t len = strlen(word);
+    if (str_.compare(pos_, len, word) != 0) return false;
+    pos_ += len;
+    return true;
+  }
+
+  uint32_t ReadHex4() {
+    if (pos_ + 4 > str_.size()) Fail("invalid \\u escape");
+    uint32_t res = 0;
+    for (int i = 0; i < 4; ++i) {
+      char c = str_[pos_++];
+      res <<= 4;
+      if (c >= '0' && c <= '9') {
+        res |= static_cast<uint32_t>(c - '0');
+      } else if (c >= 'a' && c <= 'f') {
+        res |= static_cast<uint32_t>(c - 'a' + 10);
+      } else if (c >= 'A' && c <= 'F') {
+        res |= static_cast<uint32_t>(c - 'A' + 10);
+      } else {
+        Fail("invalid \\u escape");
+      }
+    }
+    return res;
+  }
+
+  uint32_t ReadCodePoint() {
+    uint32_t cp = ReadHex4();
+    if (cp >= 0xD800 && cp <= 0xDBFF && str_.compare(pos_, 2, "\\u") == 0) {
+      pos_ += 2;
+      uint32_t low = ReadHex4();
+      if (low < 0xDC00 || low > 0xDFFF) Fail("invalid surrogate pair");
+      cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+    }
+    return cp;
+  }
+
+  static void AppendUtf8(uint32_t cp, std::string *out) {
+    if (cp < 0x80) {
+      out->push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+      out->push_back(static_cast<char>(0xC0 | (cp >> 6)));
+      out->push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+      out->push_back(static_cast<char>(0xE0 | (cp >> 12)));
+      out->push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+      out->push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+      out->push_back(static_cast<char>(0xF0 | (cp >> 18)));
+      out->push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+      out->push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+      out->push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+  }
+
+  const std::string &str_;
+  size_t pos_{0};
+};
+
+void ReadTensorDesc(JsonReader *reader, TensorDesc *tensor) {
+  reader->ReadObject([reader, tensor](const std::string &key) {
+    if (key == "tensor_name") {
+      reader->ReadString(&tensor->name);
+    } else if (key == "shape") {
+      reader->ReadArray([reader, tensor]() { tensor->shape.push_back(reader->ReadInt()); });
+    } else if (key == "data_type") {
+      reader->ReadString(&tensor->data_type);
+    } else if (key == "value") {
+      char c = reader->Peek();
+      if (c == 'n') {
+        reader->ReadNull();
+        tensor->value_kind = TensorDesc::kNone;
+      } else if (c == '-' || IsDigit(c)) {
+        tensor->value_kind = reader->ReadNumber(&tensor->int_value, &tensor->float_value);
+      } else {
+        reader->SkipValue();
+        tensor->value_kind = TensorDesc::kOther;
+      }
+    } else {
+      reader->SkipValue();
+    }
+  });
+}
+
+void ReadTensorList(JsonReader *reader, std::vector<TensorDesc> *tensors) {
+  reader->ReadArray([reader, tensors]() {
+    tensors->emplace_back();
+    ReadTensorDesc(reader, &tensors->back());
+  });
+}
+
+void ReadTensorGroups(JsonReader *reader, std::vector<std::vector<TensorDesc>> *groups) {
+  reader->ReadArray([reader, groups]() {
+    groups->emplace_back();
+    ReadTensorList(reader, &groups->back());
+  });
+}
+
+NodeRef ReadAttrValue(JsonReader *reader) {
+  char c = reader->Peek();
+  if (c == '[') {
+    Array<NodeRef> arr;
+    reader->ReadArray([reader, &arr]() {
+      char item = reader->Peek();
+      if (item == '"') {
+        arr.push_back(StringImm::make(reader->ReadString()));
+      } else if (item == '-' || IsDigit(item)) {
+        int64_t int_value = 0;
+        double float_value = 0.0;
+        if (reader->ReadNumber(&int_value, &float_value) != TensorDesc::kInt) {
+          LOG(FATAL) << "Not parsed type in array attr.";
+        }
+        arr.push_back(Integer(static_cast<int>(int_value)));
+      } else {
+        LOG(FATAL) << "Not parsed type in array attr.";
+      }
+    });
+    return arr;
+  }
+  if (c == 't' || c == 'f') {
+    return make_const(Int(1), reader->ReadBool());
+  }
+  if (c == '"') {
+    return StringImm::make(reader->ReadString());
+  }
+  if (c == '-' || IsDigit(c)) {
+    int64_t int_value = 0;
+    double float_value = 0.0;
+    if (reader->ReadNumber(&int_value, &float_value) == TensorDesc::kInt) {
+      return Integer(static_cast<int>(int_value));
+    }
+  }
+  LOG(FATAL) << "Not parsed type in attrs.";
+  return NodeRef();
+}
+
+void ReadOpDesc(JsonReader *reader, OpDesc *op) {
+  reader->ReadObject([reader, op](const std::string &key) {
+    if (key == "name") {
+      reader->ReadString(&op->name);
+    } else if (key == "fusion") {
+      op->has_fusion = true;
+      reader->ReadString(&op->fusion);
+    } else if (key == "input_desc") {
+      op->has_input_desc = true;
+      ReadTensorGroups(reader, &op->input_desc);
+    } else if (key == "output_desc") {
+      ReadTensorList(reader, &op->output_desc);
+    } else if (key == "attr" && reader->Peek() == '[') {
+      reader->ReadArray([reader, op]() {
+        reader->ReadObject([reader, op](const std::string &attr_key) {
+          if (attr_key == "value") {
+            op->attrs.push_back(ReadAttrValue(reader));
+          } else {
+            reader->SkipValue();
+          }
+        });
+      });
+    } else {
+      reader->SkipValue();
+    }
+  });
+}
+
+std::string JoinShape(const std::vector<int64_t> &shape) {
+  std::string res;
+  for (size_t i = 0; i < shape.size(); ++i) {
+    if (i > 0) res += '_';
+    res += std::to_string(shape[i]);
+  }
+  return res;
+}
+
+std::string JoinTraits(const std::vector<std::string> &traits) {
+  std::string res;
+  for (size_t i = 0; i < traits.size(); ++i) {
+    if (i > 0) res += '.';
+    res += traits[i];
+  }
+  return res;
+}
+
+// a trait equal to the previous one is folded into a trailing '-'
+void AppendTrait(std::vector<std::string> *traits, const std::string &data) {
+  if (!traits->empty()) {
+    std::string &last = traits->back();
+    size_t len = last.find_last_not_of('-');
+    len = len == std::string::npos ? 0 : len + 1;
+    if (last.compare(0, len, data) == 0 && len == data.size()) {
+      last += '-';
+      return;
+    }
+  }
+  traits->push_back(data);
+}
+
+const TensorDesc &FirstTensor(const std::vector<TensorDesc> &group) {
+  CHECK(!group.empty()) << "empty tensor list in input_desc";
+  return group.front();
+}
+
+std::string GetComputeTrait(const CompositeDesc &desc) {
+  std::unordered_map<std::string, int> tensor_idx;
+  int counter = 0;
+  for (const auto &group : desc.input_desc) {
+    tensor_idx[FirstTensor(group).name] = counter++;
+  }
+  std::vector<std::string> traits{std::to_string(desc.input_desc.size())};
+  for (const auto &op : desc.op_desc) {
+    std::vector<int> input_idx;
+    for (const auto &group : op.input_desc) {
+      const TensorDesc &input = FirstTensor(group);
+      if (input.has_value()) continue;
+      auto it = tensor_idx.find(input.name);
+      CHECK(it != tensor_idx.end()) << "Tensor " << input.name << " of op " << op.name << " is not defined.";
+      input_idx.push_back(counter - it->second);
+    }
+    std::sort(input_idx.begin(), input_idx.end());
+    std::string trait = op.name;
+    for (auto idx : input_idx) {
+      trait += std::to_string(idx);
+    }
+    traits.push_back(trait);
+    CHECK(!op.output_desc.empty()) << "op " << op.name << " has no output.";
+    tensor_idx[op.output_desc.front().name] = counter++;
+  }
+  std::vector<int> output_idx;
+  for (const auto &output : desc.output_desc) {
+    auto it = tensor_idx.find(output.name);
+    CHECK(it != tensor_idx.end()) << "Tensor " << output.name << " not built.";
+    output_idx.push_back(it->second);
+  }
+  std::sort(output_idx.begin(), output_idx.end());
+  std::string trait;
+  for (auto idx : output_idx) {
+    trait += std::to_string(idx);
+  }
+  traits.push_back(trait);
+  return JoinTraits(traits);
+}
+}  // namespace
+
+CompositeDesc ParseCompositeDesc(const std::string &json_str) {
+  CompositeDesc desc;
+  JsonReader reader(json_str);
+  reader.ReadObject([&reader, &desc](const std::string &key) {
+    if (key == "op") {
+      reader.ReadString(&desc.op);
+    } else if (key == "process") {
+      reader.ReadString(&desc.process);
+    } else if (key == "input_desc") {
+      ReadTensorGroups(&reader, &desc.input_desc);
+    } else if (key == "output_desc") {
+      ReadTensorList(&reader, &desc.output_desc);
+    } else if (key == "op_desc") {
+      reader.ReadArray([&reader, &desc]() {
+        desc.op_desc.emplace_back();
+        ReadOpDesc(&reader, &desc.op_desc.back());
+      });
+    } else {
+      reader.SkipValue();
+    }
+  });
+  reader.ExpectEnd();
+  return desc;
+}
+
+namespace {
+std::string NormalizeProcess(const std::string &process) {
+  return (process == "gpu" || process == "cpu") ? process : "aicore";
+}
+}  // namespace
+
+std::string GetCompositeProcess(const std::string &json_str) {
+  std::string process;
+  JsonReader reader(json_str);
+  reader.ReadObject([&reader, &process](const std::string &key) {
+    if (key == "process") {
+      reader.ReadString(&process);
+    } else {
+      reader.SkipValue();
+    }
+  });
+  reader.ExpectEnd();
+  return NormalizeProcess(process);
+}
+
+std::vector<std::string> GetCompositeTrait(const CompositeDesc &desc) {
+  std::vector<std::string> shape_traits;
+  std::vector<std::string> dtype_traits;
+  for (const auto &group : desc.input_desc) {
+    const TensorDesc &input = FirstTensor(group);
+    AppendTrait(&shape_traits, JoinShape(input.shape));
+    AppendTrait(&dtype_traits, input.data_type);
+  }
+  for (const auto &output : desc.output_desc) {
+    AppendTrait(&shape_traits, JoinShape(output.shape));
+    AppendTrait(&dtype_traits, output.data_type);
+  }
+  return {GetComputeTrait(desc), JoinTraits(shape_traits), JoinTraits(dtype_traits)};
+}
+
+ParsedComposite ParseComposite(const std::string &json_str) {
+  auto node = make_node<ParsedCompositeNode>();
+  node->desc = ParseCompositeDesc(json_str);
+  node->process = NormalizeProcess(node->desc.process);
+  for (const auto &trait : GetCompositeTrait(node->desc)) {
+    node->trait.push_back(StringImm::make(trait));
+  }
+  return ParsedComposite(node);
+}
+
+TVM_REGISTER_NODE_TYPE(ParsedCompositeNode);
+
+TVM_REGISTER_GLOBAL("composite_parse").set_body_typed(ParseComposite);
+
+TVM_REGISTER_GLOBAL("composite_trait").set_body([](const TVMArgs &args, TVMRetValue *ret) {
+  std::string json_str = args[0];
+  *ret = ParseComposite(json_str)->trait;
+});
+}  // namespace akg
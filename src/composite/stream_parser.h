@@ -0,0 +1,108 @@
+/**
+ * Copyright 2026 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMPOSITE_STREAM_PARSER_H_
+#define COMPOSITE_STREAM_PARSER_H_
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "tvm.h"
+
+namespace akg {
+/*! \brief One tensor of "input_desc"/"output_desc", only the keys used by the composite front end are kept */
+struct TensorDesc {
+  enum ValueKind { kNone = 0, kInt, kFloat, kOther };
+
+  std::string name;
+  std::vector<int64_t> shape;
+  std::string data_type;
+  ValueKind value_kind{kNone};
+  int64_t int_value{0};
+  double float_value{0.0};
+
+  bool has_value() const { return value_kind != kNone; }
+};
+
+/*! \brief One entry of "op_desc"; attrs are converted to the NodeRefs handed to the topi functions */
+struct OpDesc {
+  std::string name;
+  bool has_fusion{false};
+  std::string fusion;
+  bool has_input_desc{false};
+  std::vector<std::vector<TensorDesc>> input_desc;
+  std::vector<TensorDesc> output_desc;
+  Array<NodeRef> attrs;
+};
+
+/*! \brief A whole composite kernel description */
+struct CompositeDesc {
+  std::string op;
+  std::string process;
+  std::vector<std::vector<TensorDesc>> input_desc;
+  std::vector<TensorDesc> output_desc;
+  std::vector<OpDesc> op_desc;
+};
+
+/*!
+ * \brief Parse a composite json description in a single pass.
+ *
+ *  The json text is read directly into CompositeDesc, keys the front end does not use are skipped without
+ *  building any intermediate document. Malformed json is fatal and reports the byte offset.
+ */
+CompositeDesc ParseCompositeDesc(const std::string &json_str);
+
+/*!
+ * \brief The "process" of a composite json description, "gpu", "cpu" or "aicore".
+ *
+ *  Reads the top level keys only, with the same reader and the same errors as ParseCompositeDesc.
+ */
+std::string GetCompositeProcess(const std::string &json_str);
+
+/*!
+ * \brief Compute, shape and dtype trait of a kernel, the keys of the composite repository.
+ *
+ *  Same format as generate_trait in python/akg/composite/build_module.py.
+ */
+std::vector<std::string> GetCompositeTrait(const CompositeDesc &desc);
+
+/*!
+ * \brief A composite description parsed once, with its process and trait.
+ *
+ *  Handed back to python by "composite_parse", so that looking up the repository and building the kernel
+ *  reuse the same parse.
+ */
+class ParsedCompositeNode : public Node {
+ public:
+  CompositeDesc desc;
+  std::string process;
+  Array<Expr> trait;
+
+  void VisitAttrs(AttrVisitor *v) {
+    v->Visit("process", &process);
+    v->Visit("trait", &trait);
+  }
+
+  static constexpr const char *_type_key = "ParsedComposite";
+  TVM_DECLARE_NODE_TYPE_INFO(ParsedCompositeNode, Node);
+};
+
+TVM_DEFINE_NODE_REF(ParsedComposite, ParsedCompositeNode);
+
+/*! \brief Parse a composite json description with ParseCompositeDesc and compute its process and trait */
+ParsedComposite ParseComposite(const std::string &json_str);
+}  // namespace akg
+#endif  // COMPOSITE_STREAM_PARSER_H_
@@ -0,0 +1,361 @@
+/**
+ * Copyright 2026 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "contrib/cce_parm/hardware_profile.h"
+
+#include <picojson.h>
+#include <tvm/api_registry.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+#include "contrib/cce_parm/cceconf.h"
+
+using std::map;
+using std::string;
+
+namespace akg {
+namespace cceconf {
+using air::runtime::TVMArgs;
+using air::runtime::TVMRetValue;
+
+namespace {
+constexpr auto kProfileEnv = "AKG_HARDWARE_PROFILE";
+constexpr auto kDefaultEntry = "*";
+constexpr auto kGlobalDma = "global";
+constexpr auto kLocalDma = "local";
+
+// storage scopes and their buffer keys in CceConf
+const map<string, string> kScopeBuffers = {
+  {"local.UB", "Unified_Buffer"}, {"local.L1", "L1_Buffer"},   {"local.L0A", "L0A_Buffer"},
+  {"local.L0B", "L0B_Buffer"},    {"local.L0C", "L0C_Buffer"}, {"global.L2", "L2_Buffer"},
+};
+
+bool GetInt(const picojson::object &obj, const string &key, int64_t *value) {
+  auto it = obj.find(key);
+  if (it == obj.end()) {
+    return false;
+  }
+  if (it->second.is<int64_t>()) {
+    *value = it->second.get<int64_t>();
+    return true;
+  }
+  if (it->second.is<double>()) {
+    *value = static_cast<int64_t>(it->second.get<double>());
+    return true;
+  }
+  LOG(WARNING) << "hardware profile: " << key << " is not a number";
+  return false;
+}
+
+template <typename T>
+bool GetInt(const picojson::object &obj, const string &key, T *value) {
+  int64_t v = 0;
+  if (!GetInt(obj, key, &v)) {
+    return false;
+  }
+  *value = static_cast<T>(v);
+  return true;
+}
+
+// the object of key, nullptr when missing or of another type
+const picojson::object *GetObject(const picojson::object &obj, const string &key) {
+  auto it = obj.find(key);
+  if (it == obj.end() || !it->second.is<picojson::object>()) {
+    return nullptr;
+  }
+  return &it->second.get<picojson::object>();
+}
+
+picojson::value Int(int64_t v) { return picojson::value(v); }
+
+// guards the profile, a load replaces it while compile passes may read it
+std::mutex &ProfileMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+}  // namespace
+
+HardwareProfile::HardwareProfile()
+    : name_("default"), core_num_(-1), vector_bytes_(256), core_granularity_(8192) {
+  for (const auto &it : kScopeBuffers) {
+    memory_[it.first] = -1;
+  }
+  pipes_ = {{"pipe_s", 10},    {"pipe_v", 40},     {"pipe_m", 120},
+            {"pipe_mte1", 80}, {"pipe_mte2", 300}, {"pipe_mte3", 300}};
+  intrinsics_[kDefaultEntry][kDefaultEntry] = IntrinCost{8, 1};
+  intrinsics_["set_vector_mask"][kDefaultEntry] = IntrinCost{4, 0};
+  // cycles of each fractal of the cube
+  intrinsics_["mmad"][kDefaultEntry] = IntrinCost{0, 1};
+  intrinsics_["scalar"][kDefaultEntry] = IntrinCost{1, 0};
+  // transfers from or to global memory are much slower
+  dma_[kGlobalDma] = DmaCost{200, 10, 64};
+  dma_[kLocalDma] = DmaCost{20, 0, 256};
+}
+
+HardwareProfile *HardwareProfile::getInstance() {
+  static HardwareProfile *instance = []() {
+    auto profile = new HardwareProfile();
+    const char *file_name = std::getenv(kProfileEnv);
+    if (file_name != nullptr && *file_name != '\0') {
+      static_cast<void>(profile->load(file_name));
+    }
+    return profile;
+  }();
+  return instance;
+}
+
+bool HardwareProfile::load(const string &file_name) {
+  std::ifstream is(file_name);
+  if (!is.good()) {
+    LOG(WARNING) << "cannot read hardware profile " << file_name;
+    return false;
+  }
+  std::stringstream ss;
+  ss << is.rdbuf();
+  if (!loadFromString(ss.str())) {
+    LOG(WARNING) << "hardware profile " << file_name << " is not loaded";
+    return false;
+  }
+  LOG(INFO) << "hardware profile " << getName() << " loaded from " << file_name;
+  return true;
+}
+
+bool HardwareProfile::loadFromString(const string &text) {
+  picojson::value root;
+  string err = picojson::parse(root, text);
+  if (!err.empty() || !root.is<picojson::object>()) {
+    LOG(WARNING) << "hardware profile is not a json object " << err;
+    return false;
+  }
+  const auto &obj = root.get<picojson::object>();
+  int64_t version = 0;
+  if (!GetInt(obj, "version", &version) || version < 1 || version > kVersion) {
+    LOG(WARNING) << "hardware profile version " << version << " is not supported, expect 1 to " << kVersion;
+    return false;
+  }
+
+  // fill a copy, a broken file leaves the profile as it was
+  std::lock_guard<std::mutex> lock(ProfileMutex());
+  HardwareProfile res = *this;
+  auto name = obj.find("name");
+  if (name != obj.end() && name->second.is<string>()) {
+    res.name_ = name->second.get<string>();
+  }
+  static_cast<void>(GetInt(obj, "core_num", &res.core_num_));
+  static_cast<void>(GetInt(obj, "vector_bytes", &res.vector_bytes_));
+  static_cast<void>(GetInt(obj, "core_granularity", &res.core_granularity_));
+  if (const auto memory = GetObject(obj, "memory")) {
+    for (const auto &it : *memory) {
+      const auto entry = GetObject(*memory, it.first);
+      if (entry == nullptr) continue;
+      int64_t size = res.memory_.count(it.first) ? res.memory_[it.first] : -1;
+      static_cast<void>(GetInt(*entry, "size", &size));
+      res.memory_[it.first] = size;
+    }
+  }
+  if (const auto pipes = GetObject(obj, "pipes")) {
+    for (const auto &it : *pipes) {
+      const auto entry = GetObject(*pipes, it.first);
+      if (entry != nullptr) {
+        static_cast<void>(GetInt(*entry, "latency", &res.pipes_[it.first]));
+      }
+    }
+  }
+  if (const auto intrinsics = GetObject(obj, "intrinsics")) {
+    for (const auto &it : *intrinsics) {
+      const auto dtypes = GetObject(*intrinsics, it.first);
+      if (dtypes == nullptr) continue;
+      for (const auto &dt : *dtypes) {
+        const auto entry = GetObject(*dtypes, dt.first);
+        if (entry == nullptr) continue;
+        // a partial entry refines the cost the intrinsic has so far
+        IntrinCost cost = res.intrinCost(it.first, dt.first);
+        static_cast<void>(GetInt(*entry, "latency", &cost.latency));
+        static_cast<void>(GetInt(*entry, "cycles_per_repeat", &cost.cycles_per_repeat));
+        res.intrinsics_[it.first][dt.first] = cost;
+      }
+    }
+  }
+  if (const auto dma = GetObject(obj, "dma")) {
+    for (const auto &it : *dma) {
+      const auto entry = GetObject(*dma, it.first);
+      if (entry == nullptr) continue;
+      DmaCost cost = res.dmaCost(it.first);
+      static_cast<void>(GetInt(*entry, "startup", &cost.startup));
+      static_cast<void>(GetInt(*entry, "burst_cycles", &cost.burst_cycles));
+      static_cast<void>(GetInt(*entry, "bytes_per_cycle", &cost.bytes_per_cycle));
+      if (cost.bytes_per_cycle <= 0) {
+        LOG(WARNING) << "hardware profile: bytes_per_cycle of dma " << it.first << " must be positive";
+        return false;
+      }
+      res.dma_[it.first] = cost;
+    }
+  }
+  *this = res;
+  return true;
+}
+
+string HardwareProfile::toJson() const {
+  std::lock_guard<std::mutex> lock(ProfileMutex());
+  picojson::object obj;
+  obj["version"] = Int(kVersion);
+  obj["name"] = picojson::value(name_);
+  // values taken from the product section are dumped as -1, loading the dump back leaves them unset
+  obj["core_num"] = Int(core_num_ > 0 ? core_num_ : -1);
+  obj["vector_bytes"] = Int(vector_bytes_);
+  obj["core_granularity"] = Int(core_granularity_);
+  picojson::object memory;
+  for (const auto &it : memory_) {
+    picojson::object entry;
+    entry["size"] = Int(it.second);
+    memory[it.first] = picojson::value(entry);
+  }
+  obj["memory"] = picojson::value(memory);
+  picojson::object pipes;
+  for (const auto &it : pipes_) {
+    picojson::object entry;
+    entry["latency"] = Int(it.second);
+    pipes[it.first] = picojson::value(entry);
+  }
+  obj["pipes"] = picojson::value(pipes);
+  picojson::object intrinsics;
+  for (const auto &it : intrinsics_) {
+    picojson::object dtypes;
+    for (const auto &dt : it.second) {
+      picojson::object entry;
+      entry["latency"] = Int(dt.second.latency);
+      entry["cycles_per_repeat"] = Int(dt.second.cycles_per_repeat);
+      dtypes[dt.first] = picojson::value(entry);
+    }
+    intrinsics[it.first] = picojson::value(dtypes);
+  }
+  obj["intrinsics"] = picojson::value(intrinsics);
+  picojson::object dma;
+  for (const auto &it : dma_) {
+    picojson::object entry;
+    entry["startup"] = Int(it.second.startup);
+    entry["burst_cycles"] = Int(it.second.burst_cycles);
+    entry["bytes_per_cycle"] = Int(it.second.bytes_per_cycle);
+    dma[it.first] = picojson::value(entry);
+  }
+  obj["dma"] = picojson::value(dma);
+  return picojson::value(obj).serialize(true);
+}
+
+string HardwareProfile::getName() const {
+  std::lock_guard<std::mutex> lock(ProfileMutex());
+  return name_;
+}
+
+int64_t HardwareProfile::getMemorySize(const string &scope) const {
+  std::lock_guard<std::mutex> lock(ProfileMutex());
+  return memorySize(scope);
+}
+
+int HardwareProfile::getCoreNum() const {
+  std::lock_guard<std::mutex> lock(ProfileMutex());
+  return coreNum();
+}
+
+int64_t HardwareProfile::getVectorBytes() const {
+  std::lock_guard<std::mutex> lock(ProfileMutex());
+  return vector_bytes_;
+}
+
+int64_t HardwareProfile::getCoreGranularity() const {
+  std::lock_guard<std::mutex> lock(ProfileMutex());
+  return core_granularity_;
+}
+
+int64_t HardwareProfile::getPipeLatency(const string &pipe) const {
+  std::lock_guard<std::mutex> lock(ProfileMutex());
+  auto it = pipes_.find(pipe);
+  if (it != pipes_.end()) {
+    return it->second;
+  }
+  it = pipes_.find("pipe_s");
+  return it != pipes_.end() ? it->second : 1;
+}
+
+IntrinCost HardwareProfile::getIntrinCost(const string &intrin, const string &dtype) const {
+  std::lock_guard<std::mutex> lock(ProfileMutex());
+  return intrinCost(intrin, dtype);
+}
+
+DmaCost HardwareProfile::getDmaCost(const string &path) const {
+  std::lock_guard<std::mutex> lock(ProfileMutex());
+  return dmaCost(path);
+}
+
+int64_t HardwareProfile::memorySize(const string &scope) const {
+  auto it = memory_.find(scope);
+  if (it != memory_.end() && it->second >= 0) {
+    return it->second;
+  }
+  auto buffer = kScopeBuffers.find(scope);
+  if (buffer == kScopeBuffers.end()) {
+    return 0;
+  }
+  return CceConf::getInstance()->getBufferValue(buffer->second);
+}
+
+int HardwareProfile::coreNum() const {
+  return core_num_ > 0 ? core_num_ : CceConf::getInstance()->getCoreValue("Core_num");
+}
+
+IntrinCost HardwareProfile::intrinCost(const string &intrin, const string &dtype) const {
+  // vconv_f162f32 falls back to vconv
+  for (const auto &name : {intrin, intrin.substr(0, intrin.find('_')), string(kDefaultEntry)}) {
+    auto it = intrinsics_.find(name);
+    if (it == intrinsics_.end()) continue;
+    for (const auto &dt : {dtype, string(kDefaultEntry)}) {
+      auto cost = it->second.find(dt);
+      if (cost != it->second.end()) {
+        return cost->second;
+      }
+    }
+  }
+  return IntrinCost{1, 1};
+}
+
+DmaCost HardwareProfile::dmaCost(const string &path) const {
+  auto it = dma_.find(path);
+  if (it != dma_.end()) {
+    return it->second;
+  }
+  bool is_global = path.find("gm") != string::npos || path.find("out") != string::npos || path == kGlobalDma;
+  it = dma_.find(is_global ? kGlobalDma : kLocalDma);
+  CHECK(it != dma_.end());
+  return it->second;
+}
+
+TVM_REGISTER_API("cce.load_hardware_profile").set_body([](const TVMArgs args, TVMRetValue *rv) {
+  const string file_name = args[0];
+  *rv = HardwareProfile::getInstance()->load(file_name);
+});
+
+TVM_REGISTER_API("cce.hardware_profile").set_body([](const TVMArgs args, TVMRetValue *rv) {
+  *rv = HardwareProfile::getInstance()->toJson();
+});
+
+TVM_REGISTER_API("cce.hardware_profile_memory_size").set_body([](const TVMArgs args, TVMRetValue *rv) {
+  const string scope = args[0];
+  *rv = HardwareProfile::getInstance()->getMemorySize(scope);
+});
+}  // namespace cceconf
+}  // namespace akg
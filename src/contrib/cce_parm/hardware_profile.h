@@ -0,0 +1,136 @@
+/**
+ * Copyright 2026 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CONTRIB_CCE_PARM_HARDWARE_PROFILE_H_
+#define CONTRIB_CCE_PARM_HARDWARE_PROFILE_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace akg {
+namespace cceconf {
+/* !
+ * cycles until the result of an intrinsic is ready, and the cycles of each repeat
+ */
+struct IntrinCost {
+  int64_t latency;
+  int64_t cycles_per_repeat;
+};
+
+/* !
+ * cost of a dma path: cycles to start, cycles of each burst, bytes moved per cycle
+ */
+struct DmaCost {
+  int64_t startup;
+  int64_t burst_cycles;
+  int64_t bytes_per_cycle;
+};
+
+/* !
+ * The hardware profile shared by the cost models: memory sizes, core count, latencies of the pipes, latency and
+ * throughput of the intrinsics by dtype, and bandwidth of the dma paths. The memory sizes back the tvm.info.mem
+ * entries that tiling and storage rewrite read, the core count bounds the multicore split.
+ *
+ * The built-in profile describes the current products, a versioned json file can override any part of it, so
+ * a new chip variant needs no code change. The file named by AKG_HARDWARE_PROFILE is loaded on first use;
+ * cce.hardware_profile dumps the profile in the same format, with -1 for the memory sizes and core count that
+ * still come from the product section. Loads and reads take a lock, so cce.load_hardware_profile may run while
+ * passes read the profile.
+ */
+class HardwareProfile {
+ public:
+  static constexpr int kVersion = 1;
+
+  HardwareProfile();
+  ~HardwareProfile() = default;
+
+  /* !
+   * get the HardwareProfile single instance
+   */
+  static HardwareProfile *getInstance();
+
+  /* !
+   * load a json profile, the values the file does not set are kept; false if the file is not valid
+   */
+  bool load(const std::string &file_name);
+
+  /* !
+   * load a json profile from its text
+   */
+  bool loadFromString(const std::string &text);
+
+  /* !
+   * the profile in the json format of load, loading it back gives the same profile
+   */
+  std::string toJson() const;
+
+  std::string getName() const;
+
+  /* !
+   * size in bytes of a storage scope, e.g. local.UB
+   */
+  int64_t getMemorySize(const std::string &scope) const;
+
+  int getCoreNum() const;
+
+  /* !
+   * bytes of one full vector repeat
+   */
+  int64_t getVectorBytes() const;
+
+  /* !
+   * smallest amount of work in elements worth a core of its own
+   */
+  int64_t getCoreGranularity() const;
+
+  /* !
+   * cycles from issue to completion of one instruction on the pipe, e.g. pipe_v
+   */
+  int64_t getPipeLatency(const std::string &pipe) const;
+
+  /* !
+   * cost of an intrinsic by name and dtype, e.g. (vadd, float16), falling back to the intrinsic family and the
+   * default entry "*"
+   */
+  IntrinCost getIntrinCost(const std::string &intrin, const std::string &dtype) const;
+
+  /* !
+   * cost of a dma path, e.g. gm_to_ubuf, falling back to the global or local default
+   */
+  DmaCost getDmaCost(const std::string &path) const;
+
+ private:
+  // the getters without the lock
+  int64_t memorySize(const std::string &scope) const;
+  int coreNum() const;
+  IntrinCost intrinCost(const std::string &intrin, const std::string &dtype) const;
+  DmaCost dmaCost(const std::string &path) const;
+
+  std::string name_;
+  int core_num_;
+  int64_t vector_bytes_;
+  int64_t core_granularity_;
+  // size in bytes of each on-chip buffer, -1 takes the size of the product section from CceConf
+  std::map<std::string, int64_t> memory_;
+  std::map<std::string, int64_t> pipes_;
+  std::map<std::string, std::map<std::string, IntrinCost>> intrinsics_;
+  std::map<std::string, DmaCost> dma_;
+};
+}  // namespace cceconf
+}  // namespace akg
+
+#endif  // CONTRIB_CCE_PARM_HARDWARE_PROFILE_H_
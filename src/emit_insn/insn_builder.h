@@ -82,6 +82,10 @@ class CommentManager {
     }
   }
 
+  std::map<std::string, std::string> GetComments() const { return comments_; }
+
+  void SetComments(const std::map<std::string, std::string> &comments) { comments_ = comments; }
+
  private:
   CommentManager()
       : comment_list_level1_({"Bisect_optimize", "Overlap_optimize", "Atomic_add"}),
@@ -89,7 +93,7 @@ class CommentManager {
                               "Bisect_optimize", "Overlap_optimize", "Atomic_add"}),
         comment_list_level3_({"Insn_name", "Insn_type", "Compute_type", "Pattern", "Vadds_replace_copy",
                               "Bisect_optimize", "Overlap_optimize", "Atomic_add", "Mask_rate", "Alignment",
-                              "Contain_tail"}) {}
+                              "Contain_tail", "Insn_cost"}) {}
   ~CommentManager() = default;
 
  private:
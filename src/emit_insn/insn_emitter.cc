@@ -18,6 +18,7 @@
 
 #include <tvm/ir_mutator.h>
 #include <tvm/ir_pass.h>
+#include <tvm/ir_visitor.h>
 #include <tvm/packed_func_ext.h>
 #include <tvm/runtime/registry.h>
 
@@ -26,8 +27,11 @@
 #include <numeric>
 #include <set>
 #include <algorithm>
+#include <functional>
 
 #include "pass/ir_util.h"
+#include "pass/common.h"
+#include "contrib/cce_parm/hardware_profile.h"
 #include "ir_pass.h"
 #include "common/array_api.h"
 #include "cce_params.h"
@@ -48,18 +52,126 @@ std::vector<size_t> SortIndexes(const std::vector<int> &v) {
   return idx;
 }
 
-/// Function for emit single vector intrin
-/// \param op                - The input stmt to be emitted as intrin
-/// \param intrin_name        - The CCE intrin name
-/// \param broadcast_last_axis - Tag of broadcast_last_axis mode
+/// Instruction cost table to compare the sequences of different pattern generators.
+/// Vector instructions cost their latency and the cycles of each repeat in the hardware profile, repeats over
+/// strided blocks cost twice, every set_vector_mask and every copy between local buffers costs its latency.
+/// Costs are weighted by the constant extents of the enclosing loops.
+class InsnCostTable : public IRVisitor {
+ public:
+  InsnCostTable() = default;
+  ~InsnCostTable() override = default;
+
+  int64_t Cost(const Stmt &stmt) {
+    Visit(stmt);
+    return cost_;
+  }
+
+  void Visit_(const For *op) final {
+    int64_t outer = trips_;
+    const auto extent = op->extent.as<IntImm>();
+    trips_ *= (extent != nullptr && extent->value > 0) ? extent->value : 1;
+    Visit(op->body);
+    trips_ = outer;
+  }
+
+  void Visit_(const Call *op) final {
+    if (op->is_intrinsic(air::ir::intrinsic::tvm_access_ptr)) {
+      return;
+    }
+    if (op->name == "set_vector_mask") {
+      cost_ += trips_ * profile_->getIntrinCost(op->name, "").latency;
+    } else if (op->call_type == Call::Extern && GetIntrinPipe(op->name) == PIPE_V) {
+      const auto repeat = GetVectorRepeat(op).as<IntImm>();
+      int64_t repeats = repeat != nullptr ? repeat->value : 1;
+      cceconf::IntrinCost cost = profile_->getIntrinCost(op->name, GetIntrinDType(op));
+      int64_t repeat_cost = cost.cycles_per_repeat * (HasBlockStride(op) ? kStridedRepeatFactor : 1);
+      cost_ += trips_ * (cost.latency + repeats * repeat_cost);
+    } else if (op->call_type == Call::Extern && op->name.find("copy_") == 0) {
+      // the candidates only copy between local buffers, so every copy costs the local startup
+      cost_ += trips_ * profile_->getDmaCost("local").startup;
+    }
+    IRVisitor::Visit_(op);
+  }
+
+ private:
+  // block strides follow the repeat, one for each buffer of the instruction
+  static bool HasBlockStride(const Call *op) {
+    int repeat_idx = GetVectorRepeatIndex(op);
+    if (repeat_idx < 0) {
+      return false;
+    }
+    size_t num_buffer = 0;
+    while (num_buffer < op->args.size()) {
+      const auto ptr = op->args[num_buffer].as<Call>();
+      if (ptr == nullptr || !ptr->is_intrinsic(air::ir::intrinsic::tvm_access_ptr)) break;
+      ++num_buffer;
+    }
+    size_t idx = static_cast<size_t>(repeat_idx);
+    for (size_t i = idx + 1; i <= idx + num_buffer && i < op->args.size(); ++i) {
+      const auto stride = op->args[i].as<IntImm>();
+      if (stride == nullptr || stride->value != 1) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static constexpr int64_t kStridedRepeatFactor = 2;
+
+  const cceconf::HardwareProfile *profile_{cceconf::HardwareProfile::getInstance()};
+  int64_t trips_{1};
+  int64_t cost_{0};
+};
+
+struct InsnCandidate {
+  std::string name;
+  std::function<Stmt()> emit;
+};
+
+/// Emit all candidates and keep the cheapest one, ties keep the earlier candidate
+/// \param candidates    - Candidate instruction sequences, the default choice first
+/// \param base_comments - Comments before any candidate was emitted
+/// \return Stmt of the cheapest candidate
+Stmt EmitCheapestCandidate(const std::vector<InsnCandidate> &candidates,
+                           const std::map<std::string, std::string> &base_comments) {
+  CHECK(!candidates.empty());
+  auto &manager = CommentManager::GetInstance();
+  std::map<std::string, std::string> best_comments;
+  Stmt best;
+  int64_t best_cost = 0;
+  std::string best_name;
+  std::string report;
+  for (const auto &candidate : candidates) {
+    // each generator leaves its own pattern comments
+    manager.SetComments(base_comments);
+    Stmt stmt = candidate.emit();
+    int64_t cost = InsnCostTable().Cost(stmt);
+    report += candidate.name + "[" + std::to_string(cost) + "] ";
+    if (!best.defined() || cost < best_cost) {
+      best = stmt;
+      best_cost = cost;
+      best_name = candidate.name;
+      best_comments = manager.GetComments();
+    }
+  }
+  manager.SetComments(best_comments);
+  if (candidates.size() > 1) {
+    manager.AddComment("Insn_cost", report + "-> " + best_name);
+  }
+  return best;
+}
+
+/// Function for emit single vector intrin with one pattern
+/// \param op          - The input stmt to be emitted as intrin
+/// \param intrin_name - The CCE intrin name
+/// \param pattern     - Pattern to emit, nullptr for the one with the best mask rate
+/// \param candidates  - Patterns that fit the computation, the emitted one first, may be nullptr
 /// \return Stmt of emitted CCE intrin
-Stmt SingleVecEmitter(const Stmt &op, std::string intrin_name) {
+Stmt SingleVecPatternEmitter(const Stmt &op, const std::string &intrin_name, const PatternType *pattern,
+                             std::vector<PatternType> *candidates) {
   CHECK(op);
   Stmt result;
 
-  CommentManager::GetInstance().AddComment("Insn_type", "single_vector");
-  CommentManager::GetInstance().AddComment("Insn_name", intrin_name);
-
   StmtInfoList dst_info_list;
   StmtInfoList src_info_list;
   StmtInfo for_info;
@@ -96,11 +208,23 @@ Stmt SingleVecEmitter(const Stmt &op, std::string intrin_name) {
 
   // check is single vector broadcast reduce mode exist
   SingleVecPatternGenerator generator = SingleVecPatternGenerator(dst_info_list, src_info_list, for_info);
+  if (pattern != nullptr) {
+    generator.SetPattern(*pattern);
+  }
   auto params = generator.GetInsnArgs();
   dst_info_list = params.dst_info_list;
   src_info_list = params.src_info_list;
   for_info = params.for_info;
   ArgInfo arg_info = params.arg_info;
+  if (candidates != nullptr) {
+    auto patterns = generator.GetCandidatePatterns();
+    auto it = std::find(patterns.begin(), patterns.end(), arg_info->pattern_);
+    if (it != patterns.end()) {
+      // the mask rate choice goes first so that it wins ties
+      std::rotate(patterns.begin(), it, it + 1);
+      *candidates = patterns;
+    }
+  }
 
   CommentManager::GetInstance().AddComment("Compute_type", intrin_name);
   CommentManager::GetInstance().AddComment("Pattern", arg_info.GetPattern());
@@ -117,14 +241,53 @@ Stmt SingleVecEmitter(const Stmt &op, std::string intrin_name) {
   return ret;
 }
 
-/// Function to emit binary vector intrin
+/// Function for emit single vector intrin, the candidate patterns are compared with the instruction cost table
+/// \param op          - The input stmt to be emitted as intrin
+/// \param intrin_name - The CCE intrin name
+/// \return Stmt of emitted CCE intrin
+Stmt SingleVecEmitter(const Stmt &op, std::string intrin_name) {
+  CHECK(op);
+  CommentManager::GetInstance().AddComment("Insn_type", "single_vector");
+  CommentManager::GetInstance().AddComment("Insn_name", intrin_name);
+
+  auto &manager = CommentManager::GetInstance();
+  const auto base_comments = manager.GetComments();
+  std::vector<PatternType> patterns;
+  Stmt result = SingleVecPatternEmitter(op, intrin_name, nullptr, &patterns);
+  if (patterns.size() < 2) {
+    return result;
+  }
+  const auto comments = manager.GetComments();
+  std::vector<InsnCandidate> candidates;
+  for (auto pattern : patterns) {
+    ArgInfo arg_info = ArgInfo(make_node<ArgInfoNode>());
+    arg_info.GetNode()->pattern_ = pattern;
+    if (candidates.empty()) {
+      // the one already emitted
+      candidates.push_back({arg_info.GetPattern(), [&manager, &comments, &result]() {
+                              manager.SetComments(comments);
+                              return result;
+                            }});
+      continue;
+    }
+    candidates.push_back({arg_info.GetPattern(), [&op, &intrin_name, pattern]() {
+                            return SingleVecPatternEmitter(op, intrin_name, &pattern, nullptr);
+                          }});
+  }
+  return EmitCheapestCandidate(candidates, base_comments);
+}
+
+/// Function to emit binary vector intrin with the pattern of the computation mode
 /// \param op           - The input stmt to be emitted as intrin
 /// \param intrin_name   - The CCE insn name
 /// \param enable_bisect - Tag of enable bisect-reduction mode
 /// \param postfix      - postfix
+/// \param bisect       - Set when the bisection reduction is emitted
 /// \return Stmt of emitted CCE intrin
-Stmt BinaryVecEmitter(const Stmt &op, std::string intrin_name, bool enable_bisect = true, int postfix = 0) {
+Stmt BinaryVecPatternEmitter(const Stmt &op, std::string intrin_name, bool enable_bisect, int postfix, bool *bisect) {
   CHECK(op);
+  CHECK(bisect);
+  *bisect = false;
   StmtInfoList dst_info_list;
   StmtInfoList src_info_list;
   StmtInfo for_info;
@@ -144,6 +307,7 @@ Stmt BinaryVecEmitter(const Stmt &op, std::string intrin_name, bool enable_bisec
       const int vec_max_len = GetVecMaxLen(dst_info->dtype_);
       if (enable_bisect && GetIntConst(GetItem(src_info->shape_, -1)) > vec_max_len) {
         CommentManager::GetInstance().AddComment("Bisect_optimize", "enabled");
+        *bisect = true;
         auto wrapper =
           SeparateComInfoToBisectionInfoList(dst_info_list, src_info_list, for_info, if_info, true, postfix);
         return EmitCceBinaryVectorToBisectionReduction(wrapper, if_info, intrin_name);
@@ -162,6 +326,7 @@ Stmt BinaryVecEmitter(const Stmt &op, std::string intrin_name, bool enable_bisec
     case ARG_VECTOR_REDUCTION_BISECTION: {
       CommentManager::GetInstance().AddComment("Compute_type", "reduction");
       CommentManager::GetInstance().AddComment("Bisect_optimize", "enabled");
+      *bisect = true;
       auto wrapper =
         SeparateComInfoToBisectionInfoList(dst_info_list, src_info_list, for_info, if_info, false, postfix);
       return EmitCceBinaryVectorToBisectionReduction(wrapper, if_info, intrin_name);
@@ -194,6 +359,34 @@ Stmt BinaryVecEmitter(const Stmt &op, std::string intrin_name, bool enable_bisec
   }
 }
 
+/// Function to emit binary vector intrin, a bisection reduction is compared with the direct vector reduction
+/// under the instruction cost table
+/// \param op           - The input stmt to be emitted as intrin
+/// \param intrin_name   - The CCE insn name
+/// \param enable_bisect - Tag of enable bisect-reduction mode
+/// \param postfix      - postfix
+/// \return Stmt of emitted CCE intrin
+Stmt BinaryVecEmitter(const Stmt &op, std::string intrin_name, bool enable_bisect = true, int postfix = 0) {
+  auto &manager = CommentManager::GetInstance();
+  const auto base_comments = manager.GetComments();
+  bool bisect = false;
+  Stmt result = BinaryVecPatternEmitter(op, intrin_name, enable_bisect, postfix, &bisect);
+  if (!bisect) {
+    return result;
+  }
+  const auto comments = manager.GetComments();
+  std::vector<InsnCandidate> candidates = {{"bisection",
+                                            [&manager, &comments, &result]() {
+                                              manager.SetComments(comments);
+                                              return result;
+                                            }},
+                                           {"vector_reduction", [&op, &intrin_name, postfix]() {
+                                              bool unused = false;
+                                              return BinaryVecPatternEmitter(op, intrin_name, false, postfix, &unused);
+                                            }}};
+  return EmitCheapestCandidate(candidates, base_comments);
+}
+
 /// Function to emit scalar intrin
 /// \param op         - The input stmt to be emitted as intrin
 /// \param intrin_name - The CCE insn name
@@ -18,6 +18,7 @@
 #define EMIT_INSN_INSN_PATTERN_H_
 
 #include <string>
+#include <vector>
 
 #include "common/array_api.h"
 #include "tvm.h"
@@ -92,6 +93,13 @@ class SingleVecPatternGenerator : public PatternGenerator {
   }
   ~SingleVecPatternGenerator() override = default;
   PatternResult GetInsnArgs() final;
+  /// Patterns of the mask rate choice that fit the computation, filled by GetInsnArgs
+  std::vector<PatternType> GetCandidatePatterns() const { return candidates; }
+  /// Let GetInsnArgs emit one of the candidate patterns instead of the one with the best mask rate
+  void SetPattern(PatternType pattern) {
+    forced_pattern = pattern;
+    has_forced_pattern = true;
+  }
 
  protected:
   float Compute3DPatternMaskRate() final;
@@ -141,6 +149,9 @@ class SingleVecPatternGenerator : public PatternGenerator {
   VectorArgInfo tail_args;
   std::string mode;
   Type data_type;
+  std::vector<PatternType> candidates;
+  PatternType forced_pattern{PATTERN_1D};
+  bool has_forced_pattern{false};
 };
 
 class BinaryVecPatternGenerator : public PatternGenerator {
@@ -16,8 +16,10 @@
 #include <tvm/base.h>
 #include <tvm/ir_pass.h>
 
+#include <algorithm>
 #include <cmath>
 #include <set>
+#include <utility>
 
 #include "insn_builder.h"
 #include "insn_pattern.h"
@@ -89,6 +91,15 @@ PatternResult SingleVecPatternGenerator::GetInsnArgs() {
   float rate1d = Compute1DPatternMaskRate();
   float rate3ds = Compute3DsPatternMaskRate();
   float rate2ds = Compute2DRepeatPatternMaskRate();
+  candidates.clear();
+  if (mode != "broadcast_last_axis" && rate2ds <= 0 && rate3ds <= 0) {
+    for (auto item : {std::make_pair(PATTERN_3D, rate3d), std::make_pair(PATTERN_PARTIAL_3D, rate2db),
+                      std::make_pair(PATTERN_2D, rate2d), std::make_pair(PATTERN_1D, rate1d)}) {
+      if (item.second > 0) {
+        candidates.push_back(item.first);
+      }
+    }
+  }
   if (mode == "broadcast_last_axis") {
     elim_var = Get1DPattern();
   } else if (rate2ds > 0) {
@@ -96,6 +107,24 @@ PatternResult SingleVecPatternGenerator::GetInsnArgs() {
   } else if (rate3ds > 0) {
     elim_var = Get3DsPattern();
     arg_info.GetNode()->pattern_ = PATTERN_2D;
+  } else if (has_forced_pattern) {
+    CHECK(std::find(candidates.begin(), candidates.end(), forced_pattern) != candidates.end())
+      << "Error: pattern " << forced_pattern << " does not fit the Single-Vector-Insn";
+    switch (forced_pattern) {
+      case PATTERN_3D:
+        elim_var = Get3DPattern();
+        break;
+      case PATTERN_PARTIAL_3D:
+        elim_var = Get2DBlockPattern();
+        break;
+      case PATTERN_2D:
+        elim_var = Get2DPattern();
+        break;
+      default:
+        elim_var = Get1DPattern();
+        break;
+    }
+    arg_info.GetNode()->pattern_ = forced_pattern;
   } else if (rate3d >= rate2db && rate3d > 0) {
     elim_var = Get3DPattern();
     arg_info.GetNode()->pattern_ = PATTERN_3D;
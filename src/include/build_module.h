@@ -63,6 +63,16 @@ BuildRst BuildToFunc(const Schedule &inputs, const Array<NodeRef> &in_args, cons
 
 air::runtime::Module BuildToModule(const NodeRef &ref, const std::string &target_name = "cce");
 
+/*
+ * Build the generic dynamic-shape kernel together with bucket specializations into one module. buckets[i] maps
+ * shape var names to the upper bounds spec_refs[i] was compiled for. The entry `name` calls the smallest bucket
+ * that covers the scalar shape arguments, and the generic kernel when no bucket does.
+ */
+air::runtime::Module BuildToModuleWithDispatch(const std::string &name, const NodeRef &generic_ref,
+                                               const Array<NodeRef> &spec_refs,
+                                               const Array<Map<std::string, Expr>> &buckets,
+                                               const std::string &target_name = "cce");
+
 class BuildRstNode : public Node {
  public:
   NodeRef rst;
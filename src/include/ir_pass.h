@@ -51,6 +51,39 @@ Expr SimplifyCombiner(const Expr &expr, bool prune_unused_components = true);
  */
 Stmt InjectSync(Stmt stmt);
 
+/*!
+ * \brief Reorder coproc instructions across pipes to hide the latency of their dependences.
+ *
+ * \param stmt The stmt to be transformed
+ * \return Transformed stmt.
+ */
+Stmt PipeListSchedule(Stmt stmt);
+
+/*!
+ * \brief Estimate the cycles of lowered CCE IR without running it.
+ *
+ *  Intrinsics are weighted by the trip counts of their loops, which stay symbolic for dynamic shapes.
+ *
+ * \param stmt The stmt to be estimated, after InjectSync
+ * \return Cycles of each pipe ("pipe_s" ... "pipe_mte3") of one block, their maximum "block_bound" and sum
+ *  "block_serial", the vector cycles at full mask "pipe_v_effective", the number of syncs "sync", "block_num" and
+ *  the multicore total "total".
+ */
+Map<std::string, Expr> EstimatePerformance(const Stmt &stmt);
+
+/*!
+ * \brief Fixed-length feature vector of a kernel for learned cost models.
+ *
+ * \param stmt The stmt after poly or after EmitInsn
+ * \return FloatImm features in the order of FeatureNames.
+ */
+Array<Expr> ExtractFeatures(const Stmt &stmt);
+
+/*!
+ * \brief Names of the features returned by ExtractFeatures.
+ */
+Array<Expr> FeatureNames();
+
 /*!
  * \brief emit insn for D.
  *
@@ -148,7 +181,7 @@ Stmt StorageRewriteBC(Stmt stmt, const std::string &maxsat_filename, bool no_lim
  * \return Transformed stmt.
  */
 Stmt InjectMultiCore(Stmt stmt, int max_block_dim, int merge_outer_loop = 1, bool is_dynamic = false,
-                     bool scalar_rearrange = false);
+                     bool scalar_rearrange = false, bool balance = false);
 
 Array<NodeRef> InjectMultiCoreVar(Stmt stmt, const Var &block_dim, int merge_outer_loop = 1);
 
@@ -190,9 +223,20 @@ Stmt MathIntrinRewrite(Stmt stmt);
  */
 Stmt SinkIfStmt(const Stmt &stmt);
 
+/*!
+ * \brief Polyhedral scheduling and tiling.
+ * \return {transformed stmt, tiling params, host tiling}, where host tiling is {Array<Var>, Array<Expr>} of the
+ *         tile factors left to the host when attrs["enable_host_tiling"] is set.
+ */
 Array<NodeRef> AutoPoly(const Stmt &body, const Map<Tensor, Buffer> &extern_buffer,
                         const Map<std::string, NodeRef> &attrs, const bool is_specgemm, const bool is_dynamic);
 
+/*!
+ * \brief Drop the tiling analysis AutoPoly keeps on this thread for a retry of the same kernel.
+ *  Called when the retries of a kernel are over, whether it compiled or not.
+ */
+void ClearTilingRetryCache();
+
 /*!
  * \brief Promote IF stmt as possible.
  * \param stmt The stmt to be transformed.
@@ -235,6 +279,14 @@ Stmt InvariantHoist(Stmt stmt);
 
 Stmt ElimDMA(Stmt stmt);
 
+/*!
+ * \brief Fold loops of single-burst dma into multi-burst dma, and merge dma that continue each other.
+ *
+ * \param stmt The stmt after EmitInsn
+ * \return Transformed stmt.
+ */
+Stmt CoalesceDma(Stmt stmt);
+
 Stmt InjectAttr(Stmt stmt);
 
 Stmt UnifyLoopVars(const Stmt &stmt, const Map<Tensor, Buffer> &extern_buffer, const Array<NodeRef> &arg_list);
@@ -291,7 +343,7 @@ Stmt LowerWith(Stmt stmt);
 
 Stmt ModDivEliminate(Stmt stmt);
 
-Stmt AutoDoubleBuffer(Stmt stmt);
+Stmt AutoDoubleBuffer(Stmt stmt, bool software_pipeline = false);
 
 Stmt ConvertExtentToCond(Stmt stmt, const Map<Tensor, Buffer> &extern_buffer);
 
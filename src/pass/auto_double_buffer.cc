@@ -19,6 +19,7 @@
 #include <tvm/ir_visitor.h>
 #include <tvm/ir_mutator.h>
 
+#include "pass/common.h"
 #include "pass/ir_util.h"
 #include "ir_pass.h"
 
@@ -41,6 +42,19 @@ namespace ir {
  *     gm_to_ubuf(A, gm[i.db*2+1])
  *     calc(A)
  *   }
+ * 2. software pipeline(enable_software_pipeline), when the body is loads, compute and stores:
+ *   A = alloc(100)
+ *   A' = alloc(100)
+ *   gm_to_ubuf(A, gm[0])
+ *   for (i.db, 0, n/2 - 1) {
+ *     gm_to_ubuf(A', gm[i.db*2+1])
+ *     calc(A)
+ *     ubuf_to_gm(out[i.db*2], A)
+ *     gm_to_ubuf(A, gm[i.db*2+2])
+ *     calc(A')
+ *     ubuf_to_gm(out[i.db*2+1], A')
+ *   }
+ *   epilogue of the last two iterations without the load of i.db*2+2
  */
 class DbFinder : public IRVisitor {
  public:
@@ -74,9 +88,108 @@ class DetectSupportFor : public IRVisitor {
   std::deque<const For *> deq_outer_loops_;
 };
 
+class AllocatedBuffers : public IRVisitor {
+ public:
+  AllocatedBuffers() {}
+  ~AllocatedBuffers() override = default;
+  void Visit_(const Allocate *op) final {
+    buffers_.insert(op->buffer_var.get());
+    IRVisitor::Visit_(op);
+  }
+
+  std::unordered_set<const Variable *> buffers_;
+};
+
+// pipes of the intrinsics and buffers referenced by a statement
+class StageInfo : public IRVisitor {
+ public:
+  StageInfo() {}
+  ~StageInfo() override = default;
+  void Visit_(const Call *op) final {
+    int pipe = GetIntrinPipe(op->name);
+    if (pipe != 0) {
+      pipes_.insert(pipe);
+    }
+    IRVisitor::Visit_(op);
+  }
+  void Visit_(const Variable *op) final {
+    if (op->type.is_handle()) {
+      buffers_.insert(op);
+    }
+  }
+  void Visit_(const Load *op) final {
+    buffers_.insert(op->buffer_var.get());
+    IRVisitor::Visit_(op);
+  }
+  void Visit_(const Store *op) final {
+    buffers_.insert(op->buffer_var.get());
+    IRVisitor::Visit_(op);
+  }
+
+  std::unordered_set<int> pipes_;
+  std::unordered_set<const Variable *> buffers_;
+};
+
+class BufferRenamer : public IRMutator {
+ public:
+  explicit BufferRenamer(const std::unordered_map<const Variable *, Var> &vmap) : vmap_(vmap) {}
+  ~BufferRenamer() override = default;
+
+  Expr Mutate_(const Variable *op, const Expr &e) final {
+    auto it = vmap_.find(op);
+    return it != vmap_.end() ? it->second : e;
+  }
+  Expr Mutate_(const Load *op, const Expr &e) final {
+    Expr expr = IRMutator::Mutate_(op, e);
+    op = expr.as<Load>();
+    CHECK(op);
+    auto it = vmap_.find(op->buffer_var.get());
+    return it != vmap_.end() ? Load::make(op->type, it->second, op->index, op->predicate) : expr;
+  }
+  Stmt Mutate_(const Store *op, const Stmt &s) final {
+    Stmt stmt = IRMutator::Mutate_(op, s);
+    op = stmt.as<Store>();
+    CHECK(op);
+    auto it = vmap_.find(op->buffer_var.get());
+    return it != vmap_.end() ? Store::make(it->second, op->value, op->index, op->predicate) : stmt;
+  }
+  Stmt Mutate_(const Allocate *op, const Stmt &s) final {
+    Stmt stmt = IRMutator::Mutate_(op, s);
+    op = stmt.as<Allocate>();
+    CHECK(op);
+    auto it = vmap_.find(op->buffer_var.get());
+    if (it == vmap_.end()) {
+      return stmt;
+    }
+    return Allocate::make(it->second, op->type, op->extents, op->condition, op->body, op->new_expr,
+                          op->free_function);
+  }
+  Stmt Mutate_(const AttrStmt *op, const Stmt &s) final {
+    Stmt stmt = IRMutator::Mutate_(op, s);
+    op = stmt.as<AttrStmt>();
+    CHECK(op);
+    auto it = vmap_.find(op->node.as<Variable>());
+    return it != vmap_.end() ? AttrStmt::make(it->second, op->attr_key, op->value, op->body) : stmt;
+  }
+
+ private:
+  const std::unordered_map<const Variable *, Var> &vmap_;
+};
+
+/*
+ * Body of a double buffer loop split into pipeline stages: the buffers allocated at its top, leading loads on
+ * MTE2, compute without dma and trailing stores on MTE3.
+ */
+struct PipelineStages {
+  std::vector<Stmt> allocs;
+  std::vector<Stmt> loads;
+  std::vector<Stmt> compute;
+  std::vector<Stmt> stores;
+};
+
 class AutoDoubleBufferInjector : public IRMutator {
  public:
-  AutoDoubleBufferInjector() {}
+  explicit AutoDoubleBufferInjector(bool software_pipeline) : software_pipeline_(software_pipeline) {}
   ~AutoDoubleBufferInjector() override = default;
 
   Stmt Inject(const Stmt &stmt) {
@@ -86,6 +199,11 @@ class AutoDoubleBufferInjector : public IRMutator {
     if (db_loop_.empty()) {
       return stmt;
     }
+    if (software_pipeline_) {
+      AllocatedBuffers allocated;
+      allocated.Visit(stmt);
+      allocated_ = std::move(allocated.buffers_);
+    }
     return Mutate(stmt);
   }
 
@@ -94,6 +212,12 @@ class AutoDoubleBufferInjector : public IRMutator {
       return IRMutator::Mutate_(op, s);
     }
     Stmt body = IRMutator::Mutate(op->body);
+    if (software_pipeline_) {
+      Stmt pipelined = SoftwarePipeline(op, body);
+      if (pipelined.defined()) {
+        return pipelined;
+      }
+    }
     Expr factor = make_const(op->loop_var.type(), db_lane_);
     Var loop_var(op->loop_var->name_hint + ".db", op->loop_var.type());
 
@@ -134,7 +258,173 @@ class AutoDoubleBufferInjector : public IRMutator {
   }
 
  private:
+  enum StageKind { kLoad = 0, kCompute, kStore, kInvalid };
+
+  static StageKind GetStageKind(const StageInfo &info) {
+    bool has_load = info.pipes_.count(PIPE_MTE2) > 0;
+    bool has_store = info.pipes_.count(PIPE_MTE3) > 0;
+    if (!has_load && !has_store) {
+      return kCompute;
+    }
+    if (info.pipes_.size() != 1) {
+      return kInvalid;
+    }
+    return has_load ? kLoad : kStore;
+  }
+
+  static void FlattenSeq(const Stmt &s, std::vector<Stmt> *seq) {
+    if (const auto block = s.as<Block>()) {
+      FlattenSeq(block->first, seq);
+      FlattenSeq(block->rest, seq);
+    } else {
+      seq->emplace_back(s);
+    }
+  }
+
+  /*
+   * Loads of the next iteration are issued before the compute and stores of the current one, so they may only
+   * write buffers allocated in the body, and may not read global memory written by the stores.
+   */
+  bool SplitStages(const For *op, const Stmt &body, PipelineStages *stages) const {
+    std::unordered_set<const Variable *> local;
+    Stmt s = body;
+    while (true) {
+      if (const auto attr = s.as<AttrStmt>()) {
+        if (attr->attr_key != air::ir::attr::storage_scope) break;
+        stages->allocs.emplace_back(s);
+        s = attr->body;
+      } else if (const auto alloc = s.as<Allocate>()) {
+        for (const auto &ext : alloc->extents) {
+          if (air::ir::ExprUseVar(ext, op->loop_var)) return false;
+        }
+        if (air::ir::ExprUseVar(alloc->condition, op->loop_var)) return false;
+        local.insert(alloc->buffer_var.get());
+        stages->allocs.emplace_back(s);
+        s = alloc->body;
+      } else {
+        break;
+      }
+    }
+    if (local.empty()) {
+      return false;
+    }
+    std::vector<Stmt> seq;
+    FlattenSeq(s, &seq);
+    std::unordered_set<const Variable *> load_gm;
+    std::unordered_set<const Variable *> store_gm;
+    int phase = kLoad;
+    for (const auto &stmt : seq) {
+      StageInfo info;
+      info.Visit(stmt);
+      StageKind kind = GetStageKind(info);
+      if (kind == kInvalid || kind < phase) {
+        return false;
+      }
+      phase = kind;
+      for (auto buf : info.buffers_) {
+        bool is_gm = local.count(buf) == 0 && allocated_.count(buf) == 0;
+        if (kind == kLoad && !is_gm && local.count(buf) == 0) return false;
+        if (kind == kCompute && is_gm) return false;
+        if (kind == kLoad && is_gm) load_gm.insert(buf);
+        if (kind == kStore && is_gm) store_gm.insert(buf);
+      }
+      if (kind == kLoad) {
+        stages->loads.emplace_back(stmt);
+      } else if (kind == kCompute) {
+        stages->compute.emplace_back(stmt);
+      } else {
+        stages->stores.emplace_back(stmt);
+      }
+    }
+    for (auto buf : load_gm) {
+      if (store_gm.count(buf) > 0) return false;
+    }
+    return !stages->loads.empty() && !stages->compute.empty();
+  }
+
+  static Stmt WrapAllocs(const std::vector<Stmt> &allocs, Stmt body) {
+    for (auto it = allocs.rbegin(); it != allocs.rend(); ++it) {
+      if (const auto attr = it->as<AttrStmt>()) {
+        body = AttrStmt::make(attr->node, attr->attr_key, attr->value, body);
+      } else {
+        const auto alloc = it->as<Allocate>();
+        CHECK(alloc);
+        body = Allocate::make(alloc->buffer_var, alloc->type, alloc->extents, alloc->condition, body, alloc->new_expr,
+                              alloc->free_function);
+      }
+    }
+    return body;
+  }
+
+  /*
+   * Modulo schedule of a constant loop on the two buffer lanes. Lane 0 runs the even iterations and lane 1 the
+   * odd ones; the load of iteration i+1 is issued before the compute of iteration i, and the load of iteration
+   * i+2 right after its store, so MTE2 overlaps PIPE_V and MTE3 of the other lane. The buffers of both lanes are
+   * hoisted out of the loop. Returns an undefined stmt when the body does not fit.
+   */
+  Stmt SoftwarePipeline(const For *op, const Stmt &body) const {
+    const auto extent = op->extent.as<IntImm>();
+    if (extent == nullptr || extent->value < db_lane_) {
+      return Stmt();
+    }
+    PipelineStages lane0;
+    if (!SplitStages(op, body, &lane0)) {
+      return Stmt();
+    }
+    std::unordered_map<const Variable *, Var> rename;
+    for (const auto &s : lane0.allocs) {
+      if (const auto alloc = s.as<Allocate>()) {
+        rename.emplace(alloc->buffer_var.get(),
+                       Var(alloc->buffer_var->name_hint + "_db", alloc->buffer_var.type()));
+      }
+    }
+    PipelineStages lane1;
+    bool split = SplitStages(op, BufferRenamer(rename).Mutate(body), &lane1);
+    CHECK(split);
+
+    Type t = op->loop_var.type();
+    auto at = [&op](const std::vector<Stmt> &stage, const Expr &iter, std::vector<Stmt> *seq) {
+      if (stage.empty()) return;
+      std::unordered_map<const Variable *, Expr> vmap;
+      vmap[op->loop_var.get()] = iter + op->min;
+      seq->emplace_back(air::ir::Substitute(air::ir::MergeSeq(stage), vmap));
+    };
+    int64_t pairs = extent->value / db_lane_;
+    std::vector<Stmt> seq;
+    at(lane0.loads, make_const(t, 0), &seq);
+    if (pairs > 1) {
+      Var loop_var(op->loop_var->name_hint + ".db", t);
+      Expr iter = loop_var * make_const(t, db_lane_);
+      std::vector<Stmt> steady;
+      at(lane1.loads, iter + make_const(t, 1), &steady);
+      at(lane0.compute, iter, &steady);
+      at(lane0.stores, iter, &steady);
+      at(lane0.loads, iter + make_const(t, db_lane_), &steady);
+      at(lane1.compute, iter + make_const(t, 1), &steady);
+      at(lane1.stores, iter + make_const(t, 1), &steady);
+      auto for_type = pairs - 1 < auto_unroll_bound_ ? ForType::Unrolled : ForType::Serial;
+      seq.emplace_back(For::make(loop_var, make_const(t, 0), make_const(t, pairs - 1), for_type, op->device_api,
+                                 air::ir::MergeSeq(steady)));
+    }
+    int64_t last = (pairs - 1) * db_lane_;
+    at(lane1.loads, make_const(t, last + 1), &seq);
+    at(lane0.compute, make_const(t, last), &seq);
+    at(lane0.stores, make_const(t, last), &seq);
+    at(lane1.compute, make_const(t, last + 1), &seq);
+    at(lane1.stores, make_const(t, last + 1), &seq);
+    Stmt stmt = WrapAllocs(lane0.allocs, WrapAllocs(lane1.allocs, air::ir::MergeSeq(seq)));
+
+    if (extent->value % db_lane_ != 0) {
+      std::unordered_map<const Variable *, Expr> vmap;
+      vmap[op->loop_var.get()] = make_const(t, extent->value - 1) + op->min;
+      stmt = Block::make(stmt, air::ir::Substitute(body, vmap));
+    }
+    return stmt;
+  }
+
   std::unordered_set<const For *> db_loop_;
+  std::unordered_set<const Variable *> allocated_;
+  bool software_pipeline_{false};
   // pipe buffer lane number
   int db_lane_{2};
   const int auto_unroll_bound_{2};
@@ -143,15 +433,16 @@ class AutoDoubleBufferInjector : public IRMutator {
 /**
  * Inject auto double buffer pass entry
  * @param [in] op    stmt The statement to be transformed
+ * @param [in] software_pipeline  Pipeline loads, compute and stores of the two lanes when the body allows it
  * @return           Transformed stmt
  */
-Stmt AutoDoubleBuffer(Stmt stmt) {
+Stmt AutoDoubleBuffer(Stmt stmt, bool software_pipeline) {
   DbFinder dbfinder;
   dbfinder.Visit(stmt);
   if (dbfinder.alreadyAdd_) {
     return stmt;
   }
-  stmt = AutoDoubleBufferInjector().Inject(stmt);
+  stmt = AutoDoubleBufferInjector(software_pipeline).Inject(stmt);
   return air::ir::ConvertSSA(stmt);
 }
 }  // namespace ir
@@ -357,6 +357,76 @@ Tensor DiffBuildingBlock(const Tensor &output, const Tensor &input, const Tensor
   return result;
 }
 
+/*!
+ * \brief Sum the parts of an adjoint in a single elementwise compute.
+ *
+ * The accumulation dtype is chosen once, the widest dtype of the parts (floats before integers), instead of
+ * casting the running sum to each new part. Narrow floats are summed as a balanced tree to bound the rounding error.
+ * Parts whose shapes differ broadcast, they keep the pairwise topi::add chain in the same accumulation dtype.
+ */
+static Tensor SumAdjointParts(const std::vector<Tensor> &parts, const std::string &name) {
+  CHECK(!parts.empty());
+  if (parts.size() == 1) {
+    return parts[0];
+  }
+  auto same_shape = [&parts](const Tensor &part) {
+    if (part->shape.size() != parts[0]->shape.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < part->shape.size(); ++i) {
+      if (!Equal(part->shape[i], parts[0]->shape[i])) {
+        return false;
+      }
+    }
+    return true;
+  };
+  Type dtype = parts[0]->dtype;
+  bool broadcast = false;
+  for (const Tensor &part : parts) {
+    broadcast = broadcast || !same_shape(part);
+    bool wider = part->dtype.bits() > dtype.bits() && part->dtype.is_float() == dtype.is_float();
+    if (wider || (part->dtype.is_float() && !dtype.is_float())) {
+      dtype = part->dtype;
+    }
+  }
+  if (broadcast) {
+    auto cast = [&dtype](const Tensor &part) { return part->dtype == dtype ? part : topi::cast(part, dtype); };
+    Tensor res = cast(parts[0]);
+    for (size_t i = 1; i < parts.size(); ++i) {
+      res = topi::add(res, cast(parts[i]));
+    }
+    return res;
+  }
+  bool balanced = dtype.is_float() && dtype.bits() < 32;
+  auto func = [&parts, &dtype, balanced](const Array<Var> &indices) {
+    std::vector<Expr> values;
+    for (const Tensor &part : parts) {
+      Expr value = part(Array<Expr>(indices.begin(), indices.end()));
+      values.push_back(part->dtype == dtype ? value : Cast::make(dtype, value));
+    }
+    if (!balanced) {
+      Expr res = values[0];
+      for (size_t i = 1; i < values.size(); ++i) {
+        res = Add::make(res, values[i]);
+      }
+      return res;
+    }
+    while (values.size() > 1) {
+      std::vector<Expr> next;
+      for (size_t i = 0; i + 1 < values.size(); i += 2) {
+        next.push_back(Add::make(values[i], values[i + 1]));
+      }
+      if (values.size() % 2 != 0) {
+        next.push_back(values.back());
+      }
+      values.swap(next);
+    }
+    return values[0];
+  };
+  // same tag as the topi::add chain it replaces, schedules match on it
+  return air::compute(parts[0]->shape, func, name, topi::kBroadcast);
+}
+
 DifferentiationResult Differentiate(const Tensor &output, const Array<Tensor> &inputs, const Tensor &head_or_null,
                                     const Map<std::string, NodeRef> &attrs, const Array<Tensor> &new_pld_array,
                                     const FDiffBuildingBlock &fdiff, const Map<Tensor, Array<Tensor>> &override_deps) {
@@ -438,14 +508,10 @@ DifferentiationResult Differentiate(const Tensor &output, const Array<Tensor> &i
         // The new adjoint is computed as a sum of the reverse dependencies' adjoints multiplied
         // by the corresponding "local" jacobians (dDep/dTensor). The computation of the jacobian
         // and the multiplication is done in the function fdiff (DiffBuildingBlock by default).
+        std::vector<Tensor> parts;
         for (const Tensor &dep : deps) {
           Tensor part = fdiff(dep, tensor, compute_adjoint(dep), attrs, new_pld_array);
-          if (res_adjoint.get()) {
-            if (res_adjoint->dtype != part->dtype) {
-              res_adjoint = topi::cast(res_adjoint, part->dtype);
-            }
-          }
-          res_adjoint = res_adjoint.get() ? topi::add(res_adjoint, part) : part;
+          parts.push_back(part);
 
           // Add this part to summands
           auto &summands_of_adjoint = summands[tensor];
@@ -455,6 +521,7 @@ DifferentiationResult Differentiate(const Tensor &output, const Array<Tensor> &i
             summands_of_adjoint = Map<Tensor, Tensor>({{dep, part}});
           }
         }
+        res_adjoint = SumAdjointParts(parts, tensor->op->name + "_adjoint_sum");
       }
 
       adjoints[tensor] = res_adjoint;
@@ -514,6 +581,25 @@ TVM_REGISTER_API("akg.autodiff.DiffBuildingBlock").set_body([](const TVMArgs arg
   *ret = DiffBuildingBlock(args[0], args[1], args[2], args[3], args[4]);
 });
 
+TVM_REGISTER_API("akg.autodiff.EqualSubtensors").set_body([](const TVMArgs args, TVMRetValue *ret) {
+  // the groups of equal subtensors ADPassMergeInternalArrayTensors merges
+  Array<Tensor> roots = args[0];
+  std::unordered_map<int, std::unordered_set<Tensor>> all_tensors_at_distance;
+  std::unordered_map<int, std::vector<std::unordered_set<Tensor>>> equal_tensors;
+  for (const auto &root : roots) {
+    std::unordered_set<int> distances;
+    CollectAllTensorsByDistance(root, distances, all_tensors_at_distance);
+  }
+  FindEqualTensorsByDistance(all_tensors_at_distance, equal_tensors);
+  Array<Array<Tensor>> groups;
+  for (const auto &it : equal_tensors) {
+    for (const auto &equal_set : it.second) {
+      groups.push_back(Array<Tensor>(equal_set.begin(), equal_set.end()));
+    }
+  }
+  *ret = groups;
+});
+
 TVM_REGISTER_API("akg.autodiff.Differentiate").set_body([](const TVMArgs args, TVMRetValue *ret) {
   CHECK(args.size()) << "No input args.";
   if (args.size() == 1) {
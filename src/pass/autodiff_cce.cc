@@ -19,6 +19,8 @@
 #include <tvm/ir_visitor.h>
 #include <arithmetic/const_fold.h>
 #include <op/op_util.h>
+#include <algorithm>
+#include <sstream>
 #include "pass/autodiff_cce.h"
 #include "pass/zero_elimination.h"
 
@@ -494,384 +496,174 @@ Tensor TensorDot(const Tensor &A, const Tensor &B, int axes = 2, std::string nam
 
 // Functions for optimization passes for AD
 
-bool CompareTensors(const Tensor &left_tensor, const Tensor &right_tensor,
-                    const std::unordered_set<Tensor> &equal_set) {
-  if ((equal_set.find(left_tensor) != equal_set.end()) && (equal_set.find(right_tensor) != equal_set.end())) {
-    return true;
-  }
-  return false;
-}
-
-bool CompareTensors(const Tensor &left_tensor, const Tensor &right_tensor,
-                    const std::vector<std::unordered_set<Tensor>> &all_equal_sets) {
-  if (left_tensor == right_tensor) {
-    return true;
-  }
-  for (auto it_set : all_equal_sets) {
-    if (CompareTensors(left_tensor, right_tensor, it_set)) {
-      return true;
-    }
-  }
-  return false;
-}
-
-bool DeepCompareTensorsNodes(const Tensor &left_tensor, const Tensor &right_tensor) {
-  if (left_tensor == right_tensor) {
-    return true;
-  }
-  // checking dtype
-  if (left_tensor->dtype != right_tensor->dtype) {
-    return false;
-  }
-  // checking output shape
-  if (left_tensor->shape.size() != right_tensor->shape.size()) {
-    return false;
-  }
-  for (size_t i = 0; i < left_tensor->shape.size(); i++) {
-    if (left_tensor->shape[i].as<IntImm>()->value != right_tensor->shape[i].as<IntImm>()->value) {
-      return false;
-    }
-  }
-  // checking value index
-  if (left_tensor->value_index != right_tensor->value_index) {
-    return false;
-  }
-  // Checking the op
-  if (left_tensor->op.as<PlaceholderOpNode>() || right_tensor->op.as<PlaceholderOpNode>()) {
-    // if both are Placeholder, the test should pass at the begin of the function already
-    return false;
-  }
-  auto left_op = left_tensor->op.as<ComputeOpNode>();
-  auto right_op = right_tensor->op.as<ComputeOpNode>();
-  if ((left_op == nullptr) || (right_op == nullptr)) {
-    return false;
-  }
-  // Checking the size of input_tensors
-  if (left_op->InputTensors().size() != right_op->InputTensors().size()) {
-    return false;
-  }
-  // Checking the axis
-  if (left_op->axis.size() != right_op->axis.size()) {
-    return false;
-  }
-  for (size_t i = 0; i < left_op->axis.size(); i++) {
-    if (!Equal(left_op->axis[i]->dom->min, right_op->axis[i]->dom->min)) {
-      return false;
-    }
-    if (!Equal(left_op->axis[i]->dom->extent, right_op->axis[i]->dom->extent)) {
-      return false;
-    }
-  }
-  // Checking the reduce_axis
-  if (left_op->reduce_axis.size() != right_op->reduce_axis.size()) {
-    return false;
-  }
-  for (size_t i = 0; i < left_op->reduce_axis.size(); i++) {
-    if (!Equal(left_op->reduce_axis[i]->dom->min, right_op->reduce_axis[i]->dom->min)) {
-      return false;
-    }
-    if (!Equal(left_op->reduce_axis[i]->dom->extent, right_op->reduce_axis[i]->dom->extent)) {
-      return false;
-    }
-  }
-  return true;
-}
+/*!
+ * \brief Hash-consed canonical form of tensor DAGs.
+ *
+ * Every tensor gets the id of its structural class: the signature of its operation (dtype, shape, value index,
+ * iteration domains and body) with the axes renamed by position and the tensors it reads replaced by their ids.
+ * Operands of Add and Mul are ordered canonically. Ids are memoized per tensor, so comparing or grouping all
+ * subtensors of a DAG is linear in its size, shared subexpressions are visited once.
+ */
+class TensorDagCanonicalizer : public IRMutator {
+ public:
+  TensorDagCanonicalizer() = default;
+  ~TensorDagCanonicalizer() override = default;
 
-bool CheckEqualAndBothCommutative(const ComputeOpNode *left_op, const ComputeOpNode *right_op, bool &commutative) {
-  commutative = false;
-  if ((left_op == nullptr) || (right_op == nullptr)) {
-    return false;
-  }
-  CHECK(!left_op->body.empty());
-  CHECK(!right_op->body.empty());
-  if (left_op->body[0].as<Add>() != nullptr) {
-    if (right_op->body[0].as<Add>() == nullptr) {
-      return false;
-    }
-    commutative = true;
-    return true;
-  }
-  if (left_op->body[0].as<Mul>() != nullptr) {
-    if (right_op->body[0].as<Mul>() == nullptr) {
-      return false;
-    }
-    commutative = true;
-    return true;
-  }
-  if (left_op->body[0].as<Sub>() != nullptr) {
-    if (right_op->body[0].as<Sub>() == nullptr) {
-      return false;
+  int64_t Canonicalize(const Tensor &tensor) {
+    auto it = ids_.find(tensor);
+    if (it != ids_.end()) {
+      return it->second;
     }
-    return true;
-  }
-  if (left_op->body[0].as<Div>() != nullptr) {
-    if (right_op->body[0].as<Div>() == nullptr) {
-      return false;
+    // placeholders and other non compute ops are only equal to themselves
+    std::string signature = "#" + std::to_string(ids_.size());
+    if (auto compute = tensor->op.as<ComputeOpNode>()) {
+      for (const auto &input : compute->InputTensors()) {
+        static_cast<void>(Canonicalize(input));
+      }
+      signature = Signature(tensor, compute);
     }
+    auto cls = classes_.emplace(signature, static_cast<int64_t>(classes_.size())).first->second;
+    ids_[tensor] = cls;
+    return cls;
   }
-  // Add more Ops if needed
-  return true;
-}
 
-bool CheckEqualConst(const ComputeOpNode *left_op, const ComputeOpNode *right_op) {
-  if ((left_op == nullptr) || (right_op == nullptr)) {
-    return false;
-  }
-  if ((left_op->InputTensors().size() != 1) || (right_op->InputTensors().size() != 1)) {
-    return false;
-  }
-
-  Expr left_const, right_const;
-  CHECK(!left_op->body.empty());
-  CHECK(!right_op->body.empty());
-  if (left_op->body[0]->GetTypeKey() == "Mul") {
-    if (is_const_ad(left_op->body[0].as<Mul>()->a)) {
-      left_const = left_op->body[0].as<Mul>()->a;
-    } else {
-      if (is_const_ad(left_op->body[0].as<Mul>()->b)) {
-        left_const = left_op->body[0].as<Mul>()->b;
-      } else {
-        return false;
-      }
-    }
-    if (is_const_ad(right_op->body[0].as<Mul>()->a)) {
-      right_const = right_op->body[0].as<Mul>()->a;
-    } else {
-      if (is_const_ad(right_op->body[0].as<Mul>()->b)) {
-        right_const = right_op->body[0].as<Mul>()->b;
-      } else {
-        return false;
-      }
-    }
-  } else {
-    if (left_op->body[0]->GetTypeKey() == "Add") {
-      if (is_const_ad(left_op->body[0].as<Add>()->a)) {
-        left_const = left_op->body[0].as<Add>()->a;
-      } else {
-        if (is_const_ad(left_op->body[0].as<Add>()->b)) {
-          left_const = left_op->body[0].as<Add>()->b;
-        } else {
-          return false;
+ private:
+  std::string Signature(const Tensor &tensor, const ComputeOpNode *op) {
+    std::ostringstream os;
+    os << tensor->dtype << "[" << tensor->value_index << "]" << tensor->shape;
+    var_map_.clear();
+    for (size_t i = 0; i < op->axis.size(); i++) {
+      os << "(" << op->axis[i]->dom->min << "," << op->axis[i]->dom->extent << ")";
+      var_map_[op->axis[i]->var.get()] = CanonicalVar("ax", i);
+    }
+    os << "|";
+    for (size_t i = 0; i < op->reduce_axis.size(); i++) {
+      os << "(" << op->reduce_axis[i]->dom->min << "," << op->reduce_axis[i]->dom->extent << ")";
+      var_map_[op->reduce_axis[i]->var.get()] = CanonicalVar("rx", i);
+    }
+    os << "|";
+    for (const auto &e : op->body) {
+      if (auto reduce = e.as<Reduce>()) {
+        os << "reduce(" << reduce->combiner->result << "," << reduce->combiner->identity_element << ","
+           << reduce->value_index << ")";
+        for (const auto &src : reduce->source) {
+          os << ToString(Mutate(src)) << ";";
         }
-      }
-      if (is_const_ad(right_op->body[0].as<Add>()->a)) {
-        right_const = right_op->body[0].as<Add>()->a;
+        os << ToString(Mutate(reduce->condition));
       } else {
-        if (is_const_ad(right_op->body[0].as<Add>()->b)) {
-          right_const = right_op->body[0].as<Add>()->b;
-        } else {
-          return false;
-        }
+        os << ToString(Mutate(e));
       }
+      os << ";";
     }
+    return os.str();
   }
-  return Equal(right_const, left_const);
-}
 
-bool DeepCompareTensors(const Tensor &left_tensor, const Tensor &right_tensor) {
-  if (left_tensor == right_tensor) {
-    return true;
+  Expr Mutate_(const Variable *op, const Expr &e) final {
+    auto it = var_map_.find(op);
+    return it == var_map_.end() ? e : it->second;
   }
 
-  if (!DeepCompareTensorsNodes(left_tensor, right_tensor)) {
-    return false;
+  Expr Mutate_(const Call *op, const Expr &e) final {
+    if (op->call_type == Call::Halide && op->func.as<OperationNode>()) {
+      Array<Expr> args;
+      for (const auto &arg : op->args) {
+        args.push_back(Mutate(arg));
+      }
+      auto input = Downcast<Operation>(op->func).output(op->value_index);
+      return Call::make(op->type, "t" + std::to_string(Canonicalize(input)), args, Call::Extern);
+    }
+    return IRMutator::Mutate_(op, e);
   }
 
-  auto left_op = left_tensor->op.as<ComputeOpNode>();
-  auto right_op = right_tensor->op.as<ComputeOpNode>();
+  Expr Mutate_(const Add *op, const Expr &e) final { return Commute<Add>(op); }
+  Expr Mutate_(const Mul *op, const Expr &e) final { return Commute<Mul>(op); }
 
-  if (left_op != nullptr && !left_op->body.empty() && right_op != nullptr && !right_op->body.empty()) {
-    if (auto left_call = left_op->body[0].as<Call>()) {
-      auto right_call = right_op->body[0].as<Call>();
-      if (right_call == nullptr) {
-        return false;
-      }
-      if (left_call->call_type != right_call->call_type) {
-        return false;
-      }
-      if (left_call->call_type == Call::PureIntrinsic) {
-        if (left_call->name != right_call->name) {
-          return false;
-        }
-      }
-      // Call::Halide or Call::PureIntrinsic
-      for (size_t i = 0; i < left_op->InputTensors().size(); i++) {
-        if (!DeepCompareTensors(left_op->InputTensors()[i], right_op->InputTensors()[i])) {
-          return false;
-        }
-      }
-      return true;
+  template <typename T>
+  Expr Commute(const T *op) {
+    Expr a = Mutate(op->a);
+    Expr b = Mutate(op->b);
+    if (ToString(b) < ToString(a)) {
+      std::swap(a, b);
     }
+    return T::make(a, b);
   }
 
-  bool commutative_op = false;
-  if (!CheckEqualAndBothCommutative(left_op, right_op, commutative_op)) {
-    return false;
-  }
-  if (!commutative_op) {
-    for (size_t i = 0; i < left_op->InputTensors().size(); i++) {
-      if (!DeepCompareTensors(left_op->InputTensors()[i], right_op->InputTensors()[i])) {
-        return false;
-      }
-      return true;
+  Var CanonicalVar(const std::string &prefix, size_t i) {
+    std::string name = prefix + std::to_string(i);
+    auto it = vars_.find(name);
+    if (it == vars_.end()) {
+      it = vars_.emplace(name, Var(name, Int(32))).first;
     }
-  } else {
-    if (!DeepCompareTensors(left_op->InputTensors()[0], right_op->InputTensors()[0])) {
-      if (right_op->InputTensors().size() < 2) {
-        return false;
-      }
-      if (!DeepCompareTensors(left_op->InputTensors()[0], right_op->InputTensors()[1])) {
-        return false;
-      }
-      if (!DeepCompareTensors(left_op->InputTensors()[1], right_op->InputTensors()[0])) {
-        return false;
-      }
-      return true;
-    }
-    if (right_op->InputTensors().size() < 2) {
-      return CheckEqualConst(left_op, right_op);
-    }
-    if (!DeepCompareTensors(left_op->InputTensors()[1], right_op->InputTensors()[1])) {
-      return false;
-    }
-    return true;
+    return it->second;
   }
-  return false;
-}
 
-bool ShallowCompareTensors(const Tensor &left_tensor, const Tensor &right_tensor,
-                           std::vector<std::unordered_set<Tensor>> &equal_tensors_at_distance) {
-  if (left_tensor == right_tensor) {
-    return true;
+  static std::string ToString(const Expr &e) {
+    std::ostringstream os;
+    os << e;
+    return os.str();
   }
-  if (!DeepCompareTensorsNodes(left_tensor, right_tensor)) {
-    return false;
-  }
-  auto left_op = left_tensor->op.as<ComputeOpNode>();
-  auto right_op = right_tensor->op.as<ComputeOpNode>();
 
-  if (left_op != nullptr && !left_op->body.empty() && right_op != nullptr && !right_op->body.empty()) {
-    if (auto left_call = left_op->body[0].as<Call>()) {
-      auto right_call = right_op->body[0].as<Call>();
-      if (right_call == nullptr) {
-        return false;
-      }
-      if (left_call->call_type != right_call->call_type) {
-        return false;
-      }
-      if (left_call->call_type == Call::PureIntrinsic) {
-        if (left_call->name != right_call->name) {
-          return false;
-        }
-        if (left_op->InputTensors()[0] == right_op->InputTensors()[0]) {
-          return true;
-        }
-      }
-      // Call::Halide or Call::PureIntrinsic
-      for (size_t i = 0; i < left_op->InputTensors().size(); i++) {
-        if (!CompareTensors(left_op->InputTensors()[i], right_op->InputTensors()[i], equal_tensors_at_distance)) {
-          return false;
-        }
-      }
-      return true;
-    }
-  }
+  std::unordered_map<Tensor, int64_t> ids_;
+  std::unordered_map<std::string, int64_t> classes_;
+  std::unordered_map<const Variable *, Expr> var_map_;
+  std::unordered_map<std::string, Var> vars_;
+};
 
-  bool commutative_op = false;
-  if (!CheckEqualAndBothCommutative(left_op, right_op, commutative_op)) {
-    return false;
-  }
-  if (!commutative_op) {
-    for (size_t i = 0; i < left_op->InputTensors().size(); i++) {
-      if (!CompareTensors(left_op->InputTensors()[i], right_op->InputTensors()[i], equal_tensors_at_distance)) {
-        return false;
-      }
-      return true;
-    }
-  } else {
-    if (!CompareTensors(left_op->InputTensors()[0], right_op->InputTensors()[0], equal_tensors_at_distance)) {
-      if (right_op->InputTensors().size() < 2) {
-        return false;
-      }
-      if (!CompareTensors(left_op->InputTensors()[0], right_op->InputTensors()[1], equal_tensors_at_distance)) {
-        return false;
-      }
-      if (!CompareTensors(left_op->InputTensors()[1], right_op->InputTensors()[0], equal_tensors_at_distance)) {
-        return false;
-      }
-      return true;
-    }
-    if (right_op->InputTensors().size() < 2) {
-      return CheckEqualConst(left_op, right_op);
-    }
-    if (!CompareTensors(left_op->InputTensors()[1], right_op->InputTensors()[1], equal_tensors_at_distance)) {
-      return false;
-    }
-    return true;
+static void CollectAllTensorsByDistance(const Tensor &tensor, std::unordered_set<int> &distances,
+                                        std::unordered_map<int, std::unordered_set<Tensor>> &all_tensors_at_distance,
+                                        std::unordered_map<Tensor, std::unordered_set<int>> &visited) {
+  auto it_visited = visited.find(tensor);
+  if (it_visited != visited.end()) {
+    distances.insert(it_visited->second.begin(), it_visited->second.end());
+    return;
   }
-  return false;
-}
-
-void CollectAllTensorsByDistance(const Tensor &tensor, std::unordered_set<int> &distances,
-                                 std::unordered_map<int, std::unordered_set<Tensor>> &all_tensors_at_distance) {
+  std::unordered_set<int> tensor_distances;
   for (auto inp : tensor->op->InputTensors()) {
     std::unordered_set<int> child_distances;
-    CollectAllTensorsByDistance(inp, child_distances, all_tensors_at_distance);
+    CollectAllTensorsByDistance(inp, child_distances, all_tensors_at_distance, visited);
     for (auto it : child_distances) {
-      distances.insert(it + 1);
+      tensor_distances.insert(it + 1);
       all_tensors_at_distance[it + 1].insert(tensor);
     }
   }
   if (tensor->op.as<PlaceholderOpNode>() != nullptr) {
     (void)all_tensors_at_distance[0].emplace(tensor);
-    (void)distances.emplace(0);
+    (void)tensor_distances.emplace(0);
   }
+  distances.insert(tensor_distances.begin(), tensor_distances.end());
+  visited[tensor] = std::move(tensor_distances);
   return;
 }
 
+void CollectAllTensorsByDistance(const Tensor &tensor, std::unordered_set<int> &distances,
+                                 std::unordered_map<int, std::unordered_set<Tensor>> &all_tensors_at_distance) {
+  // shared subtensors are walked once
+  std::unordered_map<Tensor, std::unordered_set<int>> visited;
+  CollectAllTensorsByDistance(tensor, distances, all_tensors_at_distance, visited);
+}
+
 void FindEqualTensorsByDistance(const std::unordered_map<int, std::unordered_set<Tensor>> &all_tensors_at_distance,
                                 std::unordered_map<int, std::vector<std::unordered_set<Tensor>>> &equal_tensors) {
+  // equal tensors share their canonical id, so each distance is grouped in one pass instead of pairwise
+  TensorDagCanonicalizer canonicalizer;
   size_t max_distance = all_tensors_at_distance.size();
   for (size_t distance = 1; distance < max_distance; distance++) {
-    // Find all sets of equal tensors at distance "distance" to placeholders
     // At distance = 0, there are placeholders only
-    std::vector<Tensor> tmp_tensors_at_distance;
-    std::vector<int> assigned;
     if (all_tensors_at_distance.find(distance) == all_tensors_at_distance.end()) {
       continue;
     }
-    for (auto it : all_tensors_at_distance.at(distance)) {
-      tmp_tensors_at_distance.push_back(it);
-      assigned.push_back(0);
-    }
-    if (tmp_tensors_at_distance.empty()) {
-      continue;
-    }
-
-    for (size_t i = 0; i < tmp_tensors_at_distance.size() - 1; i++) {
-      if (assigned[i] == 1) {
-        continue;
+    std::vector<int64_t> order;
+    std::unordered_map<int64_t, std::unordered_set<Tensor>> classes;
+    for (const auto &it : all_tensors_at_distance.at(distance)) {
+      int64_t id = canonicalizer.Canonicalize(it);
+      if (classes.find(id) == classes.end()) {
+        order.push_back(id);
       }
-      std::unordered_set<Tensor> tmp_equal_tensors;
-      size_t t_distance = distance;
-      for (size_t j = i + 1; j < tmp_tensors_at_distance.size(); j++) {
-        if (assigned[j] == 1) {
-          continue;
-        }
-        // Comparing tmp_tensors_at_distance[i] with tmp_tensors_at_distance[j]
-        if (ShallowCompareTensors(tmp_tensors_at_distance[i], tmp_tensors_at_distance[j],
-                                  equal_tensors[t_distance - 1])) {
-          if (assigned[i] == 0) {
-            tmp_equal_tensors.insert(tmp_tensors_at_distance[i]);
-            assigned[i] = 1;
-          }
-          tmp_equal_tensors.insert(tmp_tensors_at_distance[j]);
-          assigned[j] = 1;
-        }
-      }
-      if (tmp_equal_tensors.size() > 0) {
-        equal_tensors[t_distance].push_back(tmp_equal_tensors);
-        tmp_equal_tensors.clear();
+      classes[id].insert(it);
+    }
+    for (auto id : order) {
+      if (classes[id].size() > 1) {
+        equal_tensors[distance].push_back(std::move(classes[id]));
       }
     }
   }
@@ -1282,6 +1074,10 @@ Tensor IsolateTensor(const Tensor &tensor) {
 }
 
 void CollectDFSOrder(const Tensor &root, std::unordered_map<Tensor, int> &dfs_order) {
+  // subtensors of a visited tensor are numbered already
+  if (dfs_order.find(root) != dfs_order.end()) {
+    return;
+  }
   for (auto inp : root->op->InputTensors()) {
     CollectDFSOrder(inp, dfs_order);
   }
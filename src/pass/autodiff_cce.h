@@ -154,62 +154,6 @@ Tensor TensorDot(const Tensor &A, const Tensor &B, int axes, std::string name, b
 
 // Functions for optimization passes for AD
 
-/*!
- * \brief Comparing two tensors based on a given set of equal tensors.
- * \param left_tensor The first tensor to compare.
- * \param right_tensor The second tensor to compare.
- * \param equal_set  The set containing equal tensors.
- * \return True if both left_tensor and right_tensor belong to the equal_set.
- */
-bool CompareTensors(const Tensor &left_tensor, const Tensor &right_tensor, const std::unordered_set<Tensor> &equal_set);
-
-/*!
- * \brief Comparing two tensors based on a number of given sets of equal tensors (a vector of sets).
- * \param left_tensor The first tensor to compare.
- * \param right_tensor The second tensor to compare.
- * \param all_equal_sets  The vector containing sets of equal tensors.
- * \return True if both left_tensor and right_tensor belong to one of the equal_sets given.
- */
-bool CompareTensors(const Tensor &left_tensor, const Tensor &right_tensor,
-                    const std::vector<std::unordered_set<Tensor>> &all_equal_sets);
-
-/*!
- * \brief `Deep` comparing two tensors based on their parameters and computations.
- * \param left_tensor The first tensor to compare.
- * \param right_tensor The second tensor to compare.
- * \return True if both left_tensor and right_tensor have the same set of parameters.
- */
-bool DeepCompareTensorsNodes(const Tensor &left_tensor, const Tensor &right_tensor);
-
-/*!
- * \brief `Deep` comparing two tensors based on their parameters and computations and their input
- * tensors.
- *
- * \param left_tensor The first tensor to compare.
- *
- * \param right_tensor The second tensor to compare.
- *
- * \return True if both left_tensor and right_tensor have the same set of parameters and
- * recurrently for their input tensors, For commutative operators, "A op B" is equal "B op A" too.
- */
-bool DeepCompareTensors(const Tensor &left_tensor, const Tensor &right_tensor);
-
-/*!
- * \brief `Shallow` comparing two tensors based on their parameters and computations and their input
- * tensors.
- *
- * \param left_tensor The first tensor to compare.
- *
- * \param right_tensor The second tensor to compare.
- *
- * \return True if both left_tensor and right_tensor have the same set of parameters. This
- * function doesn't recurrently check the equalities of the input tensors of the given tensors but
- * only check from known sets of equal tensors. For commutative operators, "A op B" is equal "B op
- * A" too.
- */
-bool ShallowCompareTensors(const Tensor &left_tensor, const Tensor &right_tensor,
-                           std::vector<std::unordered_set<Tensor>> &equal_tensors_at_distance);
-
 /*!
  * \brief Walk recursively the given tensor, collect and group subtensors by their "distance" to
  * placeholder inputs.
@@ -0,0 +1,282 @@
+/**
+ * Copyright 2026 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tvm/arithmetic.h>
+#include <tvm/ir.h>
+#include <tvm/ir_mutator.h>
+#include <tvm/ir_pass.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "emit_insn/cce_params.h"
+#include "ir_pass.h"
+#include "pass/utils.h"
+
+namespace akg {
+namespace ir {
+namespace {
+// dma with (dst, src, sid, nBurst, lenBurst, srcStride, dstStride, ...) and bursts of 32 bytes
+const std::unordered_set<std::string> kBlockDmaInsn = {"copy_gm_to_ubuf",   "copy_ubuf_to_gm",   "copy_ubuf_to_ubuf",
+                                                       "copy_gm_to_cbuf",   "copy_ubuf_to_cbuf", "copy_cbuf_to_ubuf"};
+constexpr int kBurstUnit = 32;
+enum DmaArg { kDst = 0, kSrc, kSid, kNBurst, kLenBurst, kSrcStride, kDstStride, kNumDmaArgs };
+// tvm_access_ptr(type, buffer, offset, extent, rw)
+enum PtrArg { kPtrType = 0, kPtrBuffer, kPtrOffset, kPtrExtent, kPtrRw };
+
+const Call *GetDma(const Stmt &stmt) {
+  const auto eval = stmt.as<Evaluate>();
+  if (eval == nullptr) return nullptr;
+  const auto call = eval->value.as<Call>();
+  if (call == nullptr || kBlockDmaInsn.count(call->name) == 0 || call->args.size() < kNumDmaArgs) return nullptr;
+  const auto dst = call->args[kDst].as<Call>();
+  const auto src = call->args[kSrc].as<Call>();
+  if (dst == nullptr || src == nullptr || !dst->is_intrinsic(air::ir::intrinsic::tvm_access_ptr) ||
+      !src->is_intrinsic(air::ir::intrinsic::tvm_access_ptr)) {
+    return nullptr;
+  }
+  return call;
+}
+
+const Call *Ptr(const Call *dma, int arg) { return dma->args[arg].as<Call>(); }
+
+int ElemBytes(const Call *dma) { return Ptr(dma, kDst)->args[kPtrType].type().bytes(); }
+
+Expr MakePtr(const Call *ptr, const Expr &offset, const Expr &extent) {
+  Array<Expr> args = ptr->args;
+  args.Set(kPtrOffset, offset);
+  args.Set(kPtrExtent, extent);
+  return Call::make(ptr->type, ptr->name, args, ptr->call_type, ptr->func, ptr->value_index);
+}
+
+Stmt MakeDma(const Call *dma, const Expr &dst, const Expr &src, int64_t n_burst, int64_t len_burst,
+             int64_t src_stride, int64_t dst_stride) {
+  Array<Expr> args = dma->args;
+  Type t = dma->args[kNBurst].type();
+  args.Set(kDst, dst);
+  args.Set(kSrc, src);
+  args.Set(kNBurst, make_const(t, n_burst));
+  args.Set(kLenBurst, make_const(t, len_burst));
+  args.Set(kSrcStride, make_const(t, src_stride));
+  args.Set(kDstStride, make_const(t, dst_stride));
+  return Evaluate::make(Call::make(dma->type, dma->name, args, dma->call_type, dma->func, dma->value_index));
+}
+
+bool GetConst(const Expr &e, int64_t *value) {
+  Expr simple = Simplify(e);
+  if (const auto imm = simple.as<IntImm>()) {
+    *value = imm->value;
+    return true;
+  }
+  return false;
+}
+
+// the written and the read range of one buffer overlap, or cannot be told apart; the order of the bursts then
+// decides the result and they cannot be issued as one instruction
+bool MayOverlap(const Expr &dst_ptr, const Expr &src_ptr) {
+  const auto dst = dst_ptr.as<Call>();
+  const auto src = src_ptr.as<Call>();
+  CHECK(dst && src);
+  if (!dst->args[kPtrBuffer].same_as(src->args[kPtrBuffer])) {
+    return false;
+  }
+  int64_t dist = 0;
+  int64_t dst_extent = 0;
+  int64_t src_extent = 0;
+  if (!Equal(dst->args[kPtrType], src->args[kPtrType]) ||
+      !GetConst(src->args[kPtrOffset] - dst->args[kPtrOffset], &dist) ||
+      !GetConst(dst->args[kPtrExtent], &dst_extent) || !GetConst(src->args[kPtrExtent], &src_extent)) {
+    return true;
+  }
+  return dist < dst_extent && -dist < src_extent;
+}
+}  // namespace
+
+/*
+ * Fold dma into multi-burst instructions:
+ *
+ *   for (i, 0, 16) {
+ *     copy_gm_to_ubuf(ub[i * 32], gm[i * 64], 0, 1, 2, 0, 0)
+ *   }
+ * -->
+ *   copy_gm_to_ubuf(ub[0], gm[0], 0, 16, 2, 2, 0)
+ *
+ * and merge single-burst dma of a sequence that continue each other on both sides:
+ *
+ *   copy_ubuf_to_gm(gm[0], ub[0], 0, 1, 4, 0, 0)
+ *   copy_ubuf_to_gm(gm[64], ub[64], 0, 1, 1, 0, 0)
+ * -->
+ *   copy_ubuf_to_gm(gm[0], ub[0], 0, 1, 5, 0, 0)
+ *
+ * A copy within one buffer whose written range overlaps the range it reads is left as it is.
+ */
+class DmaCoalescer : public IRMutator {
+ public:
+  DmaCoalescer() {}
+  ~DmaCoalescer() override = default;
+
+  Stmt Mutate_(const For *op, const Stmt &s) final {
+    Stmt stmt = IRMutator::Mutate_(op, s);
+    op = stmt.as<For>();
+    CHECK(op);
+    const Call *dma = GetDma(op->body);
+    const auto extent = op->extent.as<IntImm>();
+    if (dma == nullptr || extent == nullptr || extent->value <= 1 || !is_one(dma->args[kNBurst])) {
+      return stmt;
+    }
+    Stmt folded = FoldLoop(op, dma, extent->value);
+    if (!folded.defined()) {
+      return stmt;
+    }
+    ++num_folded_loops_;
+    num_removed_insn_ += extent->value - 1;
+    return folded;
+  }
+
+  Stmt Mutate_(const Block *op, const Stmt &s) final {
+    Stmt first = Mutate(op->first);
+    Stmt rest = Mutate(op->rest);
+    // the sequence is a right leaning list, merge into the head of rest
+    const Call *a = GetDma(first);
+    const Call *b = GetDma(rest.as<Block>() ? rest.as<Block>()->first : rest);
+    Stmt merged = (a != nullptr && b != nullptr) ? MergeAdjacent(a, b) : Stmt();
+    if (merged.defined()) {
+      ++num_removed_insn_;
+      const auto block = rest.as<Block>();
+      return block != nullptr ? Block::make(merged, block->rest) : merged;
+    }
+    if (first.same_as(op->first) && rest.same_as(op->rest)) {
+      return s;
+    }
+    return Block::make(first, rest);
+  }
+
+  void DumpStatistics() const {
+    if (num_removed_insn_ > 0) {
+      LOG(INFO) << "CoalesceDma folded " << num_folded_loops_ << " dma loops, " << num_removed_insn_
+                << " dma instructions less";
+    }
+  }
+
+ private:
+  Stmt FoldLoop(const For *op, const Call *dma, int64_t extent) const {
+    for (size_t i = 0; i < dma->args.size(); ++i) {
+      if (i != kDst && i != kSrc && air::ir::ExprUseVar(dma->args[i], op->loop_var)) return Stmt();
+    }
+    const Call *dst = Ptr(dma, kDst);
+    const Call *src = Ptr(dma, kSrc);
+    for (const Call *ptr : {dst, src}) {
+      for (size_t i = 0; i < ptr->args.size(); ++i) {
+        if (i != kPtrOffset && air::ir::ExprUseVar(ptr->args[i], op->loop_var)) return Stmt();
+      }
+    }
+    int64_t len_burst = 0;
+    int64_t dst_step = 0;
+    int64_t src_step = 0;
+    if (!GetConst(dma->args[kLenBurst], &len_burst) || !Step(dst->args[kPtrOffset], op->loop_var, &dst_step) ||
+        !Step(src->args[kPtrOffset], op->loop_var, &src_step)) {
+      return Stmt();
+    }
+    int bytes = ElemBytes(dma);
+    int64_t dst_gap = 0;
+    int64_t src_gap = 0;
+    if (!Gap(dst_step * bytes, len_burst, &dst_gap) || !Gap(src_step * bytes, len_burst, &src_gap)) {
+      return Stmt();
+    }
+    std::unordered_map<const Variable *, Expr> vmap;
+    vmap[op->loop_var.get()] = op->min;
+    auto fold_ptr = [&vmap, extent](const Call *ptr, int64_t step) {
+      Expr offset = Simplify(air::ir::Substitute(ptr->args[kPtrOffset], vmap));
+      Expr span = Simplify(make_const(ptr->args[kPtrExtent].type(), (extent - 1) * step) + ptr->args[kPtrExtent]);
+      return MakePtr(ptr, offset, span);
+    };
+    Expr new_dst = fold_ptr(dst, dst_step);
+    Expr new_src = fold_ptr(src, src_step);
+    if (MayOverlap(new_dst, new_src)) {
+      return Stmt();
+    }
+    if (dst_gap == 0 && src_gap == 0 && extent * len_burst < MAX_LENBURST) {
+      // contiguous on both sides, a single long burst
+      return MakeDma(dma, new_dst, new_src, 1, extent * len_burst, 0, 0);
+    }
+    if (extent >= MAX_NBURST || dst_gap >= MAX_STRIDE || src_gap >= MAX_STRIDE) {
+      return Stmt();
+    }
+    return MakeDma(dma, new_dst, new_src, extent, len_burst, src_gap, dst_gap);
+  }
+
+  Stmt MergeAdjacent(const Call *a, const Call *b) const {
+    if (a->name != b->name || a->args.size() != b->args.size() || !is_one(a->args[kNBurst]) ||
+        !is_one(b->args[kNBurst])) {
+      return Stmt();
+    }
+    for (size_t i = kSid; i < a->args.size(); ++i) {
+      if (i != kNBurst && i != kLenBurst && i != kSrcStride && i != kDstStride && !Equal(a->args[i], b->args[i])) {
+        return Stmt();
+      }
+    }
+    int64_t len_a = 0;
+    int64_t len_b = 0;
+    if (!GetConst(a->args[kLenBurst], &len_a) || !GetConst(b->args[kLenBurst], &len_b) ||
+        len_a + len_b >= MAX_LENBURST || (len_a * kBurstUnit) % ElemBytes(a) != 0) {
+      return Stmt();
+    }
+    int64_t burst_elems = len_a * kBurstUnit / ElemBytes(a);
+    Expr ptrs[2];
+    for (int arg : {kDst, kSrc}) {
+      const Call *pa = Ptr(a, arg);
+      const Call *pb = Ptr(b, arg);
+      int64_t dist = 0;
+      if (!pa->args[kPtrBuffer].same_as(pb->args[kPtrBuffer]) || !Equal(pa->args[kPtrType], pb->args[kPtrType]) ||
+          !Equal(pa->args[kPtrRw], pb->args[kPtrRw]) ||
+          !GetConst(pb->args[kPtrOffset] - pa->args[kPtrOffset], &dist) || dist != burst_elems) {
+        return Stmt();
+      }
+      ptrs[arg] = MakePtr(pa, pa->args[kPtrOffset], Simplify(make_const(pa->args[kPtrExtent].type(), dist) +
+                                                             pb->args[kPtrExtent]));
+    }
+    if (MayOverlap(ptrs[kDst], ptrs[kSrc])) {
+      return Stmt();
+    }
+    return MakeDma(a, ptrs[kDst], ptrs[kSrc], 1, len_a + len_b, 0, 0);
+  }
+
+  // constant coefficient of the loop var in an offset
+  static bool Step(const Expr &offset, const Var &var, int64_t *step) {
+    Array<Expr> coef = air::arith::DetectLinearEquation(offset, {var});
+    return coef.size() == 2 && GetConst(coef[0], step) && *step >= 0;
+  }
+
+  // stride between bursts in units of 32 bytes
+  static bool Gap(int64_t step_bytes, int64_t len_burst, int64_t *gap) {
+    if (step_bytes % kBurstUnit != 0) return false;
+    *gap = step_bytes / kBurstUnit - len_burst;
+    return *gap >= 0;
+  }
+
+  int64_t num_folded_loops_{0};
+  int64_t num_removed_insn_{0};
+};
+
+Stmt CoalesceDma(Stmt stmt) {
+  DmaCoalescer coalescer;
+  stmt = coalescer.Mutate(stmt);
+  coalescer.DumpStatistics();
+  return stmt;
+}
+}  // namespace ir
+}  // namespace akg
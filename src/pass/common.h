@@ -49,6 +49,22 @@ struct MemInfo {
 
 int GetIntrinPipe(std::string insn_name);
 
+// index of the repeat argument of a vector intrinsic call, -1 when the call has none
+int GetVectorRepeatIndex(const Call *call);
+
+// repeat argument of a vector intrinsic call, 1 when the call has none
+Expr GetVectorRepeat(const Call *call);
+
+// dtype of the first buffer operand of an intrinsic call, empty when it has none
+std::string GetIntrinDType(const Call *call);
+
+// lanes enabled by a set_vector_mask call, all of them when the mask is not constant
+int GetVectorMaskBits(const Call *call);
+
+// nBurst and lenBurst of copy_*(dst, src, sid, nBurst, lenBurst, ...) and the bytes of one lenBurst unit: a fractal
+// for copies out of L0C, a block otherwise. false for other intrinsics
+bool GetCopyBursts(const Call *call, Expr *n_burst, Expr *len_burst, int64_t *unit);
+
 // base class for df analyzer
 class DFAnalyzer {
  public:
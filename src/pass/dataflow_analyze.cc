@@ -17,7 +17,11 @@
 #include <tvm/ir.h>
 #include <tvm/ir_visitor.h>
 #include <ir_pass.h>
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
 #include <pass/storage_access.h>
+#include "build_module.h"
 #include "pass/common.h"
 #include "pass/overflow_check.h"
 #include "pass/dependency_graph.h"
@@ -34,14 +38,37 @@ struct BranchTag {
   }
 };
 
+// Byte hull of the accesses of an entry to one memory. Global buffers are separate memories, the local buffers
+// of a scope share its address space.
+struct AccessRange {
+  int scope_id;
+  const Variable *base;
+  int64_t begin;
+  int64_t end;
+
+  bool operator<(const AccessRange &other) const {
+    return scope_id != other.scope_id ? scope_id < other.scope_id : base < other.base;
+  }
+  bool SameMemory(const AccessRange &other) const { return scope_id == other.scope_id && base == other.base; }
+};
+
+// Conservative summary of the accesses of an entry, entries whose summaries do not overlap are independent
+struct AccessSummary {
+  // sorted by memory, one hull per memory
+  std::vector<AccessRange> def;
+  std::vector<AccessRange> use;
+  bool touch_register{false};
+};
+
 // Touch Entry
 struct TouchEntry {
   uint32_t index;
   std::vector<MemInfo> def;
   std::vector<MemInfo> use;
-  std::set<const AttrStmt *> RAW;
-  std::set<const AttrStmt *> WAR;
-  std::set<const AttrStmt *> WAW;
+  AccessSummary summary;
+  std::unordered_set<const AttrStmt *> RAW;
+  std::unordered_set<const AttrStmt *> WAR;
+  std::unordered_set<const AttrStmt *> WAW;
   bool mask_insn{false};
   const AttrStmt *nest_attr{nullptr};
   BranchTag branch_tag;
@@ -78,6 +105,18 @@ class DFVisitor : public IRVisitor {
   void Plan(const Stmt &stmt) {
     branch_tag_.data = std::make_shared<std::vector<int>>(1, 1);
     IRVisitor::Visit(stmt);
+    for (auto &it : touched_) {
+      Summarize(&it.second);
+    }
+  }
+
+  // false only if the two entries cannot touch the same memory
+  bool MayDepend(const TouchEntry &a, const TouchEntry &b) const {
+    if (!use_summary_ || a.summary.touch_register || b.summary.touch_register) {
+      return true;
+    }
+    return Overlap(a.summary.def, b.summary.def) || Overlap(a.summary.def, b.summary.use) ||
+           Overlap(a.summary.use, b.summary.def);
   }
 
   void Visit_(const Load *op) final {
@@ -358,6 +397,80 @@ class DFVisitor : public IRVisitor {
   }
 
  private:
+  AccessRange GetAccessRange(const MemInfo &m) {
+    const int64_t kMin = std::numeric_limits<int64_t>::min();
+    const int64_t kMax = std::numeric_limits<int64_t>::max();
+    StorageScope scope = GetScope(m.base);
+    AccessRange range{0, m.base, kMin, kMax};
+    int64_t addr = 0;
+    if (scope.rank != StorageRank::kGlobal) {
+      auto id = scope_id_.emplace(scope.to_string(), static_cast<int>(scope_id_.size()) + 1);
+      range.scope_id = id.first->second;
+      range.base = nullptr;
+      auto it = storage_range_.find(m.base);
+      if (it == storage_range_.end()) {
+        return range;
+      }
+      addr = it->second.addr;
+      range.begin = addr;
+      range.end = addr + it->second.size;
+    }
+    const auto offset = m.offset.as<IntImm>();
+    const auto extent = m.extent.as<IntImm>();
+    if (offset != nullptr && extent != nullptr) {
+      range.begin = addr + offset->value * m.type.bytes();
+      // accesses starting at the same address alias even when empty
+      range.end = std::max(addr + (offset->value + extent->value) * m.type.bytes(), range.begin + 1);
+    }
+    return range;
+  }
+
+  std::vector<AccessRange> Hulls(const std::vector<MemInfo> &infos, bool *touch_register) {
+    std::vector<AccessRange> ranges;
+    for (const auto &m : infos) {
+      if (m.base == const_reg.get()) {
+        *touch_register = true;
+        continue;
+      }
+      ranges.emplace_back(GetAccessRange(m));
+    }
+    std::sort(ranges.begin(), ranges.end());
+    std::vector<AccessRange> hulls;
+    for (const auto &r : ranges) {
+      if (!hulls.empty() && hulls.back().SameMemory(r)) {
+        hulls.back().begin = std::min(hulls.back().begin, r.begin);
+        hulls.back().end = std::max(hulls.back().end, r.end);
+      } else {
+        hulls.emplace_back(r);
+      }
+    }
+    return hulls;
+  }
+
+  void Summarize(TouchEntry *entry) {
+    entry->summary.def = Hulls(entry->def, &entry->summary.touch_register);
+    entry->summary.use = Hulls(entry->use, &entry->summary.touch_register);
+  }
+
+  static bool Overlap(const std::vector<AccessRange> &a, const std::vector<AccessRange> &b) {
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.size() && j < b.size()) {
+      if (a[i] < b[j]) {
+        ++i;
+      } else if (b[j] < a[i]) {
+        ++j;
+      } else {
+        if (a[i].begin < b[j].end && b[j].begin < a[i].end) {
+          return true;
+        }
+        ++i;
+        ++j;
+      }
+    }
+    return false;
+  }
+
   // Get current storage scope.
   StorageScope GetScope(const Variable *buf) const {
     auto it = storage_scope_.find(buf);
@@ -711,7 +824,11 @@ class DFVisitor : public IRVisitor {
   Map<Var, Range> range_;
 
   std::unordered_map<const AttrStmt *, TouchEntry> touched_;
-  std::unordered_map<uint32_t, bool> dep_found_;
+  std::unordered_map<uint64_t, bool> dep_found_;
+  // the summaries only skip alias checks that fail anyway, enable_access_summary=false checks every pair
+  bool use_summary_{global_attrs.GetBoolAttr(kEnableAccessSummary, true)};
+  // ids of the local storage scopes in access summaries, 0 is global memory
+  std::unordered_map<std::string, int> scope_id_;
   // The storage scope of each buffer
   std::unordered_map<const Variable *, StorageScope> storage_scope_;
   // The base address and size of each buffer
@@ -747,6 +864,9 @@ class MemDependencyGraph : public DependencyGraph<MemDependencyNode> {
 
       const DFVisitor *self = a->analyzer;
       CHECK(self);
+      if (!self->MayDepend(*a->entry, *b->entry)) {
+        return DepType::kNone;
+      }
 
       if (self->DepBetween(a->entry->use, b->entry->def)) {
         return DepType::kRAW;
@@ -809,7 +929,13 @@ class DFAnalyzeOnline : public DFAnalyzer {
       return false;
     }
 
-    uint64_t dep_tag = ea.index < eb.index ? (ea.index << 16) | eb.index : (eb.index << 16) | ea.index;
+    if (!visitor_.MayDepend(ea, eb)) {
+      return false;
+    }
+
+    uint64_t lo = std::min(ea.index, eb.index);
+    uint64_t hi = std::max(ea.index, eb.index);
+    uint64_t dep_tag = (lo << 32) | hi;
     auto it = visitor_.dep_found_.find(dep_tag);
     if (it != visitor_.dep_found_.end()) {
       return it->second;
@@ -841,7 +967,7 @@ class DFAnalyzeOffline : public DFAnalyzer {
   }
 
   bool DepForward(const AttrStmt *a, const AttrStmt *b) final {
-    auto entry = visitor_.touched_[a];
+    const TouchEntry &entry = visitor_.touched_[a];
     if ((entry.RAW.count(b) != 0) || (entry.WAR.count(b) != 0) || (entry.WAW.count(b) != 0)) {
       return true;
     }
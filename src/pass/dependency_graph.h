@@ -17,11 +17,34 @@
 #ifndef PASS_DEPENDENCY_GRAPH_H_
 #define PASS_DEPENDENCY_GRAPH_H_
 
+#include <cstdint>
 #include <vector>
 #include <utility>
 #include <set>
+#include <unordered_map>
 namespace akg {
 namespace ir {
+// set of node indices as a sparse bitset of 64-bit words, unions cost one operation per word
+class ReachSet {
+ public:
+  void Insert(uint32_t idx) { words_[idx >> kWordShift] |= (1ULL << (idx & kWordMask)); }
+  bool Count(uint32_t idx) const {
+    auto it = words_.find(idx >> kWordShift);
+    return it != words_.end() && ((it->second >> (idx & kWordMask)) & 1ULL) != 0;
+  }
+  void Unite(const ReachSet &other) {
+    for (const auto &w : other.words_) {
+      words_[w.first] |= w.second;
+    }
+  }
+  void Clear() { words_.clear(); }
+
+ private:
+  static constexpr uint32_t kWordShift = 6;
+  static constexpr uint32_t kWordMask = 63;
+  std::unordered_map<uint32_t, uint64_t> words_;
+};
+
 template <typename T>
 class DependencyGraph {
  public:
@@ -64,7 +87,7 @@ class DependencyGraph {
     }
     std::fill(done_.begin(), done_.end(), false);
     for (uint32_t i = 0; i < nodes_.size(); ++i) {
-      reaching_[i].clear();
+      reaching_[i].Clear();
       edges_[i].clear();
     }
 
@@ -142,15 +165,15 @@ class DependencyGraph {
     }
     versionID_[jdx] = currentID_;
 
-    reaching_[jdx].insert(reaching_[idx].begin(), reaching_[idx].end());
-    reaching_[jdx].insert(idx);
+    reaching_[jdx].Unite(reaching_[idx]);
+    reaching_[jdx].Insert(static_cast<uint32_t>(idx));
 
     for (auto k : edges_[jdx]) {
       SetReaching_(idx, k);
     }
   }
 
-  bool IsReaching_(int idx, int jdx) { return reaching_[jdx].count(idx) != 0; }
+  bool IsReaching_(int idx, int jdx) { return reaching_[jdx].Count(static_cast<uint32_t>(idx)); }
 
   void DFSCheck_(int i, int j, std::set<std::pair<int, int>> &error_pairs) {
     if (versionID_[j] == currentID_) {
@@ -172,7 +195,7 @@ class DependencyGraph {
 
   // additional attributes to nodes
   std::vector<bool> done_;
-  std::vector<std::set<int>> reaching_;
+  std::vector<ReachSet> reaching_;
   std::vector<std::set<int>> edges_;
   std::vector<uint32_t> versionID_;
 
@@ -17,6 +17,10 @@
 #include <tvm/ir_mutator.h>
 #include <tvm/ir_visitor.h>
 #include <tvm/ir_pass.h>
+
+#include <array>
+#include <vector>
+
 #include "pass/common.h"
 
 namespace akg {
@@ -230,6 +234,10 @@ class VecMaskElimPlan : public IRVisitor {
     if (ca == nullptr || cb == nullptr) {
       return ca == cb;
     }
+    // memory may change between the sets, VecStateAnalyzer follows the writes
+    if (ReadsMemory(ea) || ReadsMemory(eb)) {
+      return false;
+    }
     const Array<Expr> &a = ca->args;
     const Array<Expr> &b = cb->args;
     if (a.size() != b.size()) {
@@ -243,6 +251,14 @@ class VecMaskElimPlan : public IRVisitor {
     return true;
   }
 
+  static bool ReadsMemory(const Expr &e) {
+    bool reads = false;
+    PostOrderVisit(e, [&reads](const NodeRef &node) {
+      if (node.as<Load>() != nullptr) reads = true;
+    });
+    return reads;
+  }
+
   enum FirstType {
     FT_NONE,
     FT_MASKED,
@@ -324,9 +340,296 @@ class UniqueVecMask : public IRMutator {
   std::unordered_set<const Call *> vmask_;
 };
 
+// registers set by a dedicated instruction and read implicitly by vector instructions
+enum VecStateReg { VS_VECTOR_MASK = 0, VS_DEQSCALE, VS_CMPMASK, VS_NUM };
+
+using VecState = std::array<Expr, VS_NUM>;
+
+int GetStateSetter(const Call *call) {
+  if (call->name == "set_vector_mask" || call->name == "set_vector_mask_dup") return VS_VECTOR_MASK;
+  if (call->name == "set_deqscale") return VS_DEQSCALE;
+  if (call->name == "set_cmpmask") return VS_CMPMASK;
+  return -1;
+}
+
+bool SameState(const Expr &ea, const Expr &eb) {
+  const Call *ca = ea.as<Call>();
+  const Call *cb = eb.as<Call>();
+  if (ca == nullptr || cb == nullptr || ca->name != cb->name || ca->args.size() != cb->args.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < ca->args.size(); i++) {
+    if (!Equal(ca->args[i], cb->args[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// values that are the same in every iteration of the loop of loop_var, or of any loop when it is null;
+// the others are unknown after a back edge
+bool IsInvariantState(const Expr &e, const Variable *loop_var = nullptr) {
+  bool invariant = true;
+  PostOrderVisit(e, [&invariant, loop_var](const NodeRef &node) {
+    const auto var = node.as<Variable>();
+    if ((var != nullptr && (loop_var == nullptr || var == loop_var)) || node.as<Load>() != nullptr) {
+      invariant = false;
+    }
+  });
+  return invariant;
+}
+
+// buffers the value of a register is read from, e.g. the cmpmask buffer or a scalar the mask bits depend on
+std::vector<const Variable *> SourceBuffers(const Expr &e) {
+  std::vector<const Variable *> buffers;
+  PostOrderVisit(e, [&buffers](const NodeRef &node) {
+    if (const auto load = node.as<Load>()) {
+      buffers.push_back(load->buffer_var.get());
+    } else if (const auto ptr = node.as<Call>()) {
+      if (ptr->is_intrinsic(air::ir::intrinsic::tvm_access_ptr) && ptr->args.size() >= 2 &&
+          ptr->args[1].as<Variable>() != nullptr) {
+        buffers.push_back(ptr->args[1].as<Variable>());
+      }
+    }
+  });
+  return buffers;
+}
+
+/*
+ * Forward dataflow analysis of the vector mask, deqscale and cmpmask registers.
+ *
+ * The state at a point is the last set of each register, or undefined when the paths reaching the point
+ * disagree. Branches join at the end of an if, loops are iterated until the state at the loop head is stable,
+ * values that depend on variables do not survive the back edge. A value read from memory is dropped when a store
+ * or an intrinsic writes that buffer. A set is redundant when the register already holds the value on every
+ * path, i.e. for all occurrences of the call.
+ */
+class VecStateAnalyzer : public IRVisitor {
+ public:
+  void Analyze(const Stmt &stmt) {
+    state_ = VecState();
+    Visit(stmt);
+  }
+
+  void Visit_(const Evaluate *op) final {
+    const Call *call = op->value.as<Call>();
+    if (call == nullptr) {
+      IRVisitor::Visit_(op);
+      return;
+    }
+    int reg = GetStateSetter(call);
+    if (reg >= 0) {
+      if (record_) {
+        if (SameState(state_[reg], op->value)) {
+          redundant_.insert(call);
+        } else {
+          keep_.insert(call);
+        }
+      }
+      state_[reg] = op->value;
+      return;
+    }
+    if (call->name.find("vcmp") == 0 && call->name.find("vcmpv") != 0) {
+      // vcmp writes the compare result into cmpmask
+      state_[VS_CMPMASK] = Expr();
+    }
+    DropWrittenSources([call](const Variable *buf) { return WritesBuffer(call, buf); });
+  }
+
+  void Visit_(const Store *op) final {
+    const Variable *buf = op->buffer_var.get();
+    DropWrittenSources([buf](const Variable *src) { return src == buf; });
+    IRVisitor::Visit_(op);
+  }
+
+  void Visit_(const IfThenElse *op) final {
+    VecState init = state_;
+    Visit(op->then_case);
+    VecState then_state = state_;
+    state_ = init;
+    if (op->else_case.defined()) {
+      Visit(op->else_case);
+    }
+    Join(then_state);
+  }
+
+  void Visit_(const For *op) final {
+    VecState init = state_;
+    bool record = record_;
+    // the state only loses values, so it is stable after a few rounds
+    record_ = false;
+    for (int round = 0; round <= VS_NUM; ++round) {
+      VecState head = state_;
+      Visit(op->body);
+      DropVariant();
+      Join(init);
+      if (Same(head, state_)) break;
+    }
+    record_ = record;
+    if (record_) {
+      VecState head = state_;
+      Visit(op->body);
+      state_ = head;
+    }
+    // zero trips leave the state before the loop
+    Join(init);
+  }
+
+  std::unordered_set<const Call *> redundant_;
+  std::unordered_set<const Call *> keep_;
+
+ private:
+  static bool WritesBuffer(const Call *call, const Variable *buf) {
+    for (const auto &arg : call->args) {
+      // a plain buffer argument may be written
+      if (arg.as<Variable>() == buf) {
+        return true;
+      }
+      const Call *ptr = arg.as<Call>();
+      if (ptr == nullptr || !ptr->is_intrinsic(air::ir::intrinsic::tvm_access_ptr) || ptr->args.size() < 5 ||
+          ptr->args[1].as<Variable>() != buf) {
+        continue;
+      }
+      const auto rw = ptr->args[4].as<IntImm>();
+      if (rw == nullptr || (rw->value & 2) != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // drop the values read from a buffer that is written
+  template <typename F>
+  void DropWrittenSources(const F &writes) {
+    for (auto &value : state_) {
+      if (!value.defined()) continue;
+      for (const Variable *buf : SourceBuffers(value)) {
+        if (writes(buf)) {
+          value = Expr();
+          break;
+        }
+      }
+    }
+  }
+
+  void Join(const VecState &other) {
+    for (int i = 0; i < VS_NUM; ++i) {
+      if (!SameState(state_[i], other[i])) {
+        state_[i] = Expr();
+      }
+    }
+  }
+
+  void DropVariant() {
+    for (auto &value : state_) {
+      if (value.defined() && !IsInvariantState(value)) {
+        value = Expr();
+      }
+    }
+  }
+
+  static bool Same(const VecState &a, const VecState &b) {
+    for (int i = 0; i < VS_NUM; ++i) {
+      if (a[i].defined() != b[i].defined() || (a[i].defined() && !SameState(a[i], b[i]))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  VecState state_;
+  bool record_{true};
+};
+
+// hoist the sets of a register at the head of a loop body out of the loop, when the body sets it only there
+class VecStateHoist : public IRMutator {
+ public:
+  Stmt Mutate_(const For *op, const Stmt &s) final {
+    Stmt stmt = IRMutator::Mutate_(op, s);
+    op = stmt.as<For>();
+    CHECK(op);
+    const auto extent = op->extent.as<IntImm>();
+    if (extent == nullptr || extent->value <= 0) {
+      return stmt;
+    }
+    std::vector<Stmt> seq;
+    Flatten(op->body, &seq);
+    std::array<int, VS_NUM> num_set{};
+    PostOrderVisit(op->body, [&num_set](const NodeRef &node) {
+      const auto eval = node.as<Evaluate>();
+      const Call *call = eval != nullptr ? eval->value.as<Call>() : nullptr;
+      int reg = call != nullptr ? GetStateSetter(call) : -1;
+      if (reg >= 0) ++num_set[reg];
+    });
+    std::vector<Stmt> hoisted;
+    size_t head = 0;
+    for (; head < seq.size(); ++head) {
+      const auto eval = seq[head].as<Evaluate>();
+      const Call *call = eval != nullptr ? eval->value.as<Call>() : nullptr;
+      int reg = call != nullptr ? GetStateSetter(call) : -1;
+      // cmpmask comes from memory the body may write
+      if (reg < 0 || reg == VS_CMPMASK || num_set[reg] != 1 || !IsInvariantState(eval->value, op->loop_var.get())) {
+        break;
+      }
+      hoisted.push_back(seq[head]);
+    }
+    if (hoisted.empty()) {
+      return stmt;
+    }
+    ++num_hoisted_;
+    std::vector<Stmt> rest(seq.begin() + static_cast<std::ptrdiff_t>(head), seq.end());
+    Stmt body = rest.empty() ? Evaluate::make(0) : Block::make(rest);
+    hoisted.push_back(For::make(op->loop_var, op->min, op->extent, op->for_type, op->device_api, body));
+    return Block::make(hoisted);
+  }
+
+  int num_hoisted_{0};
+
+ private:
+  static void Flatten(const Stmt &s, std::vector<Stmt> *seq) {
+    if (const auto block = s.as<Block>()) {
+      Flatten(block->first, seq);
+      Flatten(block->rest, seq);
+    } else {
+      seq->emplace_back(s);
+    }
+  }
+};
+
+class VecStateElim : public IRMutator {
+ public:
+  explicit VecStateElim(const VecStateAnalyzer &analyzer) : analyzer_(analyzer) {}
+  ~VecStateElim() override = default;
+
+  Stmt Mutate_(const Evaluate *op, const Stmt &s) final {
+    const Call *call = op->value.as<Call>();
+    if (call != nullptr && analyzer_.redundant_.count(call) > 0 && analyzer_.keep_.count(call) == 0) {
+      ++num_removed_;
+      return Evaluate::make(0);
+    }
+    return s;
+  }
+
+  int num_removed_{0};
+
+ private:
+  const VecStateAnalyzer &analyzer_;
+};
+
 Stmt ElimVectorMask(Stmt stmt) {
   stmt = UniqueVecMask().Mutate(stmt);
   stmt = VecMaskElim().Elim(stmt);
+  // the same for all registers of the vector unit, over the whole control flow
+  VecStateHoist hoist;
+  stmt = hoist.Mutate(stmt);
+  VecStateAnalyzer analyzer;
+  analyzer.Analyze(stmt);
+  VecStateElim elim(analyzer);
+  stmt = elim.Mutate(stmt);
+  if (hoist.num_hoisted_ > 0 || elim.num_removed_ > 0) {
+    DLOG(INFO) << "ElimVectorMask hoisted sets out of " << hoist.num_hoisted_ << " loops, removed "
+               << elim.num_removed_ << " redundant sets";
+  }
   return RemoveNoOp(stmt);
 }
 }  // namespace ir
@@ -0,0 +1,254 @@
+/**
+ * Copyright 2026 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tvm/ir.h>
+#include <tvm/ir_pass.h>
+#include <tvm/ir_visitor.h>
+
+#include <string>
+#include <vector>
+
+#include "contrib/cce_parm/hardware_profile.h"
+#include "ir_pass.h"
+#include "pass/arch.h"
+#include "pass/common.h"
+
+namespace akg {
+namespace ir {
+namespace {
+// fractal of load2d and of the matrix outputs
+constexpr int64_t kFractalBytes = 512;
+constexpr int64_t kCubeFractal = 16;
+constexpr int64_t kFullMaskBits = Arch::Vector::MASK_LEN_IN_BITS;
+
+const char *const kPipeNames[] = {"", "pipe_s", "pipe_v", "pipe_m", "pipe_mte1", "pipe_mte2", "pipe_mte3"};
+constexpr int kNumPipes = PIPE_MTE3 + 1;
+
+Expr ToCycles(const Expr &e) { return e.type() == Int(64) ? e : Cast::make(Int(64), e); }
+}  // namespace
+
+/*
+ * Static cost model of lowered CCE IR.
+ *
+ * Every intrinsic is priced in cycles of its pipe and weighted by the trip counts of the enclosing loops, which
+ * stay symbolic for dynamic shapes. Dma are priced by bytes and bursts, vector instructions by repeats, the cube
+ * by fractals, all with the costs of the hardware profile. Both branches of an if are priced from the vector mask
+ * set before it, the more expensive one is kept. Costs of one block are summed per pipe; the pipes run in
+ * parallel, so the largest one bounds the block from below and their sum from above.
+ */
+class PerformanceEstimator : public IRVisitor {
+ public:
+  PerformanceEstimator() : cycles_(kNumPipes, Expr()) {}
+  ~PerformanceEstimator() override = default;
+
+  Map<std::string, Expr> Estimate(const Stmt &stmt) {
+    Visit(stmt);
+    Map<std::string, Expr> res;
+    Expr bound = make_const(Int(64), 0);
+    Expr serial = make_const(Int(64), 0);
+    for (int pipe = PIPE_S; pipe < kNumPipes; ++pipe) {
+      Expr cycles = Cycles(pipe);
+      res.Set(kPipeNames[pipe], cycles);
+      bound = Max::make(bound, cycles);
+      serial = serial + cycles;
+    }
+    bound = air::ir::Simplify(bound);
+    res.Set("block_bound", bound);
+    res.Set("block_serial", air::ir::Simplify(serial));
+    res.Set("pipe_v_effective", air::ir::Simplify(Sum(vector_lanes_) / make_const(Int(64), kFullMaskBits)));
+    res.Set("sync", air::ir::Simplify(Sum(sync_)));
+
+    Expr core_num = make_const(Int(64), std::max(profile_->getCoreNum(), 1));
+    Expr block_num = block_num_.defined() ? ToCycles(block_num_) : make_const(Int(64), 1);
+    res.Set("block_num", air::ir::Simplify(block_num));
+    res.Set("total", air::ir::Simplify(bound * ((block_num + core_num - 1) / core_num)));
+    return res;
+  }
+
+  void Visit_(const For *op) final {
+    Visit(op->min);
+    Expr outer = mult_;
+    mult_ = Mul(outer, ToCycles(op->extent));
+    Visit(op->body);
+    mult_ = outer;
+  }
+
+  void Visit_(const AttrStmt *op) final {
+    if (op->attr_key == air::ir::attr::thread_extent) {
+      const auto iv = op->node.as<IterVarNode>();
+      if (iv != nullptr && iv->var->name_hint == "blockIdx.x") {
+        block_num_ = op->value;
+      }
+    }
+    IRVisitor::Visit_(op);
+  }
+
+  void Visit_(const IfThenElse *op) final {
+    Visit(op->condition);
+    // only one branch runs, each of cycles, vector lanes and syncs takes the larger branch
+    std::vector<Expr> outer;
+    std::vector<Expr> outer_lanes;
+    std::vector<Expr> outer_sync;
+    outer.swap(cycles_);
+    outer_lanes.swap(vector_lanes_);
+    outer_sync.swap(sync_);
+    cycles_.assign(kNumPipes, Expr());
+    int64_t outer_mask = mask_bits_;
+    Visit(op->then_case);
+    std::vector<Expr> then_cycles(kNumPipes, Expr());
+    std::vector<Expr> then_lanes;
+    std::vector<Expr> then_sync;
+    then_cycles.swap(cycles_);
+    then_lanes.swap(vector_lanes_);
+    then_sync.swap(sync_);
+    int64_t then_mask = mask_bits_;
+    mask_bits_ = outer_mask;
+    if (op->else_case.defined()) {
+      Visit(op->else_case);
+    }
+    // the mask after the if is only known when both branches leave the same one
+    if (mask_bits_ != then_mask) {
+      mask_bits_ = kFullMaskBits;
+    }
+    for (int pipe = 0; pipe < kNumPipes; ++pipe) {
+      Expr branch = then_cycles[pipe];
+      if (cycles_[pipe].defined()) {
+        branch = branch.defined() ? Max::make(branch, cycles_[pipe]) : cycles_[pipe];
+      }
+      if (branch.defined()) {
+        outer[pipe] = outer[pipe].defined() ? outer[pipe] + branch : branch;
+      }
+    }
+    cycles_.swap(outer);
+    JoinBranches(then_lanes, &vector_lanes_, &outer_lanes);
+    JoinBranches(then_sync, &sync_, &outer_sync);
+  }
+
+  void Visit_(const Store *op) final {
+    Add(PIPE_S, make_const(Int(64), ScalarCycles()));
+    IRVisitor::Visit_(op);
+  }
+
+  void Visit_(const Evaluate *op) final {
+    const auto call = op->value.as<Call>();
+    if (call == nullptr || call->is_intrinsic(air::ir::intrinsic::tvm_access_ptr)) {
+      IRVisitor::Visit_(op);
+      return;
+    }
+    if (call->name == "set_vector_mask") {
+      mask_bits_ = GetVectorMaskBits(call);
+    } else if (call->name == "set_flag" || call->name == "wait_flag" || call->name == "pipe_barrier") {
+      sync_.emplace_back(mult_.defined() ? mult_ : make_const(Int(64), 1));
+      Add(PIPE_S, make_const(Int(64), ScalarCycles()));
+    } else {
+      PriceIntrinsic(call);
+    }
+  }
+
+ private:
+  Expr Mul(const Expr &a, const Expr &b) const { return a.defined() ? a * b : b; }
+
+  int64_t ScalarCycles() const { return profile_->getIntrinCost("scalar", "").latency; }
+
+  void Add(int pipe, const Expr &cost) {
+    if (pipe <= 0 || pipe >= kNumPipes) {
+      pipe = PIPE_S;
+    }
+    Expr c = Mul(mult_, cost);
+    cycles_[pipe] = cycles_[pipe].defined() ? cycles_[pipe] + c : c;
+  }
+
+  Expr Cycles(int pipe) const {
+    return cycles_[pipe].defined() ? air::ir::Simplify(cycles_[pipe]) : make_const(Int(64), 0);
+  }
+
+  static Expr Sum(const std::vector<Expr> &terms) {
+    Expr res = make_const(Int(64), 0);
+    for (const auto &t : terms) {
+      res = res + t;
+    }
+    return res;
+  }
+
+  // terms of the larger branch are appended to outer, which becomes the current list
+  static void JoinBranches(const std::vector<Expr> &then_terms, std::vector<Expr> *else_terms,
+                           std::vector<Expr> *outer) {
+    if (!then_terms.empty() || !else_terms->empty()) {
+      outer->emplace_back(Max::make(Sum(then_terms), Sum(*else_terms)));
+    }
+    else_terms->swap(*outer);
+  }
+
+  void PriceIntrinsic(const Call *call) {
+    int pipe = GetIntrinPipe(call->name);
+    if (pipe == PIPE_MTE1 || pipe == PIPE_MTE2 || pipe == PIPE_MTE3) {
+      Add(pipe, DmaCycles(call, pipe));
+    } else if (pipe == PIPE_V) {
+      Expr repeat = ToCycles(GetVectorRepeat(call));
+      cceconf::IntrinCost cost = profile_->getIntrinCost(call->name, GetIntrinDType(call));
+      Add(pipe, make_const(Int(64), cost.latency) + repeat * make_const(Int(64), cost.cycles_per_repeat));
+      vector_lanes_.emplace_back(Mul(mult_, repeat * make_const(Int(64), mask_bits_)));
+    } else if (pipe == PIPE_M && call->args.size() > 5) {
+      auto fractals = [](const Expr &e) {
+        return (ToCycles(e) + make_const(Int(64), kCubeFractal - 1)) / make_const(Int(64), kCubeFractal);
+      };
+      cceconf::IntrinCost cost = profile_->getIntrinCost(call->name, GetIntrinDType(call));
+      Expr fractal_num = fractals(call->args[3]) * fractals(call->args[4]) * fractals(call->args[5]);
+      Add(pipe, make_const(Int(64), cost.latency) + fractal_num * make_const(Int(64), cost.cycles_per_repeat));
+    } else {
+      Add(pipe, make_const(Int(64), ScalarCycles()));
+    }
+  }
+
+  /*
+   * copy_* take (dst, src, sid, nBurst, lenBurst, ...) with bursts of 32 bytes, or of a fractal out of L0C;
+   * load_* take (dst, src, baseIdx, repeat, ...) with one fractal per repeat.
+   */
+  Expr DmaCycles(const Call *call, int pipe) const {
+    // copy_gm_to_ubuf takes the path gm_to_ubuf
+    cceconf::DmaCost cost = profile_->getDmaCost(call->name.substr(call->name.find('_') + 1));
+    Expr bytes;
+    Expr bursts = make_const(Int(64), 1);
+    Expr n_burst;
+    Expr len_burst;
+    int64_t unit = 0;
+    if (GetCopyBursts(call, &n_burst, &len_burst, &unit)) {
+      bursts = ToCycles(n_burst);
+      bytes = bursts * ToCycles(len_burst) * make_const(Int(64), unit);
+    } else if (call->name.find("load_") == 0 && call->args.size() > 3) {
+      bytes = ToCycles(call->args[3]) * make_const(Int(64), kFractalBytes);
+    } else {
+      bytes = make_const(Int(64), kFractalBytes);
+    }
+    Expr cycles = make_const(Int(64), cost.startup) + bytes / make_const(Int(64), cost.bytes_per_cycle);
+    if (cost.burst_cycles != 0) {
+      cycles = cycles + bursts * make_const(Int(64), cost.burst_cycles);
+    }
+    return cycles;
+  }
+
+  // trip count of the enclosing loops, undefined outside of loops
+  Expr mult_;
+  std::vector<Expr> cycles_;
+  std::vector<Expr> vector_lanes_;
+  std::vector<Expr> sync_;
+  Expr block_num_;
+  int64_t mask_bits_{kFullMaskBits};
+  const cceconf::HardwareProfile *profile_{cceconf::HardwareProfile::getInstance()};
+};
+
+Map<std::string, Expr> EstimatePerformance(const Stmt &stmt) { return PerformanceEstimator().Estimate(stmt); }
+}  // namespace ir
+}  // namespace akg
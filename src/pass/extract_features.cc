@@ -0,0 +1,297 @@
+/**
+ * Copyright 2026 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tvm/ir.h>
+#include <tvm/ir_pass.h>
+#include <tvm/ir_visitor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+
+#include "emit_insn/cce_params.h"
+#include "ir_pass.h"
+#include "pass/arch.h"
+#include "pass/common.h"
+
+namespace akg {
+namespace ir {
+namespace {
+enum Feature {
+  kNumLoops = 0,
+  kMaxLoopDepth,
+  kNumDynamicLoops,
+  kInnermostExtent,
+  kTripCount,
+  kUbBytes,
+  kL1Bytes,
+  kL0aBytes,
+  kL0bBytes,
+  kL0cBytes,
+  kDmaCount,
+  kDmaBytes,
+  kDmaBursts,
+  kInsnS,
+  kInsnV,
+  kInsnM,
+  kInsnMte1,
+  kInsnMte2,
+  kInsnMte3,
+  kVectorRepeats,
+  kMaskDensity,
+  kBlockNum,
+  kPaddingWaste,
+  kNumFeatures
+};
+
+const char *const kFeatureNames[kNumFeatures] = {
+  "num_loops",   "max_loop_depth", "num_dynamic_loops", "innermost_extent", "trip_count",     "ub_bytes",
+  "l1_bytes",    "l0a_bytes",      "l0b_bytes",         "l0c_bytes",        "dma_count",      "dma_bytes",
+  "dma_bursts",  "insn_s",         "insn_v",            "insn_m",           "insn_mte1",      "insn_mte2",
+  "insn_mte3",   "vector_repeats", "mask_density",      "block_num",        "padding_waste"};
+
+// counts and sizes span orders of magnitude, the model sees their logarithm
+bool IsLogScale(int feature) {
+  return feature != kNumLoops && feature != kMaxLoopDepth && feature != kNumDynamicLoops &&
+         feature != kMaskDensity && feature != kPaddingWaste;
+}
+
+int ScopeFeature(const std::string &scope) {
+  static const std::unordered_map<std::string, int> scopes = {
+    {SCOPE_UBUF, kUbBytes}, {SCOPE_CBUF, kL1Bytes}, {SCOPE_CA, kL0aBytes},
+    {SCOPE_CB, kL0bBytes},  {SCOPE_CC, kL0cBytes}};
+  auto it = scopes.find(scope);
+  return it != scopes.end() ? it->second : -1;
+}
+
+double ConstOr(const Expr &e, double dft) {
+  if (const auto imm = e.as<IntImm>()) return static_cast<double>(imm->value);
+  if (const auto imm = e.as<UIntImm>()) return static_cast<double>(imm->value);
+  return dft;
+}
+}  // namespace
+
+/*
+ * Features of a kernel for learned cost models, at the post-poly stage (Realize/Provide) and after EmitInsn
+ * (Allocate/intrinsic calls). Counts are weighted by the trip counts of the enclosing loops; symbolic extents
+ * count once and are reported as dynamic loops.
+ */
+class FeatureExtractor : public IRVisitor {
+ public:
+  FeatureExtractor() {}
+  ~FeatureExtractor() override = default;
+
+  Array<Expr> Extract(const Stmt &stmt) {
+    Visit(stmt);
+    features_[kMaskDensity] = vector_lanes_ > 0 ? vector_lanes_ / (features_[kVectorRepeats] * kFullMaskBits) : 1.0;
+    features_[kPaddingWaste] = aligned_bytes_ > 0 ? (aligned_bytes_ - buffer_bytes_) / aligned_bytes_ : 0.0;
+    features_[kBlockNum] = std::max(features_[kBlockNum], 1.0);
+    Array<Expr> res;
+    for (int i = 0; i < kNumFeatures; ++i) {
+      double v = IsLogScale(i) ? std::log2(1.0 + features_[i]) : features_[i];
+      res.push_back(FloatImm::make(Float(32), v));
+    }
+    return res;
+  }
+
+  void Visit_(const For *op) final {
+    double extent = ConstOr(op->extent, -1.0);
+    features_[kNumLoops] += 1;
+    if (extent < 0) {
+      features_[kNumDynamicLoops] += 1;
+      extent = 1.0;
+    }
+    double outer = trips_;
+    trips_ *= extent;
+    ++depth_;
+    features_[kMaxLoopDepth] = std::max(features_[kMaxLoopDepth], static_cast<double>(depth_));
+    innermost_ = true;
+    Visit(op->body);
+    if (innermost_) {
+      features_[kInnermostExtent] = std::max(features_[kInnermostExtent], extent);
+    }
+    // the enclosing loop is not innermost
+    innermost_ = false;
+    --depth_;
+    trips_ = outer;
+  }
+
+  void Visit_(const AttrStmt *op) final {
+    if (op->attr_key == air::ir::attr::thread_extent) {
+      const auto iv = op->node.as<IterVarNode>();
+      if (iv != nullptr && iv->var->name_hint == "blockIdx.x") {
+        features_[kBlockNum] = ConstOr(op->value, 1.0);
+      }
+    } else if (op->attr_key == air::ir::attr::storage_scope || op->attr_key == air::ir::attr::realize_scope) {
+      const auto scope = op->value.as<StringImm>();
+      if (scope != nullptr) {
+        scopes_[op->node.get()] = scope->value;
+      }
+    }
+    IRVisitor::Visit_(op);
+  }
+
+  void Visit_(const Allocate *op) final {
+    double elems = 1.0;
+    for (const auto &ext : op->extents) {
+      elems *= ConstOr(ext, 1.0);
+    }
+    AddBuffer(op->buffer_var.get(), elems * op->type.bytes());
+    IRVisitor::Visit_(op);
+  }
+
+  void Visit_(const Realize *op) final {
+    double elems = 1.0;
+    for (const auto &range : op->bounds) {
+      elems *= ConstOr(range->extent, 1.0);
+    }
+    AddBuffer(op->func.get(), elems * op->type.bytes());
+    IRVisitor::Visit_(op);
+  }
+
+  void Visit_(const Provide *op) final {
+    features_[kTripCount] += trips_;
+    // post-poly: the scopes of the tensors tell the pipe, tensors without realize live in global memory
+    std::string dst = Scope(op->func.get());
+    bool src_global = false;
+    std::string src;
+    PostOrderVisit(op->value, [this, &src_global, &src](const NodeRef &node) {
+      const auto call = node.as<Call>();
+      if (call != nullptr && call->call_type == Call::Halide) {
+        std::string scope = Scope(call->func.get());
+        src_global = src_global || scope.empty();
+        src = scope;
+      }
+    });
+    double bytes = trips_ * op->value.type().bytes();
+    if (dst.empty()) {
+      AddDma(PIPE_MTE3, bytes);
+    } else if (src_global) {
+      AddDma(PIPE_MTE2, bytes);
+    } else if ((dst == SCOPE_CA || dst == SCOPE_CB) && src == SCOPE_CBUF) {
+      AddDma(PIPE_MTE1, bytes);
+    } else if (dst == SCOPE_CC) {
+      features_[kInsnM] += trips_;
+    } else {
+      features_[kInsnV] += trips_;
+    }
+    IRVisitor::Visit_(op);
+  }
+
+  void Visit_(const IfThenElse *op) final {
+    Visit(op->condition);
+    // both branches are counted, each from the mask set before the if
+    double outer_mask = mask_bits_;
+    Visit(op->then_case);
+    double then_mask = mask_bits_;
+    mask_bits_ = outer_mask;
+    if (op->else_case.defined()) {
+      Visit(op->else_case);
+    }
+    // the mask after the if is only known when both branches leave the same one
+    if (mask_bits_ != then_mask) {
+      mask_bits_ = kFullMaskBits;
+    }
+  }
+
+  void Visit_(const Store *op) final {
+    features_[kTripCount] += trips_;
+    features_[kInsnS] += trips_;
+    IRVisitor::Visit_(op);
+  }
+
+  void Visit_(const Evaluate *op) final {
+    const auto call = op->value.as<Call>();
+    if (call == nullptr || call->is_intrinsic(air::ir::intrinsic::tvm_access_ptr)) {
+      IRVisitor::Visit_(op);
+      return;
+    }
+    features_[kTripCount] += trips_;
+    if (call->name == INTRIN_NAME_SET_VEC_MASK) {
+      mask_bits_ = GetVectorMaskBits(call);
+      return;
+    }
+    int pipe = GetIntrinPipe(call->name);
+    if (pipe == PIPE_MTE1 || pipe == PIPE_MTE2 || pipe == PIPE_MTE3) {
+      double bursts = 1.0;
+      double bytes = 0.0;
+      Expr n_burst;
+      Expr len_burst;
+      int64_t unit = 0;
+      if (GetCopyBursts(call, &n_burst, &len_burst, &unit)) {
+        bursts = ConstOr(n_burst, 1.0);
+        bytes = bursts * ConstOr(len_burst, 1.0) * unit;
+      }
+      AddDma(pipe, trips_ * bytes, trips_ * bursts);
+    } else if (pipe == PIPE_V) {
+      double repeat = ConstOr(GetVectorRepeat(call), 1.0);
+      features_[kInsnV] += trips_;
+      features_[kVectorRepeats] += trips_ * repeat;
+      vector_lanes_ += trips_ * repeat * mask_bits_;
+    } else if (pipe == PIPE_M) {
+      features_[kInsnM] += trips_;
+    } else {
+      features_[kInsnS] += trips_;
+    }
+  }
+
+ private:
+  static constexpr double kFullMaskBits = Arch::Vector::MASK_LEN_IN_BITS;
+
+  std::string Scope(const Node *node) const {
+    auto it = scopes_.find(node);
+    return it != scopes_.end() ? it->second : std::string();
+  }
+
+  void AddBuffer(const Node *node, double bytes) {
+    int feature = ScopeFeature(Scope(node));
+    if (feature < 0) {
+      return;
+    }
+    features_[feature] += bytes;
+    buffer_bytes_ += bytes;
+    aligned_bytes_ += std::ceil(bytes / Arch::Vector::BLOCK_SIZE) * Arch::Vector::BLOCK_SIZE;
+  }
+
+  void AddDma(int pipe, double bytes, double bursts = 0.0) {
+    features_[kDmaCount] += trips_;
+    features_[kDmaBytes] += bytes;
+    features_[kDmaBursts] += bursts > 0 ? bursts : trips_;
+    features_[pipe == PIPE_MTE1 ? kInsnMte1 : (pipe == PIPE_MTE2 ? kInsnMte2 : kInsnMte3)] += trips_;
+  }
+
+  double features_[kNumFeatures]{0};
+  std::unordered_map<const Node *, std::string> scopes_;
+  double trips_{1.0};
+  int depth_{0};
+  bool innermost_{false};
+  double vector_lanes_{0};
+  double mask_bits_{kFullMaskBits};
+  double buffer_bytes_{0};
+  double aligned_bytes_{0};
+};
+
+Array<Expr> ExtractFeatures(const Stmt &stmt) { return FeatureExtractor().Extract(stmt); }
+
+Array<Expr> FeatureNames() {
+  Array<Expr> res;
+  for (auto name : kFeatureNames) {
+    res.push_back(StringImm::make(name));
+  }
+  return res;
+}
+}  // namespace ir
+}  // namespace akg
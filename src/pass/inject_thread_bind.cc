@@ -21,9 +21,12 @@
 #include <tvm/arithmetic.h>
 
 #include <climits>
+#include <functional>
+#include <numeric>
+#include <sstream>
 
 #include "ir_pass.h"
-#include "contrib/cce_parm/cceconf.h"
+#include "contrib/cce_parm/hardware_profile.h"
 #include "pass/utils.h"
 #include "pass/ir_util.h"
 #include "pass/expr_alg_simplify.h"
@@ -32,6 +35,8 @@
 namespace akg {
 namespace ir {
 constexpr auto GM_ACCESS_MIN_SIZE = 32;
+// scalar cycles of one index operation (mul, add, div, mod, compare) on a block axis
+constexpr int64_t kIndexOpCycles = 1;
 
 class MultiCoreAccessFinder : public IRVisitor {
  public:
@@ -129,9 +134,56 @@ class MultiCoreAccessFinder : public IRVisitor {
   bool atomic_{false};
 };
 
+// Rough cycles of one run of stmt: an emit_insn region costs one cycle per 32 bytes it stores, at least one.
+class InsnCycleEstimator : public IRVisitor {
+ public:
+  int64_t Estimate(const Stmt &stmt) {
+    cycles_ = 0;
+    Visit(stmt);
+    return std::max<int64_t>(cycles_, 1);
+  }
+
+ private:
+  void Visit_(const For *op) final {
+    const auto ext = op->extent.as<IntImm>();
+    int64_t extent = ext ? std::max<int64_t>(ext->value, 1) : 1;
+    trip_ *= extent;
+    IRVisitor::Visit_(op);
+    trip_ /= extent;
+  }
+
+  void Visit_(const AttrStmt *op) final {
+    if (op->attr_key != "pragma_emit_insn" || in_insn_) {
+      IRVisitor::Visit_(op);
+      return;
+    }
+    // trip counts inside the region are the elements of one instruction
+    int64_t outer_trip = trip_;
+    trip_ = 1;
+    bytes_ = 0;
+    in_insn_ = true;
+    IRVisitor::Visit_(op);
+    in_insn_ = false;
+    trip_ = outer_trip;
+    cycles_ += outer_trip * std::max<int64_t>((bytes_ + GM_ACCESS_MIN_SIZE - 1) / GM_ACCESS_MIN_SIZE, 1);
+  }
+
+  void Visit_(const Store *op) final {
+    if (in_insn_) {
+      bytes_ = std::max<int64_t>(bytes_, trip_ * op->value.type().bytes());
+    }
+    IRVisitor::Visit_(op);
+  }
+
+  int64_t cycles_{0};
+  int64_t trip_{1};
+  int64_t bytes_{0};
+  bool in_insn_{false};
+};
+
 class MultiCorePlan : public IRVisitor {
  public:
-  explicit MultiCorePlan(int proposal) : proposal_(proposal) {}
+  MultiCorePlan(int proposal, bool balance) : proposal_(proposal), balance_(balance) {}
   ~MultiCorePlan() override = default;
 
   void Plan(const Stmt &stmt) {
@@ -150,10 +202,27 @@ class MultiCorePlan : public IRVisitor {
     }
     GenerateBlockCoef();
     LOG(INFO) << "Set " << proposal_ << " core, actually use " << block_num_ << " core";
+    DLOG(INFO) << "Multi-core plan: " << Dump();
+  }
+
+  std::string Dump() const {
+    std::ostringstream os;
+    os << (fuse_depth_ > 0 ? "fused" : "nested") << " block_num=" << block_num_ << " work_per_core=" << work_per_core_
+       << " cycles_per_core=" << cycles_per_core_ << " axes=[";
+    for (size_t i = 0; i < block_coef_.size(); ++i) {
+      os << (i > 0 ? ", " : "") << block_coef_[i].first->loop_var->name_hint << ":" << block_coef_[i].first->extent;
+      if (fuse_depth_ == 0) {
+        os << "/" << block_coef_[i].second;
+      }
+    }
+    os << "]";
+    return os.str();
   }
 
   std::vector<std::pair<const For *, int>> block_coef_;
   int block_num_{0};
+  // > 0: the outer fuse_depth_ block axes are fused and split into balanced chunks over block_num_ cores
+  int fuse_depth_{0};
 
  private:
   void Visit_(const For *op) final {
@@ -243,6 +312,91 @@ class MultiCorePlan : public IRVisitor {
   }
 
   void GenerateBlockCoef() {
+    std::vector<int64_t> extents;
+    for (const auto &node : block_axis_) {
+      if (!node->extent.as<IntImm>()) break;
+      extents.push_back(node->extent.as<IntImm>()->value);
+    }
+    GenerateNestedBlockCoef();
+    if (extents.empty() || block_num_ <= 0) return;
+
+    // work of one core in iterations of the innermost block axis, the core with the longest tail counts
+    std::vector<int64_t> chunks(extents);
+    int64_t nested_index_ops = 0;
+    for (size_t i = 0; i < block_coef_.size(); ++i) {
+      int64_t coef = block_coef_[i].second;
+      chunks[i] = (extents[i] + coef - 1) / coef;
+      // a split axis computes its index from blockIdx, an uneven one guards its tail
+      if (coef != extents[i]) {
+        nested_index_ops += kIndexOpCycles * (extents[i] % coef != 0 ? 3 : 2);
+      }
+    }
+    work_per_core_ = std::accumulate(chunks.begin(), chunks.end(), int64_t{1}, std::multiplies<int64_t>());
+    int64_t body_cycles = InsnCycleEstimator().Estimate(block_axis_[extents.size() - 1]->body);
+    cycles_per_core_ = work_per_core_ * (body_cycles + nested_index_ops);
+    if (!balance_) return;
+
+    // fusing the outer axes lets the cores share all of their iterations instead of whole rows
+    int best_depth = 0;
+    int64_t best_blocks = 0;
+    int64_t best_work = work_per_core_;
+    int64_t best_cycles = cycles_per_core_;
+    int64_t fused = 1;
+    for (size_t depth = 1; depth <= extents.size(); ++depth) {
+      const For *axis = block_axis_[depth - 1];
+      if (!is_zero(axis->min) || axis->loop_var->name_hint == "comp_idx" ||
+          (depth > 1 && !PerfectlyNested(block_axis_[depth - 2], axis))) {
+        break;
+      }
+      fused *= extents[depth - 1];
+      if (fused > INT_MAX) break;
+      if (depth == 1) continue;
+      int64_t blocks = std::min<int64_t>(proposal_, fused);
+      int64_t chunk = (fused + blocks - 1) / blocks;
+      // the same chunk with fewer cores
+      blocks = (fused + chunk - 1) / chunk;
+      int64_t inner = 1;
+      for (size_t i = depth; i < extents.size(); ++i) {
+        inner *= extents[i];
+      }
+      // each fused iteration divides its position once per axis and takes it modulo the extent of the inner ones,
+      // an uneven split also tests the guard of the last iteration
+      int64_t index_ops = kIndexOpCycles * (2 * static_cast<int64_t>(depth) + (fused % blocks != 0 ? 3 : 0));
+      int64_t cycles = chunk * (inner * body_cycles + index_ops);
+      if (blocks > 1 && (cycles < best_cycles || (cycles == best_cycles && best_depth > 0 && blocks < best_blocks))) {
+        best_depth = static_cast<int>(depth);
+        best_blocks = blocks;
+        best_work = chunk * inner;
+        best_cycles = cycles;
+      }
+    }
+    if (best_depth == 0) return;
+    fuse_depth_ = best_depth;
+    block_num_ = static_cast<int>(best_blocks);
+    work_per_core_ = best_work;
+    cycles_per_core_ = best_cycles;
+    block_coef_.clear();
+    for (int i = 0; i < best_depth; ++i) {
+      block_coef_.emplace_back(std::make_pair(block_axis_[i], 0));
+    }
+  }
+
+  // inner is the only statement of outer, apart from attributes and lets
+  static bool PerfectlyNested(const For *outer, const For *inner) {
+    Stmt body = outer->body;
+    while (true) {
+      if (body.get() == inner) return true;
+      if (auto attr = body.as<AttrStmt>()) {
+        body = attr->body;
+      } else if (auto let = body.as<LetStmt>()) {
+        body = let->body;
+      } else {
+        return false;
+      }
+    }
+  }
+
+  void GenerateNestedBlockCoef() {
     // determine block num of each level (i.e. loop depth)
     int last_coef = 1;
     for (const auto &node : block_axis_) {
@@ -283,18 +437,25 @@ class MultiCorePlan : public IRVisitor {
   int cur_level_{0};
   int split_level_{-1};
   int proposal_;
+  // fuse the outer block axes when that shortens the longest core, see GenerateBlockCoef
+  bool balance_;
+  int64_t work_per_core_{0};
+  int64_t cycles_per_core_{0};
   // poly set some axis is dependence free. this info can make dep analyze more precise
   std::unordered_set<const For *> dep_free_axis_;
 };
 
 class MultiCoreInsert : public IRMutator {
  public:
-  MultiCoreInsert(int block_num, std::vector<std::pair<const For *, int>> &block_coef)
-      : block_num_(block_num), block_coef_(block_coef) {}
+  MultiCoreInsert(int block_num, std::vector<std::pair<const For *, int>> &block_coef, int fuse_depth = 0)
+      : block_num_(block_num), block_coef_(block_coef), fuse_depth_(fuse_depth) {}
   ~MultiCoreInsert() override = default;
 
   Stmt Insert(Stmt stmt) {
     IterVar block_idx = air::thread_axis(Range(), "blockIdx.x");
+    if (fuse_depth_ > 0) {
+      return InsertFused(block_idx, stmt);
+    }
     // determine loop var replacement
     Expr this_level_iv = block_idx;
     for (int i = static_cast<int>(block_coef_.size()) - 1; i >= 0; i--) {
@@ -317,6 +478,52 @@ class MultiCoreInsert : public IRMutator {
     return AttrStmt::make(block_idx, "thread_extent", block_num_, stmt);
   }
 
+  // The outer axes are fused into total iterations. Core b runs [b * base + min(b, rem), +base + (b < rem)),
+  // so the core counts of any two cores differ by at most one iteration.
+  Stmt InsertFused(const IterVar &block_idx, Stmt stmt) {
+    CHECK_EQ(static_cast<int>(block_coef_.size()), fuse_depth_);
+    int64_t total = 1;
+    for (const auto &level : block_coef_) {
+      CHECK(level.first->extent.as<IntImm>());
+      total *= level.first->extent.as<IntImm>()->value;
+    }
+    CHECK_LE(total, INT_MAX);
+    CHECK_GT(block_num_, 0);
+    fused_base_ = static_cast<int>(total / block_num_);
+    fused_rem_ = static_cast<int>(total % block_num_);
+    Expr idx = block_idx->var;
+    fused_begin_ = fused_rem_ > 0 ? idx * fused_base_ + Min::make(idx, make_const(Int(32), fused_rem_))
+                                  : idx * fused_base_;
+    fused_block_idx_ = idx;
+    fused_pos_ = Var("fused_pos", Int(32));
+    int64_t stride = 1;
+    for (int i = fuse_depth_ - 1; i >= 0; i--) {
+      const For *op = block_coef_[i].first;
+      int64_t extent = op->extent.as<IntImm>()->value;
+      Expr level_idx = truncdiv(fused_pos_, make_const(Int(32), stride));
+      replace_[op->loop_var.get()] = i > 0 ? truncmod(level_idx, make_const(Int(32), extent)) : level_idx;
+      stride *= extent;
+    }
+    stmt = Mutate(stmt);
+    return AttrStmt::make(block_idx, "thread_extent", block_num_, stmt);
+  }
+
+  Stmt MutateFusedFor(const For *op) {
+    cur_layer_++;
+    Stmt body = Mutate(op->body);
+    if (cur_layer_ - 1 > 0) {
+      return body;
+    }
+    // outermost fused axis: a single loop over the iterations of this core
+    Var fused_idx("fused_idx", Int(32));
+    body = LetStmt::make(fused_pos_, fused_begin_ + fused_idx, body);
+    if (fused_rem_ > 0) {
+      body = IfThenElse::make(Or::make(fused_idx < fused_base_, fused_block_idx_ < fused_rem_), body);
+    }
+    return For::make(fused_idx, make_zero(Int(32)), make_const(Int(32), fused_base_ + (fused_rem_ > 0 ? 1 : 0)),
+                     op->for_type, op->device_api, body);
+  }
+
   Stmt Mutate_(const AttrStmt *op, const Stmt &stmt) final {
     if (op->attr_key == "pragma_multi_core_depth") {
       return Mutate(op->body);
@@ -333,6 +540,10 @@ class MultiCoreInsert : public IRMutator {
   }
 
   Stmt Mutate_(const For *op, const Stmt &stmt) final {
+    if (cur_layer_ < static_cast<int>(block_coef_.size()) && fuse_depth_ > 0) {
+      CHECK(block_coef_[cur_layer_].first == op);
+      return MutateFusedFor(op);
+    }
     if (cur_layer_ < static_cast<int>(block_coef_.size())) {
       CHECK(block_coef_[cur_layer_].first == op);
       int coef = block_coef_[cur_layer_].second;
@@ -365,6 +576,12 @@ class MultiCoreInsert : public IRMutator {
   int block_num_;
   std::vector<std::pair<const For *, int>> &block_coef_;
   std::unordered_map<const Variable *, Expr> replace_;
+  int fuse_depth_;
+  int fused_base_{0};
+  int fused_rem_{0};
+  Expr fused_begin_;
+  Expr fused_block_idx_;
+  Var fused_pos_;
 };
 
 /*
@@ -1420,7 +1637,8 @@ class ScalarPeel : public IRMutator {
   }
 };
 
-Stmt InjectMultiCore(Stmt stmt, int max_block_dim, int merge_outer_loop, bool is_dynamic, bool scalar_rearrange) {
+Stmt InjectMultiCore(Stmt stmt, int max_block_dim, int merge_outer_loop, bool is_dynamic, bool scalar_rearrange,
+                     bool balance) {
   std::vector<Stmt> outer_stmts;
   if (is_dynamic) {
     stmt = PeelOuterLetAttr(stmt, outer_stmts);
@@ -1442,16 +1660,14 @@ Stmt InjectMultiCore(Stmt stmt, int max_block_dim, int merge_outer_loop, bool is
 
   int proposal_block = max_block_dim;
   if (max_block_dim < 1) {
-    cceconf::CceConf *conf = cceconf::CceConf::getInstance();
-    CHECK(conf);
-    proposal_block = conf->getCoreValue("Core_num");
+    proposal_block = cceconf::HardwareProfile::getInstance()->getCoreNum();
   }
   if (!is_dynamic) {
     stmt = LoopCompounder(proposal_block).Mutate(stmt);
-    MultiCorePlan plan(proposal_block);
+    MultiCorePlan plan(proposal_block, balance);
     plan.Plan(stmt);
     if (plan.block_num_ > 1) {
-      stmt = MultiCoreInsert(plan.block_num_, plan.block_coef_).Insert(stmt);
+      stmt = MultiCoreInsert(plan.block_num_, plan.block_coef_, plan.fuse_depth_).Insert(stmt);
     }
     stmt = LoopUnCompunder().Mutate(stmt);
     if (scalar_rearrange && scalar_part.defined()) {
@@ -15,6 +15,11 @@
  */
 #include "pass/common.h"
 
+#include <sstream>
+#include <unordered_set>
+
+#include "pass/arch.h"
+
 namespace akg {
 namespace ir {
 // {inst name , pipe}
@@ -102,5 +107,72 @@ int GetIntrinPipe(std::string insn) {
 
   return 0;
 }
+
+int GetVectorRepeatIndex(const Call *call) {
+  // intrinsics with a scalar operand between the buffers and the repeat
+  static const std::unordered_set<std::string> scalar_insn = {"vector_dup", "vadds", "vmuls", "vmaxs",
+                                                              "vmins",      "vaxpy", "vshl",  "vshr"};
+  CHECK(call);
+  size_t idx = 0;
+  while (idx < call->args.size()) {
+    const auto ptr = call->args[idx].as<Call>();
+    if (ptr == nullptr || !ptr->is_intrinsic(air::ir::intrinsic::tvm_access_ptr)) break;
+    ++idx;
+  }
+  if (scalar_insn.count(call->name) > 0) ++idx;
+  if (idx < call->args.size() && call->args[idx].type().is_int()) {
+    return static_cast<int>(idx);
+  }
+  return -1;
+}
+
+Expr GetVectorRepeat(const Call *call) {
+  int idx = GetVectorRepeatIndex(call);
+  if (idx >= 0) {
+    return call->args[idx];
+  }
+  return make_const(Int(32), 1);
+}
+
+std::string GetIntrinDType(const Call *call) {
+  CHECK(call);
+  std::ostringstream os;
+  for (const auto &arg : call->args) {
+    const auto ptr = arg.as<Call>();
+    if (ptr != nullptr && ptr->is_intrinsic(air::ir::intrinsic::tvm_access_ptr) && !ptr->args.empty()) {
+      os << ptr->args[0].type();
+      break;
+    }
+  }
+  return os.str();
+}
+
+int GetVectorMaskBits(const Call *call) {
+  CHECK(call);
+  auto pop_count = [](uint64_t v) {
+    int n = 0;
+    for (; v != 0; v &= v - 1) ++n;
+    return n;
+  };
+  if (call->args.size() == 2) {
+    const auto hi = call->args[0].as<UIntImm>();
+    const auto lo = call->args[1].as<UIntImm>();
+    if (hi != nullptr && lo != nullptr) {
+      return pop_count(hi->value) + pop_count(lo->value);
+    }
+  }
+  return Arch::Vector::MASK_LEN_IN_BITS;
+}
+
+bool GetCopyBursts(const Call *call, Expr *n_burst, Expr *len_burst, int64_t *unit) {
+  CHECK(call && n_burst && len_burst && unit);
+  if (call->name.find("copy_") != 0 || call->args.size() <= 4) {
+    return false;
+  }
+  *n_burst = call->args[3];
+  *len_burst = call->args[4];
+  *unit = call->name.find("cc") != std::string::npos ? Arch::Matrix::BLOCK_SIZE_16 : Arch::Vector::BLOCK_SIZE;
+  return true;
+}
 }  // namespace ir
 }  // namespace akg
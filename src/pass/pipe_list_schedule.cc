@@ -0,0 +1,383 @@
+/**
+ * Copyright 2026 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tvm/ir.h>
+#include <tvm/ir_mutator.h>
+#include <tvm/ir_pass.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "contrib/cce_parm/hardware_profile.h"
+#include "ir_pass.h"
+#include "pass/common.h"
+
+namespace akg {
+namespace ir {
+using air::ir::attr::coproc_scope;
+
+namespace {
+// instructions of longer runs are scheduled in windows, dependence checks are quadratic
+constexpr size_t kMaxScheduleWindow = 256;
+// the scalar unit issues one instruction per cycle
+constexpr int64_t kIssueCycles = 1;
+// event ids InjectSync has for each pair of pipes
+constexpr size_t kEventNum = 4;
+
+/*
+ * Rough cycles from issue to completion of one instruction on each pipe, from the hardware profile.
+ * Only the ratios between pipes matter for the order of the schedule.
+ */
+int64_t PipeLatency(int pipe) {
+  static const char *const pipe_names[] = {"pipe_s", "pipe_s", "pipe_v", "pipe_m", "pipe_mte1", "pipe_mte2",
+                                           "pipe_mte3"};
+  const char *name = (pipe >= PIPE_S && pipe <= PIPE_MTE3) ? pipe_names[pipe] : "pipe_s";
+  return cceconf::HardwareProfile::getInstance()->getPipeLatency(name);
+}
+
+int GetPipe(const Stmt &stmt) {
+  const auto attr = stmt.as<AttrStmt>();
+  if (attr == nullptr || attr->attr_key != coproc_scope) {
+    return -1;
+  }
+  const auto pipe = attr->value.as<IntImm>();
+  return pipe != nullptr ? static_cast<int>(pipe->value) : -1;
+}
+
+// scalar and all-pipe instructions touch registers the dataflow analysis does not see, they stay in place
+bool IsSchedulable(const Stmt &stmt) {
+  int pipe = GetPipe(stmt);
+  return pipe == PIPE_V || pipe == PIPE_M || pipe == PIPE_MTE1 || pipe == PIPE_MTE2 || pipe == PIPE_MTE3;
+}
+}  // namespace
+
+/*
+ * List scheduler of the instructions of a sequence.
+ *
+ * Runs of consecutive coproc instructions are reordered across pipes. The dependence DAG has an edge for
+ * every memory dependence found by the dataflow analysis and keeps the order of instructions on the same
+ * pipe, which execute in order anyway. A cross-pipe edge becomes a wait_flag in InjectSync that blocks the
+ * issue of all later instructions, so the schedule picks the instruction that can start earliest, then the
+ * one on the longest path. A run is only rewritten when its estimated critical path gets shorter and
+ * InjectSync needs no more syncs and barriers for the new order than for the old one.
+ */
+class PipeListScheduler : public IRMutator {
+ public:
+  explicit PipeListScheduler(const Stmt &stmt) : df_(BuildDfAnalyzer(stmt, false)) {}
+  ~PipeListScheduler() override = default;
+
+  Stmt Mutate_(const AttrStmt *op, const Stmt &s) final {
+    if (op->attr_key == coproc_scope) {
+      return s;
+    }
+    return IRMutator::Mutate_(op, s);
+  }
+
+  Stmt Mutate_(const Block *op, const Stmt &s) final {
+    std::vector<Stmt> seq;
+    Flatten(s, &seq);
+    std::vector<Stmt> res;
+    std::vector<Stmt> run;
+    bool changed = false;
+    for (const auto &stmt : seq) {
+      if (IsSchedulable(stmt)) {
+        run.emplace_back(stmt);
+        if (run.size() == kMaxScheduleWindow) {
+          changed = Flush(&run, &res) || changed;
+        }
+        continue;
+      }
+      changed = Flush(&run, &res) || changed;
+      Stmt new_stmt = Mutate(stmt);
+      changed = changed || !new_stmt.same_as(stmt);
+      res.emplace_back(new_stmt);
+    }
+    changed = Flush(&run, &res) || changed;
+    return changed ? Block::make(res) : s;
+  }
+
+  void DumpStatistics() const {
+    if (num_reordered_ == 0 && num_rejected_ == 0) {
+      return;
+    }
+    DLOG(INFO) << "PipeListSchedule reordered " << num_reordered_ << " runs, estimated cycles " << cycles_before_
+               << " -> " << cycles_after_ << ", issue stalls " << stalls_before_ << " -> " << stalls_after_
+               << ", syncs " << syncs_before_ << " -> " << syncs_after_ << ", rejected " << num_rejected_
+               << " runs that need more syncs";
+  }
+
+ private:
+  struct Insn {
+    const AttrStmt *attr;
+    int pipe;
+    int64_t latency;
+    std::vector<size_t> deps;  // memory dependences only, preds also orders the instructions of a pipe
+    std::vector<size_t> preds;
+    std::vector<size_t> succs;
+    int64_t priority;
+  };
+
+  struct Estimate {
+    int64_t cycles{0};
+    int64_t stalls{0};
+    int64_t syncs{0};
+    int64_t barriers{0};
+  };
+
+  static void Flatten(const Stmt &s, std::vector<Stmt> *seq) {
+    if (const auto block = s.as<Block>()) {
+      Flatten(block->first, seq);
+      Flatten(block->rest, seq);
+    } else {
+      seq->emplace_back(s);
+    }
+  }
+
+  class Simulator {
+   public:
+    explicit Simulator(const std::vector<Insn> &insns) : insns_(insns), finish_(insns.size(), 0) {}
+
+    // cycle the instruction starts at when it is issued next
+    int64_t StartTime(size_t idx, int64_t *issue) const {
+      const Insn &insn = insns_[idx];
+      int64_t ready = issue_;
+      for (auto p : insn.preds) {
+        if (insns_[p].pipe != insn.pipe) {
+          ready = std::max(ready, finish_[p]);
+        }
+      }
+      if (issue != nullptr) {
+        *issue = ready;
+      }
+      return std::max(ready, pipe_free_[insn.pipe]);
+    }
+
+    void Issue(size_t idx) {
+      int64_t ready = 0;
+      int64_t start = StartTime(idx, &ready);
+      if (ready > issue_) {
+        ++estimate_.stalls;
+      }
+      const Insn &insn = insns_[idx];
+      finish_[idx] = start + insn.latency;
+      pipe_free_[insn.pipe] = finish_[idx];
+      issue_ = ready + kIssueCycles;
+      estimate_.cycles = std::max(estimate_.cycles, finish_[idx]);
+    }
+
+    Estimate Result() const { return estimate_; }
+
+   private:
+    const std::vector<Insn> &insns_;
+    std::vector<int64_t> finish_;
+    int64_t pipe_free_[PIPE_ALL + 1]{0};
+    int64_t issue_{0};
+    Estimate estimate_;
+  };
+
+  std::vector<Insn> BuildDag(const std::vector<Stmt> &run) {
+    std::vector<Insn> insns;
+    insns.reserve(run.size());
+    for (const auto &stmt : run) {
+      int pipe = GetPipe(stmt);
+      insns.emplace_back(Insn{stmt.as<AttrStmt>(), pipe, PipeLatency(pipe), {}, {}, {}, 0});
+    }
+    for (size_t j = 0; j < insns.size(); ++j) {
+      for (size_t i = 0; i < j; ++i) {
+        bool dep = df_->DepForward(insns[i].attr, insns[j].attr);
+        if (dep) {
+          insns[j].deps.emplace_back(i);
+        }
+        if (dep || insns[i].pipe == insns[j].pipe) {
+          insns[j].preds.emplace_back(i);
+          insns[i].succs.emplace_back(j);
+        }
+      }
+    }
+    // longest path to the end of the run
+    for (size_t k = insns.size(); k > 0; --k) {
+      Insn &insn = insns[k - 1];
+      int64_t tail = 0;
+      for (auto s : insn.succs) {
+        tail = std::max(tail, insns[s].priority);
+      }
+      insn.priority = insn.latency + tail;
+    }
+    return insns;
+  }
+
+  static std::vector<size_t> ListSchedule(const std::vector<Insn> &insns, Estimate *estimate) {
+    Simulator sim(insns);
+    std::vector<size_t> pending(insns.size());
+    for (size_t i = 0; i < insns.size(); ++i) {
+      pending[i] = insns[i].preds.size();
+    }
+    std::vector<size_t> ready;
+    for (size_t i = 0; i < insns.size(); ++i) {
+      if (pending[i] == 0) ready.emplace_back(i);
+    }
+    std::vector<size_t> order;
+    order.reserve(insns.size());
+    while (!ready.empty()) {
+      size_t best = 0;
+      int64_t best_start = sim.StartTime(ready[0], nullptr);
+      for (size_t k = 1; k < ready.size(); ++k) {
+        int64_t start = sim.StartTime(ready[k], nullptr);
+        const Insn &cur = insns[ready[k]];
+        const Insn &sel = insns[ready[best]];
+        if (start < best_start || (start == best_start && (cur.priority > sel.priority ||
+                                                           (cur.priority == sel.priority && ready[k] < ready[best])))) {
+          best = k;
+          best_start = start;
+        }
+      }
+      size_t idx = ready[best];
+      ready.erase(ready.begin() + static_cast<std::ptrdiff_t>(best));
+      sim.Issue(idx);
+      order.emplace_back(idx);
+      for (auto s : insns[idx].succs) {
+        if (--pending[s] == 0) ready.emplace_back(s);
+      }
+    }
+    CHECK_EQ(order.size(), insns.size());
+    *estimate = sim.Result();
+    return order;
+  }
+
+  static Estimate SourceOrder(const std::vector<Insn> &insns) {
+    Simulator sim(insns);
+    for (size_t i = 0; i < insns.size(); ++i) {
+      sim.Issue(i);
+    }
+    return sim.Result();
+  }
+
+  /*
+   * Counts the syncs and barriers InjectSync inserts for the run issued in this order. A dependence needs
+   * none when the producer is already known to complete before the consumer starts: it is ordered before
+   * an instruction the consumer waits for, through earlier syncs and barriers. The syncs themselves only
+   * depend on the order within each pipe, which the schedule keeps; what the order changes is how many
+   * events of a pair of pipes are in flight at once. A sync that finds no free event id reuses an older
+   * event or falls back to a barrier of all pipes, it is counted as a barrier.
+   */
+  static void CountSyncs(const std::vector<Insn> &insns, const std::vector<size_t> &order, Estimate *estimate) {
+    std::vector<size_t> pos(insns.size());
+    for (size_t k = 0; k < order.size(); ++k) {
+      pos[order[k]] = k;
+    }
+    // done[k][pipe]: instructions of the pipe issued before this position complete before order[k] starts
+    std::vector<std::vector<size_t>> done(order.size(), std::vector<size_t>(PIPE_ALL + 1, 0));
+    std::vector<int64_t> last(PIPE_ALL + 1, -1);
+    // consumer position of the events in flight, by pair of pipes
+    std::map<std::pair<int, int>, std::vector<size_t>> events;
+    for (size_t k = 0; k < order.size(); ++k) {
+      const Insn &insn = insns[order[k]];
+      std::vector<size_t> &cur = done[k];
+      if (last[insn.pipe] >= 0) {
+        cur = done[last[insn.pipe]];
+      }
+      std::vector<size_t> deps = insn.deps;
+      std::sort(deps.begin(), deps.end(), [&pos](size_t a, size_t b) { return pos[a] > pos[b]; });
+      for (auto d : deps) {
+        size_t src_pos = pos[d];
+        int src_pipe = insns[d].pipe;
+        if (cur[src_pipe] > src_pos) {
+          continue;
+        }
+        if (src_pipe == insn.pipe) {
+          ++estimate->barriers;
+          cur[src_pipe] = k;
+        } else {
+          ++estimate->syncs;
+          std::vector<size_t> &slots = events[std::make_pair(src_pipe, insn.pipe)];
+          auto slot = std::find_if(slots.begin(), slots.end(), [src_pos](size_t to) { return to <= src_pos; });
+          if (slot != slots.end()) {
+            *slot = k;
+          } else if (slots.size() < kEventNum) {
+            slots.emplace_back(k);
+          } else {
+            ++estimate->barriers;
+          }
+          for (size_t p = 0; p < cur.size(); ++p) {
+            cur[p] = std::max(cur[p], done[src_pos][p]);
+          }
+          cur[src_pipe] = src_pos + 1;
+        }
+      }
+      last[insn.pipe] = static_cast<int64_t>(k);
+    }
+  }
+
+  bool Flush(std::vector<Stmt> *run, std::vector<Stmt> *res) {
+    bool changed = false;
+    if (run->size() > 2) {
+      std::vector<Insn> insns = BuildDag(*run);
+      Estimate before = SourceOrder(insns);
+      Estimate after;
+      std::vector<size_t> order = ListSchedule(insns, &after);
+      std::vector<size_t> source(insns.size());
+      std::iota(source.begin(), source.end(), 0);
+      CountSyncs(insns, source, &before);
+      CountSyncs(insns, order, &after);
+      bool faster = after.cycles < before.cycles;
+      bool more_syncs = after.syncs > before.syncs || after.barriers > before.barriers;
+      if (faster && more_syncs) {
+        ++num_rejected_;
+      }
+      if (faster && !more_syncs) {
+        std::vector<Stmt> reordered;
+        reordered.reserve(run->size());
+        for (auto idx : order) {
+          reordered.emplace_back((*run)[idx]);
+        }
+        run->swap(reordered);
+        changed = true;
+        ++num_reordered_;
+        cycles_before_ += before.cycles;
+        cycles_after_ += after.cycles;
+        stalls_before_ += before.stalls;
+        stalls_after_ += after.stalls;
+        syncs_before_ += before.syncs;
+        syncs_after_ += after.syncs;
+      }
+    }
+    res->insert(res->end(), run->begin(), run->end());
+    run->clear();
+    return changed;
+  }
+
+  std::shared_ptr<DFAnalyzer> df_;
+  int64_t num_reordered_{0};
+  int64_t cycles_before_{0};
+  int64_t cycles_after_{0};
+  int64_t stalls_before_{0};
+  int64_t stalls_after_{0};
+  int64_t syncs_before_{0};
+  int64_t syncs_after_{0};
+  int64_t num_rejected_{0};
+};
+
+Stmt PipeListSchedule(Stmt stmt) {
+  PipeListScheduler scheduler(stmt);
+  Stmt res = scheduler.Mutate(stmt);
+  scheduler.DumpStatistics();
+  return res;
+}
+}  // namespace ir
+}  // namespace akg
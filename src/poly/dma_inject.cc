@@ -17,8 +17,13 @@
 
 #include <tvm/ir.h>
 #include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
 #include <utility>
 
+#include "build_module.h"
+#include "poly/isl_ctx_pool.h"
 #include "poly/scop.h"
 #include "poly/transform.h"
 #include "poly/scop_builder.h"
@@ -204,13 +209,20 @@ std::unique_ptr<TensorFootprintCluster> TensorFootprintCluster::ComputeFootprint
                                                                                         ReferenceType type,
                                                                                         bool need_dma,
                                                                                         bool need_extension) {
+  return ComputeFootprintCluster(original_access, scoped_access, nullptr, type, need_dma, need_extension);
+}
+
+std::unique_ptr<TensorFootprintCluster> TensorFootprintCluster::ComputeFootprintCluster(
+  const isl::map &original_access, const isl::map &scoped_access, const ScopedFootprint *foot_print,
+  ReferenceType type, bool need_dma, bool need_extension) {
   auto cluster = std::unique_ptr<TensorFootprintCluster>(new (std::nothrow) TensorFootprintCluster);
   CHECK(cluster) << "memory alloc fail.";
   auto fp = std::unique_ptr<TensorFootprint>(
     new (std::nothrow) TensorFootprint(original_access, scoped_access, type, need_dma, need_extension));
   CHECK(fp) << "memory alloc fail.";
   cluster->tensor_foot_prints.push_back(std::move(fp));
-  cluster->foot_print_ = ComputeFootprintOfRange(scoped_access.domain_factor_domain());
+  cluster->foot_print_ =
+    foot_print != nullptr ? *foot_print : ComputeFootprintOfRange(scoped_access.domain_factor_domain());
 
   if (!cluster->foot_print_.box.is_valid()) {
     LOG(WARNING) << "foot_print_ box is invalid, scoped_access: " << scoped_access.domain_factor_domain();
@@ -1712,16 +1724,154 @@ void UniteInterleavedReadsAndWrites(std::vector<std::unique_ptr<TensorFootprintC
   }
 }
 
+// below this many accesses, printing and parsing the maps costs more than the footprints themselves
+constexpr size_t kMinParallelFootprints = 8;
+constexpr int kMaxFootprintThreads = 8;
+
+struct PrintedFootprint {
+  bool valid{false};
+  std::string stride_values;
+  std::string stride_offsets;
+  std::string box_offset;
+  std::string box_size;
+};
+
+/*
+ * Worker of ComputeFootprintsInThreads. isl objects can only be used by the thread owning their context,
+ * so the accesses are parsed into a context private to this thread and only strings leave it.
+ * The accesses after the first one without a box are not used, first_invalid tells the workers to skip them.
+ */
+static void ComputePrintedFootprints(const std::vector<std::string> &accesses, size_t first, size_t step,
+                                     std::vector<PrintedFootprint> &results, std::atomic<size_t> &first_invalid) {
+  isl_ctx *ctx = IslCtxPool::GetInstance()->Acquire();
+  for (size_t i = first; i < accesses.size() && i < first_invalid.load(); i += step) {
+    isl_map *access = isl_map_read_from_str(ctx, accesses[i].c_str());
+    if (access == nullptr) {
+      continue;
+    }
+    try {
+      ScopedFootprint footprint = ComputeFootprintOfRange(isl::manage(access));
+      if (footprint.box.is_valid()) {
+        results[i].stride_values = footprint.stride_values.to_str();
+        results[i].stride_offsets = footprint.stride_offsets.to_str();
+        results[i].box_offset = footprint.box.get_offset().to_str();
+        results[i].box_size = footprint.box.get_size().to_str();
+        results[i].valid = true;
+      } else {
+        size_t invalid = first_invalid.load();
+        while (i < invalid && !first_invalid.compare_exchange_weak(invalid, i)) {
+        }
+      }
+    } catch (const std::exception &e) {
+      // computed again on the main context
+      LOG(INFO) << "footprint computed serially: " << e.what();
+    }
+  }
+  IslCtxPool::GetInstance()->Release(ctx);
+}
+
+/*
+ * Rebuild a footprint of the worker in the context of access. isl has no constructor for fixed boxes, so the box is
+ * the hull of an explicit box map; it is only accepted if it equals the printed box.
+ */
+static bool ParsePrintedFootprint(const isl::map &access, const PrintedFootprint &printed, ScopedFootprint &footprint) {
+  if (!printed.valid) {
+    return false;
+  }
+  isl_ctx *ctx = access.ctx().get();
+  isl_multi_val *stride_values = isl_multi_val_read_from_str(ctx, printed.stride_values.c_str());
+  isl_multi_aff *stride_offsets = isl_multi_aff_read_from_str(ctx, printed.stride_offsets.c_str());
+  isl_multi_aff *box_offset = isl_multi_aff_read_from_str(ctx, printed.box_offset.c_str());
+  isl_multi_val *box_size = isl_multi_val_read_from_str(ctx, printed.box_size.c_str());
+  if (stride_values == nullptr || stride_offsets == nullptr || box_offset == nullptr || box_size == nullptr) {
+    isl_multi_val_free(stride_values);
+    isl_multi_aff_free(stride_offsets);
+    isl_multi_aff_free(box_offset);
+    isl_multi_val_free(box_size);
+    return false;
+  }
+  isl::multi_aff offset = isl::manage(box_offset);
+  isl::multi_val size = isl::manage(box_size);
+
+  isl_map *box_map = isl_map_from_multi_aff(offset.copy());
+  isl_set *window = isl_set_universe(isl_space_range(isl_map_get_space(box_map)));
+  for (int i = 0; i < static_cast<int>(size.size()); ++i) {
+    window = isl_set_lower_bound_si(window, isl_dim_set, i, 0);
+    window = isl_set_upper_bound_si(window, isl_dim_set, i, size.get_val(i).get_num_si() - 1);
+  }
+  isl_set *domain = isl_set_universe(isl_space_domain(isl_map_get_space(box_map)));
+  box_map = isl_map_sum(box_map, isl_map_from_domain_and_range(domain, window));
+  if (box_map == nullptr) {
+    isl_multi_val_free(stride_values);
+    isl_multi_aff_free(stride_offsets);
+    return false;
+  }
+  isl::fixed_box box = isl::manage(isl_map_get_range_simple_fixed_box_hull(box_map));
+  isl_map_free(box_map);
+  if (!box.is_valid() || !isl_multi_aff_plain_is_equal(box.get_offset().get(), offset.get()) ||
+      !isl_multi_val_plain_is_equal(box.get_size().get(), size.get())) {
+    isl_multi_val_free(stride_values);
+    isl_multi_aff_free(stride_offsets);
+    return false;
+  }
+  footprint.stride_values = isl::manage(stride_values);
+  footprint.stride_offsets = isl::manage(stride_offsets);
+  footprint.box = box;
+  footprint.is_valid = true;
+  footprint.should_split = false;
+  return true;
+}
+
+/*
+ * ComputeFootprintOfRange of independent accesses in worker threads with thread-confined isl contexts, when
+ * poly_footprint_threads asks for them and there are enough accesses. Results are merged back on the context of the
+ * accesses; the footprints not marked done, because they did not survive the round trip or were skipped, are left
+ * to the caller to compute serially, so the result equals the serial one.
+ */
+static std::vector<bool> ComputeFootprintsInThreads(const std::vector<isl::map> &accesses,
+                                                    std::vector<ScopedFootprint> &footprints) {
+  footprints.resize(accesses.size());
+  int num_threads = std::min(global_attrs.GetIntAttr(kPolyFootprintThreads, 1), kMaxFootprintThreads);
+  num_threads = std::min(num_threads, static_cast<int>(accesses.size()));
+  std::vector<bool> done(accesses.size(), false);
+  if (accesses.size() >= kMinParallelFootprints && num_threads > 1) {
+    std::vector<std::string> printed_accesses;
+    for (const auto &access : accesses) {
+      printed_accesses.push_back(access.to_str());
+    }
+    std::vector<PrintedFootprint> results(accesses.size());
+    std::atomic<size_t> first_invalid(accesses.size());
+    std::vector<std::thread> workers;
+    for (int t = 0; t < num_threads; ++t) {
+      workers.emplace_back(ComputePrintedFootprints, std::cref(printed_accesses), static_cast<size_t>(t),
+                           static_cast<size_t>(num_threads), std::ref(results), std::ref(first_invalid));
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    for (size_t i = 0; i < accesses.size(); ++i) {
+      done[i] = ParsePrintedFootprint(accesses[i], results[i], footprints[i]);
+    }
+  }
+  return done;
+}
+
 void CreateTensorFootprintClusters(TensorClusterInfo &tensor_info, const isl::id &target_tensor_id,
                                    const isl::union_map &accesses, const isl::union_map &copyin,
                                    const isl::union_map &fake_copyin, const isl::union_set &domain,
                                    const isl::union_map &schedule, ReferenceType type) {
-  std::unordered_set<isl::id, isl::IslIdIslHash> unapproximatable;
-
+  struct Candidate {
+    isl::map access;
+    isl::map scoped_access;
+    bool need_dma;
+    bool need_extension;
+  };
+  std::vector<Candidate> candidates;
+  std::vector<isl::map> scoped_ranges;
   for (const auto &access : accesses.get_map_list()) {
     auto tensor_id = access.get_tuple_id(isl_dim_out);
 
-    if (target_tensor_id.get_name() != tensor_id.get_name() || unapproximatable.count(tensor_id) != 0 ||
+    if (target_tensor_id.get_name() != tensor_id.get_name() ||
         isl::union_map(access.curry()).intersect_domain(domain).is_empty()) {
       continue;
     }
@@ -1749,8 +1899,25 @@ void CreateTensorFootprintClusters(TensorClusterInfo &tensor_info, const isl::id
     auto scoped_access = GetScopedAccess(schedule, access);
     bool need_dma = type == ReferenceType::Read ? IsRealRead() : true;
     bool need_extension = type == ReferenceType::Read ? IsFakeCopyin() : false;
-    auto footprint_cluster =
-      TensorFootprintCluster::ComputeFootprintCluster(access, scoped_access, type, need_dma, need_extension);
+    candidates.push_back(Candidate{access, scoped_access, need_dma, need_extension});
+    scoped_ranges.push_back(scoped_access.domain_factor_domain());
+  }
+
+  // the footprints of the accesses are independent of each other
+  std::vector<ScopedFootprint> footprints;
+  std::vector<bool> done = ComputeFootprintsInThreads(scoped_ranges, footprints);
+
+  std::unordered_set<isl::id, isl::IslIdIslHash> unapproximatable;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    const auto &access = candidates[i].access;
+    auto tensor_id = access.get_tuple_id(isl_dim_out);
+    if (unapproximatable.count(tensor_id) != 0) {
+      continue;
+    }
+    // computed here when the threads did not, once the tensor is unapproximatable nothing is computed
+    auto footprint_cluster = TensorFootprintCluster::ComputeFootprintCluster(
+      access, candidates[i].scoped_access, done[i] ? &footprints[i] : nullptr, type, candidates[i].need_dma,
+      candidates[i].need_extension);
 
     if (footprint_cluster->foot_print_.box.is_valid()) {
       tensor_info.push_back(std::move(footprint_cluster));
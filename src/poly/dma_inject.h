@@ -122,6 +122,12 @@ class TensorFootprintCluster {
                                                                          const isl::map &scoped_access,
                                                                          ReferenceType type, bool need_dma,
                                                                          bool need_extension = false);
+  /*! \brief same as above, foot_print of the scoped access is computed already when it is not null */
+  static std::unique_ptr<TensorFootprintCluster> ComputeFootprintCluster(const isl::map &original_access,
+                                                                         const isl::map &scoped_access,
+                                                                         const ScopedFootprint *foot_print,
+                                                                         ReferenceType type, bool need_dma,
+                                                                         bool need_extension);
 
   std::vector<std::unique_ptr<TensorFootprint>> tensor_foot_prints;
   ScopedFootprint foot_print_;
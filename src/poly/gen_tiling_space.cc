@@ -191,6 +191,9 @@ class TileSpaceCollector {
     const auto tile_mod = cons.tile_mod_.as<IntImm>();
     const auto tile_extent = cons.tile_extent_.as<IntImm>();
     if (tile_min && tile_mod && tile_extent) {
+      if (axis_idx + 1 == tile_axes_.size()) {
+        return ScanInnermost(axis, band_idx, tile_min->value, tile_mod->value, tile_extent->value);
+      }
       bool min_tile_ok = false;
       for (int64_t tile = tile_min->value; tile <= tile_extent->value; ++tile) {
         if (tile != tile_min->value && tile != tile_extent->value && (tile % tile_mod->value != 0)) continue;
@@ -206,10 +209,38 @@ class TileSpaceCollector {
     }
   }
 
-  bool AppendCand(size_t band_idx) {
+  // Memory of the innermost factors is inferred in batches, candidates are still appended in order.
+  bool ScanInnermost(TileAxis *axis, size_t band_idx, int64_t tile_min, int64_t tile_mod, int64_t tile_extent) {
+    bool min_tile_ok = false;
+    std::vector<int64_t> tiles;
+    const size_t batch = TileCandidate::GetMemInferBatch();
+    for (int64_t tile = tile_min; tile <= tile_extent;) {
+      tiles.clear();
+      for (; tile <= tile_extent && tiles.size() < batch; ++tile) {
+        if (tile != tile_min && tile != tile_extent && (tile % tile_mod != 0)) continue;
+        cand_.UpdateConstTile(axis, tile);
+        if (!cand_.SpaceVerify(axis, LEVEL1, band_idx)) continue;
+        tiles.emplace_back(tile);
+      }
+      auto mems = cand_.MemInferSweep(axis, LEVEL1, tiles, static_cast<int>(band_idx));
+      for (size_t i = 0; i < tiles.size(); ++i) {
+        cand_.UpdateConstTile(axis, tiles[i]);
+        if (!AppendCand(band_idx, &mems[i])) return min_tile_ok;
+        if (!min_tile_ok) min_tile_ok = true;
+      }
+    }
+    return true;
+  }
+
+  bool AppendCand(size_t band_idx, const TileCandidate::MemInferResult *mem = nullptr) {
     process_++;
     int64_t mem_sz, align_sz;
-    std::tie(mem_sz, align_sz) = cand_.MemInfer(MEM_SCOPE_UB, band_idx);
+    if (mem != nullptr) {
+      mem_sz = mem->mem[MEM_SCOPE_UB];
+      align_sz = mem->align_mem[MEM_SCOPE_UB];
+    } else {
+      std::tie(mem_sz, align_sz) = cand_.MemInfer(MEM_SCOPE_UB, band_idx);
+    }
     if (align_sz > mem_limit_[MEM_SCOPE_UB]) return false;
     std::vector<int> tile(tile_axes_.size());
     for (size_t i = 0; i < tile_axes_.size(); ++i) {
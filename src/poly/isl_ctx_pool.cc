@@ -0,0 +1,131 @@
+/**
+ * Copyright 2026 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "poly/isl_ctx_pool.h"
+
+#include <dmlc/logging.h>
+#include <isl/ast_build.h>
+#include <isl/options.h>
+#include <isl/schedule.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "tvm.h"
+
+namespace akg {
+namespace ir {
+namespace poly {
+namespace {
+// idle contexts kept for reuse, enough for the footprint workers; a context is retired after serving this many
+// kernels to bound its internal tables
+constexpr size_t kMaxIdleIslCtx = 8;
+constexpr size_t kMaxIslCtxUses = 256;
+}  // namespace
+
+IslCtxPool::IslCtxPool() : leak_check_(std::getenv("AKG_ISL_CTX_LEAK_CHECK") != nullptr) {}
+
+IslCtxPool::~IslCtxPool() {
+  for (auto &entry : idle_) {
+    isl_ctx_free(entry.first);
+  }
+}
+
+isl_ctx *IslCtxPool::Acquire() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  isl_ctx *ctx = nullptr;
+  size_t uses = 0;
+  if (!idle_.empty()) {
+    ctx = idle_.back().first;
+    uses = idle_.back().second;
+    idle_.pop_back();
+    ResetOptions(ctx);
+    ++reused_;
+  } else {
+    ctx = isl_ctx_alloc();
+    CHECK(ctx != nullptr) << "isl_ctx_alloc failed";
+    ++allocated_;
+    if (!has_defaults_) {
+      defaults_.schedule_unit_max_var_coefficient_sum = isl_options_get_schedule_unit_max_var_coefficient_sum(ctx);
+      defaults_.schedule_whole_component = isl_options_get_schedule_whole_component(ctx);
+      defaults_.schedule_maximize_coincidence = isl_options_get_schedule_maximize_coincidence(ctx);
+      defaults_.schedule_max_constant_term = isl_options_get_schedule_max_constant_term(ctx);
+      defaults_.schedule_nonneg_var_coefficient = isl_options_get_schedule_nonneg_var_coefficient(ctx);
+      defaults_.schedule_serialize_sccs = isl_options_get_schedule_serialize_sccs(ctx);
+      defaults_.ast_build_group_coscheduled = isl_options_get_ast_build_group_coscheduled(ctx);
+      defaults_.tile_scale_tile_loops = isl_options_get_tile_scale_tile_loops(ctx);
+      defaults_.tile_shift_point_loops = isl_options_get_tile_shift_point_loops(ctx);
+      has_defaults_ = true;
+    }
+  }
+  busy_.emplace_back(ctx, uses + 1);
+  return ctx;
+}
+
+void IslCtxPool::Release(isl_ctx *ctx) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = std::find_if(busy_.begin(), busy_.end(),
+                         [ctx](const std::pair<isl_ctx *, size_t> &entry) { return entry.first == ctx; });
+  CHECK(it != busy_.end()) << "isl ctx was not acquired from the pool";
+  size_t uses = it->second;
+  busy_.erase(it);
+  isl_ctx_reset_error(ctx);
+  isl_ctx_set_max_operations(ctx, 0);
+  isl_ctx_reset_operations(ctx);
+  // isl_ctx_free reports the objects that still reference the context
+  if (leak_check_ || idle_.size() >= kMaxIdleIslCtx || uses >= kMaxIslCtxUses) {
+    isl_ctx_free(ctx);
+    return;
+  }
+  idle_.emplace_back(ctx, uses);
+}
+
+void IslCtxPool::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &entry : idle_) {
+    isl_ctx_free(entry.first);
+  }
+  idle_.clear();
+}
+
+void IslCtxPool::ResetOptions(isl_ctx *ctx) const {
+  CHECK(has_defaults_);
+  bool ok = isl_options_set_schedule_unit_max_var_coefficient_sum(
+              ctx, defaults_.schedule_unit_max_var_coefficient_sum) == isl_stat_ok &&
+            isl_options_set_schedule_whole_component(ctx, defaults_.schedule_whole_component) == isl_stat_ok &&
+            isl_options_set_schedule_maximize_coincidence(ctx, defaults_.schedule_maximize_coincidence) ==
+              isl_stat_ok &&
+            isl_options_set_schedule_max_constant_term(ctx, defaults_.schedule_max_constant_term) == isl_stat_ok &&
+            isl_options_set_schedule_nonneg_var_coefficient(ctx, defaults_.schedule_nonneg_var_coefficient) ==
+              isl_stat_ok &&
+            isl_options_set_schedule_serialize_sccs(ctx, defaults_.schedule_serialize_sccs) == isl_stat_ok &&
+            isl_options_set_ast_build_group_coscheduled(ctx, defaults_.ast_build_group_coscheduled) == isl_stat_ok &&
+            isl_options_set_tile_scale_tile_loops(ctx, defaults_.tile_scale_tile_loops) == isl_stat_ok &&
+            isl_options_set_tile_shift_point_loops(ctx, defaults_.tile_shift_point_loops) == isl_stat_ok;
+  CHECK(ok) << "cannot reset options of pooled isl ctx";
+}
+
+TVM_REGISTER_API("akg.poly.isl_ctx_pool_stats").set_body([](const TVMArgs &args, TVMRetValue *ret) {
+  auto pool = IslCtxPool::GetInstance();
+  *ret = Array<Expr>{air::make_const(air::Int(64), static_cast<int64_t>(pool->allocated())),
+                     air::make_const(air::Int(64), static_cast<int64_t>(pool->reused()))};
+});
+
+TVM_REGISTER_API("akg.poly.isl_ctx_pool_clear").set_body([](const TVMArgs &args, TVMRetValue *ret) {
+  IslCtxPool::GetInstance()->Clear();
+});
+}  // namespace poly
+}  // namespace ir
+}  // namespace akg
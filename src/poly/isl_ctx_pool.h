@@ -0,0 +1,100 @@
+/**
+ * Copyright 2026 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef POLY_ISL_CTX_POOL_H_
+#define POLY_ISL_CTX_POOL_H_
+
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "poly/isl.h"
+
+namespace akg {
+namespace ir {
+namespace poly {
+/*!
+ * \brief Process wide pool of isl contexts reused by AutoPoly and GenTuningSpace.
+ *
+ *  A context keeps its id table and allocation state between kernels instead of being allocated and freed for every
+ *  call. Every isl option changed by the poly passes is restored to its default when a context is handed out again,
+ *  so a pooled context schedules exactly like a fresh one. The caller must free all isl objects of the context before
+ *  releasing it. isl only reports objects left alive when a context is freed, set AKG_ISL_CTX_LEAK_CHECK to free
+ *  every context on release and get these reports.
+ */
+class IslCtxPool {
+ public:
+  static IslCtxPool *GetInstance() {
+    static IslCtxPool pool;
+    return &pool;
+  }
+
+  isl_ctx *Acquire();
+  void Release(isl_ctx *ctx);
+
+  /*! \brief free the idle contexts, the next Acquire allocates a fresh one; the counts keep running */
+  void Clear();
+
+  /*! \brief number of contexts allocated and handed out again since the process started */
+  size_t allocated() const { return allocated_; }
+  size_t reused() const { return reused_; }
+
+ private:
+  IslCtxPool();
+  ~IslCtxPool();
+
+  void ResetOptions(isl_ctx *ctx) const;
+
+  struct DefaultOptions {
+    int schedule_unit_max_var_coefficient_sum;
+    int schedule_whole_component;
+    int schedule_maximize_coincidence;
+    int schedule_max_constant_term;
+    int schedule_nonneg_var_coefficient;
+    int schedule_serialize_sccs;
+    int ast_build_group_coscheduled;
+    int tile_scale_tile_loops;
+    int tile_shift_point_loops;
+  };
+
+  std::vector<std::pair<isl_ctx *, size_t>> idle_;
+  std::vector<std::pair<isl_ctx *, size_t>> busy_;
+  DefaultOptions defaults_;
+  bool has_defaults_{false};
+  bool leak_check_{false};
+  std::atomic<size_t> allocated_{0};
+  std::atomic<size_t> reused_{0};
+  std::mutex mutex_;
+};
+
+/*! \brief RAII handle of a pooled isl context */
+class PooledIslCtx {
+ public:
+  PooledIslCtx() : ctx_(isl::ctx(IslCtxPool::GetInstance()->Acquire())) {}
+  ~PooledIslCtx() { IslCtxPool::GetInstance()->Release(ctx_.get()); }
+  PooledIslCtx(const PooledIslCtx &) = delete;
+  PooledIslCtx &operator=(const PooledIslCtx &) = delete;
+
+  isl::ctx get() const { return ctx_; }
+
+ private:
+  isl::ctx ctx_;
+};
+}  // namespace poly
+}  // namespace ir
+}  // namespace akg
+
+#endif  // POLY_ISL_CTX_POOL_H_
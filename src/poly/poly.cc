@@ -19,6 +19,7 @@
 #include <memory>
 
 #include "ir_pass.h"
+#include "poly/isl_ctx_pool.h"
 #include "poly/scop.h"
 #include "pass/utils.h"
 
@@ -29,7 +30,10 @@ namespace ir {
  */
 class Poly {
  public:
-  Poly() : isl_ctx_(isl::ctx(isl_ctx_alloc())) {}
+  Poly()
+      : allocated_at_start_(poly::IslCtxPool::GetInstance()->allocated()),
+        reused_at_start_(poly::IslCtxPool::GetInstance()->reused()),
+        isl_ctx_(pooled_ctx_.get()) {}
 
   void Run(const Stmt &stmt, const Map<Tensor, Buffer> &extern_buffer, const Map<std::string, NodeRef> &attrs,
            const bool is_spec_gemm, bool is_tuning, bool is_dynamic) {
@@ -66,9 +70,12 @@ class Poly {
   }
 
   ~Poly() noexcept {
+    // scop must be deconstructed before isl_ctx goes back to the pool
     scop_.reset();
-    // scop must be deconstructed before isl_ctx is deconstructed
-    isl_ctx_free(isl_ctx_.get());
+    // counts of this compile, including the contexts of the footprint workers
+    auto pool = poly::IslCtxPool::GetInstance();
+    LOG(INFO) << "isl ctx pool: " << pool->allocated() - allocated_at_start_ << " allocated, "
+              << pool->reused() - reused_at_start_ << " reused";
   }
 
   Stmt getstmt() { return stmt_; }
@@ -85,15 +92,30 @@ class Poly {
     return tiling_params_array;
   }
 
+  // tile factors to evaluate on the host: {Array<Var> tile vars, Array<Expr> tile values}
+  Array<NodeRef> getHostTiling() {
+    CHECK(scop_ != nullptr);
+    Array<Var> tile_vars;
+    Array<Expr> tile_values;
+    for (const auto &let : scop_->host_tiling_lets_) {
+      tile_vars.push_back(let.first);
+      tile_values.push_back(let.second);
+    }
+    return Array<NodeRef>({tile_vars, tile_values});
+  }
+
   NodeRef getspaces() {
     CHECK(scop_ != nullptr);
     return scop_->spaces_;
   }
 
  private:
+  size_t allocated_at_start_;
+  size_t reused_at_start_;
   std::unique_ptr<poly::Scop> scop_{nullptr};
   // define isl_ctx outside scop because there are a lot of isl objects in the members of scop class,
-  // and we need to ensure that they are deconstructed before the isl_ctx is freed.
+  // and we need to ensure that they are deconstructed before the isl_ctx is released.
+  poly::PooledIslCtx pooled_ctx_;
   isl::ctx isl_ctx_;
   Stmt stmt_;
 };
@@ -103,7 +125,7 @@ Array<NodeRef> AutoPoly(const Stmt &stmt, const Map<Tensor, Buffer> &extern_buff
                         const Map<std::string, NodeRef> &attrs, const bool is_specgemm, const bool is_dynamic) {
   Poly poly;
   poly.Run(stmt, extern_buffer, attrs, is_specgemm, false, is_dynamic);
-  return Array<NodeRef>({poly.getstmt(), poly.getTilingParams()});
+  return Array<NodeRef>({poly.getstmt(), poly.getTilingParams(), poly.getHostTiling()});
 }
 
 NodeRef GenTuningSpace(const Stmt &stmt, const Map<Tensor, Buffer> &extern_buffer,
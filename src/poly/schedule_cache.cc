@@ -0,0 +1,242 @@
+/**
+ * Copyright 2026 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "poly/schedule_cache.h"
+
+#include <dmlc/logging.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <sstream>
+
+#include "tvm.h"
+
+namespace akg {
+namespace ir {
+namespace poly {
+namespace {
+// the in-memory table is dropped when it grows beyond this, keys of fused kernels can be large
+constexpr size_t kMaxScheduleCacheEntries = 256;
+constexpr auto kScheduleCacheFilePrefix = "isl_schedule_";
+
+std::string CacheFileName(const std::string &key, const std::string &dir) {
+  std::ostringstream os;
+  os << dir << "/" << kScheduleCacheFilePrefix << std::hex << std::hash<std::string>()(key) << ".txt";
+  return os.str();
+}
+
+// file layout: length of the key, the key itself, then the schedule tree
+bool ReadCacheFile(const std::string &key, const std::string &file_name, std::string *schedule) {
+  std::ifstream is(file_name);
+  if (!is.good()) {
+    return false;
+  }
+  size_t key_len = 0;
+  is >> key_len;
+  if (!is.good() || key_len != key.size() || is.get() != '\n') {
+    return false;
+  }
+  std::string file_key(key_len, '\0');
+  if (!is.read(&file_key[0], static_cast<std::streamsize>(key_len)) || file_key != key) {
+    // hash collision or stale file
+    return false;
+  }
+  schedule->assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+  return !schedule->empty();
+}
+
+void WriteCacheFile(const std::string &key, const std::string &file_name, const std::string &schedule) {
+  // write a private file first, concurrent compilers only ever see complete entries
+  std::string tmp_name = file_name + "." + std::to_string(getpid());
+  {
+    std::ofstream os(tmp_name);
+    if (!os.good()) {
+      LOG(WARNING) << "cannot write schedule cache file " << tmp_name;
+      return;
+    }
+    os << key.size() << "\n" << key << schedule;
+  }
+  if (std::rename(tmp_name.c_str(), file_name.c_str()) != 0) {
+    LOG(WARNING) << "cannot write schedule cache file " << file_name;
+    static_cast<void>(std::remove(tmp_name.c_str()));
+  }
+}
+
+bool IsSubsetOfIdentity(const isl::union_map &umap) {
+  return umap.subtract(umap.domain().unite(umap.range()).identity()).is_empty();
+}
+
+bool RespectsValidity(const isl::schedule &schedule, const isl::union_map &validity) {
+  if (validity.is_empty()) {
+    return true;
+  }
+  isl::union_map sched_map = schedule.get_map();
+  isl::union_map before = isl::manage(isl_union_map_lex_lt_union_map(sched_map.copy(), sched_map.copy()));
+  return validity.is_subset(before);
+}
+
+bool RespectsCoincidence(const isl::schedule &schedule, const isl::union_map &coincidence) {
+  if (coincidence.is_empty()) {
+    return true;
+  }
+  bool respected = true;
+  schedule.get_root().foreach_descendant_top_down([&respected, &coincidence](const isl::schedule_node &node) -> bool {
+    if (!respected) {
+      return false;
+    }
+    if (!node.isa<isl::schedule_node_band>()) {
+      return true;
+    }
+    auto band = node.as<isl::schedule_node_band>();
+    // only dependences that are not carried by the outer bands have to be zero distance
+    isl::union_map prefix = node.get_prefix_schedule_union_map();
+    isl::union_map local = coincidence.intersect(prefix.apply_range(prefix.reverse()));
+    isl::multi_union_pw_aff partial = band.get_partial_schedule();
+    for (int i = 0; i < static_cast<int>(band.n_member()); ++i) {
+      if (!band.member_get_coincident(i)) {
+        continue;
+      }
+      isl::union_map member = isl::manage(isl_union_map_from_union_pw_aff(partial.get_union_pw_aff(i).release()));
+      if (!IsSubsetOfIdentity(local.apply_domain(member).apply_range(member))) {
+        respected = false;
+        return false;
+      }
+    }
+    return true;
+  });
+  return respected;
+}
+}  // namespace
+
+bool ScheduleCache::Lookup(const std::string &key, const std::string &dir, std::string *schedule) {
+  CHECK(schedule != nullptr);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      *schedule = it->second;
+      return true;
+    }
+  }
+  if (dir.empty() || !ReadCacheFile(key, CacheFileName(key, dir), schedule)) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (entries_.size() >= kMaxScheduleCacheEntries) {
+    entries_.clear();
+  }
+  entries_[key] = *schedule;
+  return true;
+}
+
+void ScheduleCache::Insert(const std::string &key, const std::string &dir, const std::string &schedule) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.size() >= kMaxScheduleCacheEntries) {
+      entries_.clear();
+    }
+    entries_[key] = schedule;
+  }
+  if (!dir.empty()) {
+    WriteCacheFile(key, CacheFileName(key, dir), schedule);
+  }
+}
+
+void ScheduleCache::Record(bool hit) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++(hit ? hits_ : misses_);
+}
+
+void ScheduleCache::Stats(int64_t *hits, int64_t *misses) {
+  CHECK(hits != nullptr && misses != nullptr);
+  std::lock_guard<std::mutex> lock(mutex_);
+  *hits = hits_;
+  *misses = misses_;
+}
+
+void ScheduleCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  hits_ = 0;
+  misses_ = 0;
+}
+
+std::string AbstractScheduleKey(const std::string &key) {
+  std::string res;
+  res.reserve(key.size());
+  for (size_t i = 0; i < key.size(); ++i) {
+    char c = key[i];
+    bool in_name = i > 0 && (isalnum(static_cast<unsigned char>(key[i - 1])) || key[i - 1] == '_');
+    if (!isdigit(static_cast<unsigned char>(c)) || in_name) {
+      res.push_back(c);
+      continue;
+    }
+    // an integer constant, keep a single placeholder for the whole run
+    while (i + 1 < key.size() && isdigit(static_cast<unsigned char>(key[i + 1]))) ++i;
+    res.push_back('#');
+  }
+  return res;
+}
+
+bool ReuseScheduleOnDomain(const std::string &cached, const isl::schedule_constraints &constraints,
+                           isl::schedule *schedule) {
+  CHECK(schedule != nullptr);
+  // the domain is the first string of the printed tree: { domain: "...", child: ... }
+  const std::string domain_key = "domain: \"";
+  size_t begin = cached.find(domain_key);
+  if (begin == std::string::npos) {
+    return false;
+  }
+  begin += domain_key.size();
+  size_t end = cached.find('"', begin);
+  if (end == std::string::npos) {
+    return false;
+  }
+  isl::union_set domain = constraints.get_domain();
+  std::string tree = cached.substr(0, begin) + domain.to_str() + cached.substr(end);
+  isl_schedule *res = isl_schedule_read_from_str(constraints.ctx().get(), tree.c_str());
+  if (res == nullptr) {
+    return false;
+  }
+  isl::schedule reused = isl::manage(res);
+  // filters of the cached tree may depend on the old extents and drop instances
+  if (!reused.get_map().domain().is_equal(domain)) {
+    return false;
+  }
+  if (!RespectsValidity(reused, constraints.get_validity()) ||
+      !RespectsCoincidence(reused, constraints.get_coincidence())) {
+    return false;
+  }
+  *schedule = reused;
+  return true;
+}
+
+TVM_REGISTER_API("akg.poly.schedule_cache_stats").set_body([](const TVMArgs &args, TVMRetValue *ret) {
+  int64_t hits = 0;
+  int64_t misses = 0;
+  ScheduleCache::GetInstance()->Stats(&hits, &misses);
+  *ret = Array<Expr>{air::make_const(air::Int(64), hits), air::make_const(air::Int(64), misses)};
+});
+
+TVM_REGISTER_API("akg.poly.schedule_cache_clear").set_body([](const TVMArgs &args, TVMRetValue *ret) {
+  ScheduleCache::GetInstance()->Clear();
+});
+}  // namespace poly
+}  // namespace ir
+}  // namespace akg
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2026 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef POLY_SCHEDULE_CACHE_H_
+#define POLY_SCHEDULE_CACHE_H_
+
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "poly/isl.h"
+
+namespace akg {
+namespace ir {
+namespace poly {
+/*!
+ * \brief Process wide cache of isl schedules computed by Transform::ComputeSchedule.
+ *
+ *  Keys are the printed schedule constraints (domain, validity, proximity, coincidence) prefixed by the scheduler
+ *  options; statements are named S_0, S_1, ... in program order, so kernels with the same polyhedral model share
+ *  entries regardless of tensor names. Values are printed schedule trees, so entries survive the isl_ctx of the
+ *  kernel that computed them and can be persisted in a directory.
+ */
+class ScheduleCache {
+ public:
+  static ScheduleCache *GetInstance() {
+    static ScheduleCache cache;
+    return &cache;
+  }
+
+  /*! \brief find the schedule of key in memory, then in dir when it is not empty */
+  bool Lookup(const std::string &key, const std::string &dir, std::string *schedule);
+  /*! \brief remember the schedule of key, and write it to dir when it is not empty */
+  void Insert(const std::string &key, const std::string &dir, const std::string &schedule);
+
+  /*! \brief count one kernel that reused a cached schedule, or computed its own */
+  void Record(bool hit);
+  /*! \brief number of kernels that reused a cached schedule and that computed their own */
+  void Stats(int64_t *hits, int64_t *misses);
+  /*! \brief drop the in-memory entries and the counts, files in a cache dir are kept */
+  void Clear();
+
+ private:
+  ScheduleCache() = default;
+
+  std::unordered_map<std::string, std::string> entries_;
+  int64_t hits_{0};
+  int64_t misses_{0};
+  std::mutex mutex_;
+};
+
+/*! \brief key with every integer constant replaced, equal for models that only differ in their extents */
+std::string AbstractScheduleKey(const std::string &key);
+
+/*!
+ * \brief Rebuild a cached schedule tree on the domain of constraints.
+ *
+ *  Used for models that only differ in extents. The result is accepted only if it schedules the whole domain,
+ *  respects the validity constraints and keeps the coincidence constraints on every band member marked coincident.
+ */
+bool ReuseScheduleOnDomain(const std::string &cached, const isl::schedule_constraints &constraints,
+                           isl::schedule *schedule);
+}  // namespace poly
+}  // namespace ir
+}  // namespace akg
+
+#endif  // POLY_SCHEDULE_CACHE_H_
@@ -126,6 +126,11 @@ isl::schedule Scop::Transform(isl::schedule sched, bool coincident, bool tuning)
 
   CheckAndRemoveUninitializedCopyin(data_.copyin, binds_orig_);
   sch = transform.Initialize(coincident);
+  if (coincident && !tuning && transform.IsScheduleBudgetExceeded()) {
+    // let the caller retry without coincidence constraints, which is much cheaper for the scheduler
+    LOG(WARNING) << "isl schedule budget exceeded with coincidence constraints";
+    return sched;
+  }
 
   if (outer_band_need_split_ && !is_spec_gemm_) {
     sch = SplitOuterBand(sch);
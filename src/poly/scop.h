@@ -138,6 +138,12 @@ class Scop {
   int dump_pass_ir_{0};
   int depth_ = 0;
   int dynamic_shape_bound_{0};
+  // budget of isl operations for one schedule computation, 0 means unlimited
+  int isl_max_operations_{0};
+  // reuse isl schedules of kernels with the same polyhedral model, see ScheduleCache
+  bool enable_schedule_cache_{true};
+  bool schedule_cache_any_shape_{false};
+  std::string schedule_cache_dir_;
   int tile_size_is_var_{0};
   int outer_band_need_split_{0};
   int pragma_is_conv_{0};
@@ -255,6 +261,9 @@ class Scop {
   bool pragma_speedup_tiling_{false};
   bool pragma_allow_tail_tiling_{true};
   bool pragma_analyze_multicore_{true};
+  bool enable_host_tiling_{false};
+  // tile factors computed on the host instead of in the kernel, see AddTilingStrategyApplet
+  std::vector<std::pair<Var, Expr>> host_tiling_lets_;
 
   ConvolutionModel *model_{nullptr};
 
@@ -214,12 +214,18 @@ Stmt Scop::RestoreCombinedParams(Stmt stmt) {
 }
 
 Stmt Scop::AddTilingStrategyApplet(Stmt stmt) {
+  host_tiling_lets_.clear();
   for (auto info = tiling_constraints_.rbegin(); info != tiling_constraints_.rend(); ++info) {
     if (info->type_key == "AttrStmt") {
       auto attr_key = info->key.as<StringImm>();
       CHECK(attr_key);
       stmt = AttrStmt::make(make_zero(Int(32)), attr_key->value, info->value, stmt);
     } else if (info->type_key == "LetStmt") {
+      if (enable_host_tiling_ && is_dynamic_) {
+        // the tile factor becomes a kernel argument, evaluated on the host at launch
+        host_tiling_lets_.emplace(host_tiling_lets_.begin(), air::Downcast<Var>(info->key), info->value);
+        continue;
+      }
       stmt = LetStmt::make(air::Downcast<Var>(info->key), info->value, stmt);
     } else {
       LOG(FATAL) << "Unsupported type_key for now: " << info->type_key;
@@ -602,6 +602,11 @@ void Scop::SetAttrs(const Map<std::string, NodeRef> &attrs) {
   ParseBoolAttr(attrs, "pragma_speedup_tiling", &pragma_speedup_tiling_);
   ParseBoolAttr(attrs, "pragma_allow_tail_tiling", &pragma_allow_tail_tiling_);
   ParseBoolAttr(attrs, "pragma_analyze_multicore", &pragma_analyze_multicore_);
+  ParseBoolAttr(attrs, "enable_host_tiling", &enable_host_tiling_);
+  ParseIntAttr(attrs, "isl_max_operations", &isl_max_operations_);
+  ParseBoolAttr(attrs, "enable_schedule_cache", &enable_schedule_cache_);
+  ParseBoolAttr(attrs, "schedule_cache_any_shape", &schedule_cache_any_shape_);
+  ParseStringAttr(attrs, "schedule_cache_dir", &schedule_cache_dir_);
 
   if (force_remove_self_dependence_) {
     LOG(WARNING) << "pragma_force_rmselfdep should be used with care. "
@@ -17,8 +17,11 @@
 #include <tvm/ir.h>
 #include <tvm/ir_visitor.h>
 
+#include <atomic>
 #include <cmath>
 #include <iostream>
+#include <memory>
+#include <string>
 #include <unordered_map>
 #include <utility>
 
@@ -28,6 +31,7 @@
 #include "poly/tiling_algorithm.h"
 #include "poly/tiling_strategy_manager.h"
 #include "poly/tiling_solver.h"
+#include "tvm.h"
 
 namespace akg {
 namespace ir {
@@ -420,38 +424,120 @@ std::vector<Scop::DimensionInfo> NullTiling() {
   return dims;
 }
 
+/*
+ * When StorageFlatten or StorageRewriteCCE fails, Lower runs AutoPoly again on the same kernel and only the
+ * memory limits of the solver change. The analysis of the last static vector kernel is kept per thread so that
+ * a retry goes straight to the solver; the feedback stored in it lets the solver pick the new limit directly.
+ */
+struct TilingRetryCache {
+  std::string key;
+  std::unique_ptr<TilingAnalyzer> analyzer;
+};
+
+TilingRetryCache &GetTilingRetryCache() {
+  static thread_local TilingRetryCache retry_cache;
+  return retry_cache;
+}
+
+// Process wide counts of tiling retries after a failed storage pass, and the local.UB limit of the last solve.
+struct TilingRetryStats {
+  std::atomic<int64_t> retries{0};
+  std::atomic<int64_t> reused{0};
+  std::atomic<int64_t> ub_limit{0};
+};
+
+TilingRetryStats &GetTilingRetryStats() {
+  static TilingRetryStats stats;
+  return stats;
+}
+
+bool IsTilingRetry() {
+  if (!global_attrs.GetStringAttr(kErrorScope, "").empty()) {
+    return true;
+  }
+  return global_attrs.GetStringAttr(kErrorInfo, "").find("storage_flatten") != std::string::npos;
+}
+
 std::pair<std::vector<Scop::DimensionInfo>, std::deque<Scop::ParamInfo>> GenerateTiling(
   Scop *scop, const isl::schedule &sch, const std::vector<NodeRef> &custom_tiling,
   const std::vector<NodeRef> &dynamic_shape) {
   CHECK(scop);
+  TilingRetryCache &retry_cache = GetTilingRetryCache();
   scop->is_tiled_ = false;
   std::vector<Scop::DimensionInfo> dims = NullTiling();
   std::deque<Scop::ParamInfo> param_info;
-  TilingAnalyzer analyzer(scop, sch, custom_tiling, dynamic_shape);
-  bool need_tiling = analyzer.Prepare();
 
   std::stringstream ss;
   ss << scop->GenHalide(sch);
-  analyzer.logger_.AppendLog(DO_TILING, ss);
-  if (!need_tiling) {
-    LOG(INFO) << "No need for tiling, exit.";
-    if (!analyzer.logger_.DumpLogFile()) LOG(WARNING) << "Write tiling log fail.";
-    return std::make_pair(dims, param_info);
+  std::string key = ss.str();
+  std::unique_ptr<TilingAnalyzer> analyzer;
+  TilingRetryStats &stats = GetTilingRetryStats();
+  bool is_retry = IsTilingRetry();
+  if (is_retry) {
+    ++stats.retries;
+  }
+  if (is_retry && retry_cache.analyzer != nullptr && retry_cache.key == key && custom_tiling.empty() &&
+      dynamic_shape.empty()) {
+    analyzer = std::move(retry_cache.analyzer);
+    analyzer->Rebind(scop, sch);
+    ++stats.reused;
+    LOG(INFO) << "Reuse tiling analysis of the previous attempt.";
+  } else {
+    analyzer.reset(new (std::nothrow) TilingAnalyzer(scop, sch, custom_tiling, dynamic_shape));
+    CHECK(analyzer) << "memory alloc fail";
+    bool need_tiling = analyzer->Prepare();
+    analyzer->logger_.AppendLog(DO_TILING, ss);
+    if (!need_tiling) {
+      LOG(INFO) << "No need for tiling, exit.";
+      if (!analyzer->logger_.DumpLogFile()) LOG(WARNING) << "Write tiling log fail.";
+      return std::make_pair(dims, param_info);
+    }
   }
-  TilingGenerator generator(analyzer);
-  if (analyzer.is_dynamic_) {
+  retry_cache.analyzer.reset();
+  TileLogger &logger = analyzer->logger_;
+
+  TilingGenerator generator(*analyzer);
+  if (analyzer->is_dynamic_) {
     std::tie(dims, param_info) = generator.GenerateDynamic();
-  } else if (analyzer.scop_->pragma_speedup_tiling_ && analyzer.op_type_ == VECTOR_OP) {
+  } else if (analyzer->scop_->pragma_speedup_tiling_ && analyzer->op_type_ == VECTOR_OP) {
     dims = generator.GenerateQuickly();
   } else {
     dims = generator.Generate();
+    stats.ub_limit = analyzer->retry_feedback_.ub_limit;
+    // only the traverse solver of vector kernels leaves the axis tree as analyzed
+    if (analyzer->op_type_ == VECTOR_OP && custom_tiling.empty()) {
+      // the scop and the schedule belong to this attempt, a retry rebinds its own
+      analyzer->scop_ = nullptr;
+      analyzer->sch_ = isl::schedule();
+      retry_cache.key = key;
+      retry_cache.analyzer = std::move(analyzer);
+    }
   }
 
   LOG(INFO) << "This dim is generated by auto tiling";
-  if (!analyzer.logger_.DumpLogFile()) LOG(WARNING) << "Write tiling log fail.";
+  if (!logger.DumpLogFile()) LOG(WARNING) << "Write tiling log fail.";
   return std::make_pair(dims, param_info);
 }
 
+TVM_REGISTER_API("akg.poly.tiling_retry_stats").set_body([](const TVMArgs &args, TVMRetValue *ret) {
+  const TilingRetryStats &stats = GetTilingRetryStats();
+  *ret = Array<Expr>{air::make_const(air::Int(64), stats.retries.load()),
+                     air::make_const(air::Int(64), stats.reused.load()),
+                     air::make_const(air::Int(64), stats.ub_limit.load())};
+});
+
+TVM_REGISTER_API("akg.poly.tiling_retry_stats_clear").set_body([](const TVMArgs &args, TVMRetValue *ret) {
+  TilingRetryStats &stats = GetTilingRetryStats();
+  stats.retries = 0;
+  stats.reused = 0;
+  stats.ub_limit = 0;
+});
 }  // namespace poly
+
+void ClearTilingRetryCache() {
+  poly::TilingRetryCache &retry_cache = poly::GetTilingRetryCache();
+  retry_cache.key.clear();
+  retry_cache.analyzer.reset();
+}
 }  // namespace ir
 }  // namespace akg
@@ -23,6 +23,7 @@
 #include <iostream>
 #include <utility>
 
+#include "contrib/cce_parm/hardware_profile.h"
 #include "poly/schtree_analyzer.h"
 #include "poly/space_analyzer.h"
 #include "poly/tiling_strategy_manager.h"
@@ -397,6 +398,328 @@ std::pair<int64_t, int64_t> TileCandidate::GetConstTileVal(const TileAxis *a) {
   return std::make_pair(l1, l0);
 }
 
+TileMemoryModel::AlignKind TileCandidate::GetAlignKind(const TileAxis *a, const BufferEntry *buf) const {
+  if (this->analyzer_->op_type_ != VECTOR_OP) {
+    return TileMemoryModel::ALIGN_NONE;
+  }
+  std::string align_type = "";
+  for (const auto &attr : a->attrs) {
+    if (attr.attr_key.find("ALIGN") == std::string::npos) {
+      continue;
+    }
+    std::string local_name = attr.attr_value + "_local_UB";
+    if (buf->name.find(local_name) == std::string::npos) {
+      continue;
+    }
+    std::vector<std::string> res = akg::common::Split(attr.attr_key, ":");
+    if (res.size() == 2U) {
+      align_type = res[1];
+    }
+    break;
+  }
+  if (align_type.find("TRANSPOSE") != std::string::npos) {
+    return TileMemoryModel::ALIGN_TRANSPOSE;
+  }
+  if (align_type.find("DMA") != std::string::npos) {
+    return TileMemoryModel::ALIGN_DMA;
+  }
+  if (align_type != "" || a == buf->tile_axis.get()->back()) {
+    return TileMemoryModel::ALIGN_ISOLATE;
+  }
+  return TileMemoryModel::ALIGN_NONE;
+}
+
+int64_t TileMemoryModel::ActualTile(const AxisFactor &f, int64_t tile) {
+  switch (f.align) {
+    case ALIGN_TRANSPOSE:
+      return tile * f.block_size;
+    case ALIGN_DMA: {
+      int64_t gcd = air::ir::gcd(tile, f.block_size);
+      CHECK_NE(gcd, 0);
+      return tile * f.block_size / gcd;
+    }
+    case ALIGN_ISOLATE: {
+      int64_t split = (f.divisor + tile - 1) / tile;
+      int64_t isolate_block = f.divisor - (split - 1) * tile;
+      CHECK_NE(isolate_block, 0);
+      int64_t gcd = air::ir::gcd(tile, isolate_block);
+      CHECK_NE(gcd, 0);
+      if (tile % isolate_block == 0 || gcd > f.block_size) {
+        // When no isolate or gcd of full-tiled and isolate block is greater than block size,
+        // actual tile is aligned to block size directly.
+        return (tile + f.block_size - 1) / f.block_size * f.block_size;
+      }
+      // When gcd of full-tiled and isolate block is smaller than block size,
+      // alignment will be smaller than block size, which causes terrible expansion.
+      return tile * ((f.block_size - 1 + gcd) / gcd);
+    }
+    default:
+      return tile;
+  }
+}
+
+void TileMemoryModel::BufferSize(const Buffer &buf, size_t num, const int64_t *l1, const int64_t *l0, int64_t *size,
+                                 int64_t *act_size) const {
+  const int64_t *tiles = buf.use_l0 ? l0 : l1;
+  std::vector<int64_t> f_mul(num, 1);
+  for (size_t c = 0; c < num; ++c) {
+    size[c] = buf.size;
+    act_size[c] = buf.size;
+  }
+  for (const auto &f : buf.factors) {
+    const int64_t *slot_tiles = f.slot >= 0 ? tiles + f.slot * num : nullptr;
+    for (size_t c = 0; c < num; ++c) {
+      // axes that are not tiled, or tiled by a variable, keep their whole extent
+      int64_t tile = (slot_tiles != nullptr && slot_tiles[c] != TileVarId::UNDEFINE) ? slot_tiles[c] : 1;
+      if (tile >= f.divisor) {
+        tile = f.divisor;
+      }
+      CHECK_GT(tile, 0) << "Tile factor must be positive";
+      int64_t split = f.divisor / tile;
+      int64_t actual_tile = ActualTile(f, tile);
+      CHECK_GT(actual_tile, 0);
+      f_mul[c] *= actual_tile;
+      size[c] = (size[c] + split - 1) / split;
+      if (actual_tile != tile) {
+        double act_split = static_cast<double>(f.divisor) / static_cast<double>(actual_tile);
+        if (act_split > act_size[c]) {
+          act_size[c] = 1;
+        } else {
+          act_size[c] = static_cast<int64_t>(static_cast<double>(act_size[c]) / act_split);
+        }
+      } else {
+        act_size[c] = size[c];
+      }
+    }
+  }
+  if (!buf.is_elem) {
+    return;
+  }
+  if (buf.is_bcast) {
+    // Elemwise and bcast buffer cannot be reused.
+    for (size_t c = 0; c < num; ++c) {
+      act_size[c] *= 2;
+      if (!buf.has_bc_last) {
+        continue;
+      }
+      int64_t l1_size = buf.bc_slot >= 0 ? l1[buf.bc_slot * num + c] : buf.bc_tile;
+      if (l1_size == TileVarId::UNDEFINE) {
+        l1_size = buf.bc_extent;
+      }
+      if (l1_size < buf.bc_block_size) {
+        CHECK_GT(l1_size, 0);
+        act_size[c] *= (buf.bc_block_size - 1 + l1_size) / l1_size;
+      }
+    }
+    return;
+  }
+  int64_t align = buf.elem_align;
+  for (size_t c = 0; c < num; ++c) {
+    if (f_mul[c] < align || (align != 0 && f_mul[c] % align != 0)) {
+      CHECK_GT(act_size[c], 0);
+      int64_t align_m = (f_mul[c] + align - 1) / align * align;
+      double exp = static_cast<double>(align_m) / static_cast<double>(f_mul[c]);
+      act_size[c] = static_cast<int64_t>(static_cast<double>(act_size[c]) * exp);
+    }
+  }
+}
+
+void TileMemoryModel::EvaluateBatch(size_t num, const int64_t *l1, const int64_t *l0, Result *results) const {
+  CHECK(results);
+  if (num == 0) {
+    return;
+  }
+  CHECK(slots_.empty() || (l1 != nullptr && l0 != nullptr));
+  std::vector<int64_t> live(MEM_SCOPE_BULK * num, 0);
+  std::vector<int64_t> act_live(MEM_SCOPE_BULK * num, 0);
+  std::vector<int64_t> buf_live(buffers_.size() * num, 0);
+  std::vector<int64_t> size(num);
+  std::vector<int64_t> act_size(num);
+  for (size_t c = 0; c < num; ++c) {
+    results[c] = Result();
+  }
+  for (const auto &event : events_) {
+    const Buffer &buf = buffers_[event.buffer];
+    int64_t *cur_buf = &buf_live[event.buffer * num];
+    int64_t *cur_live = &live[buf.scope * num];
+    if (!event.alloc) {
+      for (size_t c = 0; c < num; ++c) {
+        cur_live[c] -= cur_buf[c];
+        cur_buf[c] = 0;
+      }
+      continue;
+    }
+    BufferSize(buf, num, l1, l0, size.data(), act_size.data());
+    int64_t *cur_act = &act_live[buf.scope * num];
+    for (size_t c = 0; c < num; ++c) {
+      cur_buf[c] = size[c];
+      cur_live[c] += size[c];
+      cur_act[c] += act_size[c];
+      results[c].mem[buf.scope] = std::max(results[c].mem[buf.scope], cur_live[c]);
+      results[c].align_mem[buf.scope] = std::max(results[c].align_mem[buf.scope], cur_act[c]);
+    }
+  }
+}
+
+bool TileCandidate::CompileBuffer(const BufferEntry *buf, TileMemoryModel *model, TileMemoryModel::Buffer *entry) {
+  CHECK(buf);
+  const auto fix_size = buf->shape.as<IntImm>();
+  if (fix_size == nullptr) {
+    std::stringstream ss;
+    ss << "Buffer " << buf->name << " contains dynamic shape " << buf->shape << ", skip.";
+    analyzer_->logger_.AppendLog(DO_TILING, ss);
+    return false;
+  }
+  static const bool is_l0_tile[MEM_SCOPE_BULK] = {false, false, false, true, true, true};
+  auto FindPartialMatch = [](const std::string &full_name, const std::unordered_set<std::string> &name_set) -> bool {
+    for (const auto &part_name : name_set) {
+      if (full_name.find(part_name) != std::string::npos) {
+        return true;
+      }
+    }
+    return false;
+  };
+  auto SlotOf = [model](const TileAxis *a) -> int {
+    const auto &slots = model->Slots();
+    auto it = std::find(slots.begin(), slots.end(), a);
+    return it == slots.end() ? -1 : static_cast<int>(it - slots.begin());
+  };
+  entry->scope = buf->scope;
+  entry->size = buf->size * buf->expand_size * fix_size->value;
+  CHECK_GT(entry->size, 0) << "Buffer size must be positive.";
+  entry->use_l0 = is_l0_tile[buf->scope];
+  entry->is_elem = FindPartialMatch(buf->name, elem_align_buf);
+  entry->is_bcast = FindPartialMatch(buf->name, broadcast_align_buf);
+  entry->elem_align = (entry->is_elem && !entry->is_bcast) ? GetAlignBytes(buf->size) : 0;
+
+  bool this_band_buf = (buf->scope == MEM_SCOPE_GM);
+  if (buf->scope != MEM_SCOPE_GM) {
+    for (auto &it : *(buf->tile_axis)) {
+      TileAxis *a = it;
+      if (a == analyzer_->RootAxis()) {
+        continue;
+      }
+      CHECK(a);
+      if (a->index != model->Band()) {
+        continue;
+      }
+      this_band_buf = true;
+      int64_t divisor = a->GetConstExtent();
+      if (divisor == -1) {
+        continue;
+      }
+      CHECK_GT(divisor, 0) << "Axis range must be positive.";
+      TileMemoryModel::AlignKind align = GetAlignKind(a, buf);
+      int64_t block_size = align == TileMemoryModel::ALIGN_NONE ? 0 : GetAlignBytes(buf->align_size);
+      entry->factors.emplace_back(TileMemoryModel::AxisFactor{SlotOf(a), divisor, align, block_size});
+    }
+  }
+  if (!this_band_buf) {
+    return false;
+  }
+
+  entry->has_bc_last = false;
+  entry->bc_slot = -1;
+  entry->bc_tile = TileVarId::UNDEFINE;
+  entry->bc_extent = -1;
+  entry->bc_block_size = 0;
+  if (entry->is_elem && entry->is_bcast && buf->tile_axis != nullptr && !buf->tile_axis->empty()) {
+    TileAxis *bc_last = buf->tile_axis->back();
+    int64_t const_extent = bc_last->GetConstExtent();
+    if (const_extent != -1) {
+      entry->has_bc_last = true;
+      entry->bc_slot = SlotOf(bc_last);
+      entry->bc_extent = const_extent;
+      entry->bc_block_size = GetMaxAlignBytes(bc_last->data_size);
+      if (entry->bc_slot == -1) {
+        // tile of an axis outside the candidate is fixed while this model is in use
+        entry->bc_tile = this->GetConstTileVal(bc_last).first;
+        model->AddFixedTile(bc_last, entry->bc_tile);
+      }
+    }
+  }
+  return true;
+}
+
+const TileMemoryModel &TileCandidate::GetMemoryModel(int band) {
+  const auto &timetable = analyzer_->buffer_usage_timetable_;
+  bool stale = mem_model_ == nullptr || !mem_model_->Match(band, this->tile_axis_, timetable);
+  if (!stale) {
+    for (const auto &fixed : mem_model_->FixedTiles()) {
+      if (this->GetConstTileVal(fixed.first).first != fixed.second) {
+        stale = true;
+        break;
+      }
+    }
+  }
+  if (!stale) {
+    return *mem_model_;
+  }
+
+  mem_model_.reset(new (std::nothrow) TileMemoryModel(band, this->tile_axis_, timetable));
+  CHECK(mem_model_) << "memory alloc fail";
+  std::unordered_map<const BufferEntry *, size_t> index;
+  for (const auto &it : timetable) {
+    TileMemoryModel::Buffer entry;
+    if (CompileBuffer(it.first, mem_model_.get(), &entry)) {
+      index[it.first] = mem_model_->AddBuffer(entry);
+    }
+  }
+  // Replay the walk over the timetable once: a buffer is released in the first step after its last use
+  // (or after its allocation when it is allocated after its last use), and allocated at its alloc time.
+  for (auto cur_time = 0; cur_time <= static_cast<int>(timetable.size() - 1); ++cur_time) {
+    for (const auto &it : timetable) {
+      auto idx = index.find(it.first);
+      if (idx == index.end()) {
+        continue;
+      }
+      auto alloc_time = it.second.first;
+      auto last_use_time = it.second.second;
+      if (last_use_time < cur_time && (cur_time == last_use_time + 1 || cur_time == alloc_time + 1)) {
+        mem_model_->AddEvent(idx->second, false);
+      }
+      if (alloc_time == cur_time) {
+        mem_model_->AddEvent(idx->second, true);
+      }
+    }
+  }
+  return *mem_model_;
+}
+
+void TileCandidate::GetSlotTiles(const TileMemoryModel &model, std::vector<int64_t> *l1,
+                                 std::vector<int64_t> *l0) const {
+  l1->clear();
+  l0->clear();
+  for (const auto a : model.Slots()) {
+    int64_t l1_val = TileVarId::UNDEFINE;
+    int64_t l0_val = TileVarId::UNDEFINE;
+    auto it = this->tile_val_.find(a);
+    if (it != this->tile_val_.end()) {
+      if (const auto l1_imm = it->second.tile_l1.as<IntImm>()) l1_val = l1_imm->value;
+      if (const auto l0_imm = it->second.tile_l0.as<IntImm>()) l0_val = l0_imm->value;
+    }
+    l1->emplace_back(l1_val);
+    l0->emplace_back(l0_val);
+  }
+}
+
+void TileCandidate::DoMemInfer() {
+  if (UseMemInferReference()) {
+    DoMemInferReference();
+    return;
+  }
+  const TileMemoryModel &model = GetMemoryModel(tiling_band_);
+  std::vector<int64_t> l1;
+  std::vector<int64_t> l0;
+  GetSlotTiles(model, &l1, &l0);
+  MemInferResult res;
+  model.EvaluateBatch(1, l1.data(), l0.data(), &res);
+  for (int i = 0; i < MEM_SCOPE_BULK; ++i) {
+    mem_infer_[i] = res.mem[i];
+    align_mem_infer_[i] = res.align_mem[i];
+  }
+}
+
 int64_t TileCandidate::CalActualTile(const CalAlignInfo *align_info) {
   CHECK(align_info);
   int64_t actual_tile = align_info->tile;
@@ -592,7 +915,7 @@ void TileCandidate::GetElemwiseActualBufSize(const BufferEntry *buf, BufSizeInfo
   }
 }
 
-void TileCandidate::DoMemInfer() {
+void TileCandidate::DoMemInferReference() {
   std::unique_ptr<MemInferInfo> mem_infer_info(new (std::nothrow) MemInferInfo());
   CHECK(mem_infer_info) << "memory alloc fail";
 
@@ -618,6 +941,66 @@ void TileCandidate::DoMemInfer() {
   }
 }
 
+std::vector<TileCandidate::MemInferResult> TileCandidate::MemInferEach(const TileAxis *axis, TileLevel level,
+                                                                       const std::vector<int64_t> &tiles) {
+  // evaluate the factors one by one and restore the tile of axis afterwards
+  std::vector<MemInferResult> results(tiles.size());
+  auto it = this->tile_val_.find(axis);
+  bool has_val = it != this->tile_val_.end();
+  TileVal saved = has_val ? it->second : TileVal();
+  int64_t l1_val = GetConstTileVal(axis).first;
+  for (size_t c = 0; c < tiles.size(); ++c) {
+    UpdateConstTile(axis, level == LEVEL1 ? tiles[c] : l1_val, tiles[c]);
+    DoMemInfer();
+    std::copy(mem_infer_, mem_infer_ + MEM_SCOPE_BULK, results[c].mem);
+    std::copy(align_mem_infer_, align_mem_infer_ + MEM_SCOPE_BULK, results[c].align_mem);
+  }
+  if (has_val) {
+    this->tile_val_[axis] = saved;
+  } else {
+    this->tile_val_.erase(axis);
+  }
+  is_update_ = false;
+  return results;
+}
+
+std::vector<TileCandidate::MemInferResult> TileCandidate::MemInferSweep(const TileAxis *axis, TileLevel level,
+                                                                        const std::vector<int64_t> &tiles,
+                                                                        int band_idx) {
+  std::vector<MemInferResult> results(tiles.size());
+  if (tiles.empty()) {
+    return results;
+  }
+  tiling_band_ = band_idx;
+  if (UseMemInferReference()) {
+    return MemInferEach(axis, level, tiles);
+  }
+  const TileMemoryModel &model = GetMemoryModel(band_idx);
+  const auto &slots = model.Slots();
+  auto swept = std::find(slots.begin(), slots.end(), axis);
+  if (swept == slots.end()) {
+    // axis is not part of the candidate
+    return MemInferEach(axis, level, tiles);
+  }
+
+  size_t num = tiles.size();
+  size_t swept_slot = static_cast<size_t>(swept - slots.begin());
+  std::vector<int64_t> cur_l1;
+  std::vector<int64_t> cur_l0;
+  GetSlotTiles(model, &cur_l1, &cur_l0);
+  std::vector<int64_t> l1(slots.size() * num);
+  std::vector<int64_t> l0(slots.size() * num);
+  for (size_t s = 0; s < slots.size(); ++s) {
+    for (size_t c = 0; c < num; ++c) {
+      bool is_swept = (s == swept_slot);
+      l1[s * num + c] = (is_swept && level == LEVEL1) ? tiles[c] : cur_l1[s];
+      l0[s * num + c] = is_swept ? tiles[c] : cur_l0[s];
+    }
+  }
+  model.EvaluateBatch(num, l1.data(), l0.data(), results.data());
+  return results;
+}
+
 /*
  * This function returns current data size moved from local buffer (UB in Davinci)
  * to main memory (GM in Davinci) within target axis.
@@ -1411,6 +1794,13 @@ bool TilingAnalyzer::Prepare() {
   return true;
 }
 
+void TilingAnalyzer::Rebind(Scop *scop, const isl::schedule &sch) {
+  CHECK(scop);
+  scop_ = scop;
+  binds_ = scop->binds_;
+  sch_ = sch;
+}
+
 void TilingAnalyzer::ForEachAxisTopDown(const std::function<void(TileAxis *)> &fn, TileAxis *top) const {
   std::vector<TileAxis *> stack;
   if (top == nullptr) {
@@ -1561,10 +1951,15 @@ TilingAnalyzer::VarNames TilingAnalyzer::VisitVarNames(const Expr &arg, VarNames
   return var_names;
 }
 
+size_t TileCandidate::GetMemInferBatch() {
+  int batch = global_attrs.GetIntAttr(kMemInferBatch, static_cast<int>(MEM_INFER_BATCH));
+  return batch > 0 ? static_cast<size_t>(batch) : MEM_INFER_BATCH;
+}
+
+bool TileCandidate::UseMemInferReference() { return global_attrs.GetBoolAttr(kMemInferReference, false); }
+
 int TileCandidate::GetCoreNumConf() {
-  cceconf::CceConf *conf = cceconf::CceConf::getInstance();
-  CHECK(conf);
-  int product_block = conf->getCoreValue("Core_num");
+  int product_block = cceconf::HardwareProfile::getInstance()->getCoreNum();
   int user_defined_block = global_attrs.GetIntAttr(kEnableMulticore, -1);
   if (user_defined_block == -1) {
     // User is not defining core num, assume we can use maximal number.
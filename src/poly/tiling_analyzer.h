@@ -51,10 +51,9 @@ constexpr auto DUMP_LEVEL_CANDIDATE = 2;
 constexpr auto DUMP_LEVEL_TUNING = 3;
 constexpr auto DUMP_LINE_BREAK_NUM = 100;
 constexpr auto GEN_PRIME_NUM = 32;
-constexpr auto VECTORIZE_BYTE = 256;
 constexpr auto MAX_REPEAT = 255;
 constexpr auto MIN_CORE_GRANULARITY = 256;
-constexpr auto DESIRE_CORE_GRANULARITY = 8192;  // 256 Bytes * 64 repeat
+constexpr size_t MEM_INFER_BATCH = 64;  // tile factors whose memory is inferred together
 
 // Controlled by custom tiling.
 constexpr auto ALLOCATION_PERCENTAGE = 0.5;  // reserved for double buffer in default
@@ -214,6 +213,12 @@ class TilingAnalyzer {
   }
   ~TilingAnalyzer() = default;
 
+  // Feedback of the last solve on this analysis, used when the same kernel is retried by micro-tuning.
+  struct RetryFeedback {
+    int64_t ub_limit{0};  // UB limit the solver used
+    int64_t ub_usage{0};  // UB the memory model predicted for the chosen tiling
+  };
+
   // represent a buffer
   struct BufferEntry {
     std::string name;
@@ -239,6 +244,8 @@ class TilingAnalyzer {
   air::arith::Analyzer arith_ana_;
   ExprSimplifier expr_ac_;
   bool Prepare();
+  // Attach an analysis kept from a previous attempt to the scop and schedule of a retry of the same kernel.
+  void Rebind(Scop *scop, const isl::schedule &sch);
 
   void ForEachAxisTopDown(const std::function<void(TileAxis *)> &fn, TileAxis *top = nullptr) const;
 
@@ -266,7 +273,7 @@ class TilingAnalyzer {
   TileOpType op_type_;
   Scop *scop_;
   Stmt body_;
-  Scop::Binds &binds_;
+  Scop::Binds binds_;
   isl::schedule sch_;
   std::vector<NodeRef> custom_tiling_{};
   std::vector<NodeRef> dynamic_shape_{};
@@ -286,6 +293,7 @@ class TilingAnalyzer {
   VarNames FilterOutput_Matrix = {"C1_out", "kh", "kw", "C1_in", "C0_in", "C0_out"};
   VarNames FilterInput_Matrix = {"N", "C1_out", "H", "W", "C0_out"};
   bool is_dynamic_{false};
+  RetryFeedback retry_feedback_;
   std::unordered_map<TilingAnalyzer::BufferEntry *, std::pair<int, int>> buffer_usage_timetable_;
   std::unordered_map<std::string, std::shared_ptr<BufferEntry>> buf_info_;
 
@@ -294,6 +302,85 @@ class TilingAnalyzer {
   std::unique_ptr<TileAxis> root_axis_;
 };
 
+/*!
+ * \brief Memory model of one band, compiled from the buffer usage timetable.
+ *
+ *  Buffer names, axis attrs and extents are resolved once per band and set of tiled axes, evaluating a
+ *  candidate then only does integer arithmetic on its tile factors. Factors of the tiled axes (slots) are
+ *  passed slot-major, l1[slot * num + c] for candidate c, so the inner loops run over candidates.
+ */
+class TileMemoryModel {
+ public:
+  enum AlignKind { ALIGN_NONE = 0, ALIGN_TRANSPOSE, ALIGN_DMA, ALIGN_ISOLATE };
+  struct AxisFactor {
+    int slot;  // index in tiled axes, -1 for an axis that is not tiled
+    int64_t divisor;
+    AlignKind align;
+    int64_t block_size;
+  };
+  struct Buffer {
+    DavinciMemScope scope;
+    int64_t size;
+    bool use_l0;
+    std::vector<AxisFactor> factors;
+    bool is_elem;
+    bool is_bcast;
+    int64_t elem_align;
+    // last axis of a broadcast buffer, tile is read from bc_slot or fixed to bc_tile
+    bool has_bc_last;
+    int bc_slot;
+    int64_t bc_tile;
+    int64_t bc_extent;
+    int64_t bc_block_size;
+  };
+  struct Event {
+    size_t buffer;
+    bool alloc;
+  };
+  /*! \brief Max live size and max aligned live size of one candidate, indexed by DavinciMemScope */
+  struct Result {
+    int64_t mem[MEM_SCOPE_BULK]{0};
+    int64_t align_mem[MEM_SCOPE_BULK]{0};
+  };
+
+  using Timetable = std::unordered_map<TilingAnalyzer::BufferEntry *, std::pair<int, int>>;
+
+  TileMemoryModel(int band, std::vector<TileAxis *> slots, Timetable timetable)
+      : band_(band), slots_(std::move(slots)), timetable_(std::move(timetable)) {}
+  ~TileMemoryModel() = default;
+
+  /*! \brief The model is reusable only if it was compiled from the same buffers with the same live ranges */
+  bool Match(int band, const std::vector<TileAxis *> &slots, const Timetable &timetable) const {
+    return band == band_ && slots == slots_ && timetable == timetable_;
+  }
+  int Band() const { return band_; }
+  size_t SlotNum() const { return slots_.size(); }
+  const std::vector<TileAxis *> &Slots() const { return slots_; }
+
+  size_t AddBuffer(const Buffer &buf) {
+    buffers_.emplace_back(buf);
+    return buffers_.size() - 1;
+  }
+  void AddEvent(size_t buffer, bool alloc) { events_.emplace_back(Event{buffer, alloc}); }
+  void AddFixedTile(const TileAxis *axis, int64_t tile) { fixed_tiles_.emplace_back(axis, tile); }
+  const std::vector<std::pair<const TileAxis *, int64_t>> &FixedTiles() const { return fixed_tiles_; }
+
+  /*! \brief Evaluate num candidates, tile factors that are not constant are passed as TileVarId::UNDEFINE */
+  void EvaluateBatch(size_t num, const int64_t *l1, const int64_t *l0, Result *results) const;
+
+ private:
+  static int64_t ActualTile(const AxisFactor &f, int64_t tile);
+  void BufferSize(const Buffer &buf, size_t num, const int64_t *l1, const int64_t *l0, int64_t *size,
+                  int64_t *act_size) const;
+
+  int band_;
+  std::vector<TileAxis *> slots_;
+  Timetable timetable_;
+  std::vector<Buffer> buffers_;
+  std::vector<Event> events_;
+  std::vector<std::pair<const TileAxis *, int64_t>> fixed_tiles_;
+};
+
 class TileCandidate {
  public:
   explicit TileCandidate(TilingAnalyzer *analyzer) : analyzer_(analyzer) {
@@ -307,6 +394,8 @@ class TileCandidate {
   }
   ~TileCandidate() = default;
   using BufferEntry = TilingAnalyzer::BufferEntry;
+  using MemInferResult = TileMemoryModel::Result;
+  // state of the reference walk over the timetable, see DoMemInferReference
   struct MemInferInfo {
     int64_t live_size[MEM_SCOPE_BULK]{0};
     int64_t actual_live_size[MEM_SCOPE_BULK]{0};
@@ -359,6 +448,13 @@ class TileCandidate {
 
   bool SpaceVerify(const TileAxis *axis, TileLevel level, int band);
   std::pair<int64_t, int64_t> MemInfer(DavinciMemScope type, int band);
+  /*!
+   * \brief Memory of the current candidate with the tile of axis at level set to each of tiles.
+   *
+   *  Same results as calling UpdateConstTile and MemInfer for every factor, without changing the candidate.
+   */
+  std::vector<MemInferResult> MemInferSweep(const TileAxis *axis, TileLevel level, const std::vector<int64_t> &tiles,
+                                            int band);
 
   void InsertAxisBack(TileAxis *a) {
     this->tile_axis_.emplace_back(a);
@@ -366,6 +462,7 @@ class TileCandidate {
     is_update_ = false;
   }
   int TileAxisSize() const { return static_cast<int>(this->tile_axis_.size()); }
+  TileMemoryModel::AlignKind GetAlignKind(const TileAxis *a, const BufferEntry *buf) const;
   void UpdateMemoryAfterBuffer(const BufferEntry *buf, MemInferInfo *mem_infer_info);
   bool GetActualBufSize(const BufferEntry *buf, BufSizeInfo *buf_size_info);
   void GetElemwiseActualBufSize(const BufferEntry *buf, BufSizeInfo *buf_size_info);
@@ -380,6 +477,8 @@ class TileCandidate {
     std::sort(this->tile_axis_.begin(), this->tile_axis_.end(), priority_cmp);
   }
   static int GetCoreNumConf();
+  static size_t GetMemInferBatch();
+  static bool UseMemInferReference();
   int GetMinFactorToEnableMulticore(TileAxis *axis);
   int GetMaximalPendingBlocks(TileAxis *excluded_axis);
   int GetDmaCopySizeWithinAxis(TileAxis *axis);
@@ -387,6 +486,12 @@ class TileCandidate {
 
  private:
   void DoMemInfer();
+  // the walk over the timetable for one candidate that the memory model replaces, kept to check the model against
+  void DoMemInferReference();
+  std::vector<MemInferResult> MemInferEach(const TileAxis *axis, TileLevel level, const std::vector<int64_t> &tiles);
+  const TileMemoryModel &GetMemoryModel(int band);
+  bool CompileBuffer(const BufferEntry *buf, TileMemoryModel *model, TileMemoryModel::Buffer *entry);
+  void GetSlotTiles(const TileMemoryModel &model, std::vector<int64_t> *l1, std::vector<int64_t> *l0) const;
 
   std::vector<TileAxis *> tile_axis_;
   TilingAnalyzer *analyzer_;
@@ -396,6 +501,7 @@ class TileCandidate {
   std::unordered_set<std::string> broadcast_align_buf;
   int64_t mem_infer_[MEM_SCOPE_BULK]{0};
   int64_t align_mem_infer_[MEM_SCOPE_BULK]{0};
+  std::unique_ptr<TileMemoryModel> mem_model_{nullptr};
 };
 }  // namespace poly
 }  // namespace ir
@@ -71,6 +71,31 @@ double TilingSolver::GetNewAllocRatioWhenRewriteFail(int64_t memory_bits) {
   return adjust_ratio;
 }
 
+/*
+ * When the analysis is kept from the failed attempt, the model's prediction of the failed tiling is known.
+ * The ratio between the actual allocation and that prediction is how much the model underestimates this
+ * kernel, so the limit is scaled to let the next tiling fit in the memory size directly.
+ * e.g.
+ *  memory size 256KB, predicted 100KB, actual allocation 320KB
+ *  limit      : 256KB * 100KB / 320KB = 80KB
+ * Returns 0 when there is no feedback of a previous attempt.
+ */
+int64_t TilingSolver::GetLearnedLimitWhenRewriteFail(int64_t memory_size) {
+  const auto &feedback = analyzer_.retry_feedback_;
+  auto actual_allocs = global_attrs.GetFloatAttr(kAllocBits, 0.0) / 8;
+  if (feedback.ub_limit <= 0 || feedback.ub_usage <= 0 || actual_allocs <= 0) {
+    return 0;
+  }
+  auto limit = static_cast<int64_t>(static_cast<double>(memory_size) * feedback.ub_usage / actual_allocs);
+  // always shrink, so that retries cannot pick the failed tiling again
+  limit = std::max<int64_t>(std::min(limit, feedback.ub_limit - 1), 1);
+  std::stringstream ss;
+  ss << "Predicted " << feedback.ub_usage << " bytes but allocated " << actual_allocs
+     << " bytes, adjust memory limit to " << limit << " and retry tiling.";
+  analyzer_.logger_.AppendLog(MICRO_TUNING, ss);
+  return limit;
+}
+
 void TilingSolver::CollectMemoryLimit() {
   // Init memory allocation percentage.
   percentage_ = ALLOCATION_PERCENTAGE;
@@ -95,11 +120,21 @@ void TilingSolver::CollectMemoryLimit() {
   // Init memory limit for each scope and reduce ratio of local.UB if storage rewrite fails previously.
   DavinciInfo &d_info = DavinciInfo::GetInstance();
   auto error_scope = global_attrs.GetStringAttr(kErrorScope, "");
+  // bytes of local.UB to plan for instead of the share of its size, the learned limit of a retry still applies
+  int64_t ub_limit = global_attrs.GetIntAttr(kTilingUBLimit, 0);
   for (auto i = 0; i < MEM_SCOPE_BULK; ++i) {
     this->mem_limit_[i] = d_info.GetMemoryLimitInScope(i) * percentage_;
+    if (i == DavinciMemScope::MEM_SCOPE_UB && ub_limit > 0) {
+      this->mem_limit_[i] = ub_limit;
+    }
     if (i == DavinciMemScope::MEM_SCOPE_UB && error_scope == "local.UB") {
-      this->mem_limit_[i] =
-        std::max(static_cast<int>(this->mem_limit_[i] * GetNewAllocRatioWhenRewriteFail(this->mem_limit_[i])), 1);
+      int64_t learned = GetLearnedLimitWhenRewriteFail(d_info.GetMemoryLimitInScope(i));
+      if (learned > 0) {
+        this->mem_limit_[i] = learned;
+      } else {
+        this->mem_limit_[i] =
+          std::max(static_cast<int>(this->mem_limit_[i] * GetNewAllocRatioWhenRewriteFail(this->mem_limit_[i])), 1);
+      }
       global_attrs.Set(kErrorScope, StringImm::make(""));
     }
   }
@@ -817,6 +852,8 @@ void DynamicShapeSolver::AppendTileConstraintInIR(TileCandidate *cand, TileLevel
 
 TileCandidate *TraverseSolver::Solve() {
   CollectMemoryLimit();
+  analyzer_.retry_feedback_.ub_limit = mem_limit_[MEM_SCOPE_UB];
+  analyzer_.retry_feedback_.ub_usage = 0;
 
   auto tile_band_size = static_cast<int>(analyzer_.RootAxis()->children.size());
   for (auto band = 0; band < tile_band_size; ++band) {
@@ -856,6 +893,8 @@ TileCandidate *TraverseSolver::Solve() {
       MakeL1L0Consistency(mo_axes);
       MakeL1L0Consistency(no_axes);
     }
+    analyzer_.retry_feedback_.ub_usage =
+      std::max(analyzer_.retry_feedback_.ub_usage, cand_.MemInfer(MEM_SCOPE_UB, band).second);
   }
 
   if (analyzer_.op_type_ == CONV_OP) {
@@ -923,14 +962,21 @@ bool TraverseSolver::IsTilable(TileInfo *info) {
 }
 
 bool TraverseSolver::MemoryVerify(TileLevel level, int band, int64_t *deviation) {
+  TileCandidate::MemInferResult mem;
+  for (int i = 0; i < MEM_SCOPE_BULK; ++i) {
+    std::tie(mem.mem[i], mem.align_mem[i]) = cand_.MemInfer(static_cast<DavinciMemScope>(i), band);
+  }
+  return MemoryVerify(level, mem, deviation);
+}
+
+bool TraverseSolver::MemoryVerify(TileLevel level, const TileCandidate::MemInferResult &mem, int64_t *deviation) {
   std::vector<int64_t> original_size;
   std::vector<int64_t> expanded_size;
   int dev = 0;
   for (int i = 0; i < MEM_SCOPE_BULK; ++i) {
     auto scope = static_cast<DavinciMemScope>(i);
-    std::pair<int64_t, int64_t> mem_pair = cand_.MemInfer(scope, band);
-    int64_t origin = mem_pair.first;
-    int64_t expand = mem_pair.second;
+    int64_t origin = mem.mem[i];
+    int64_t expand = mem.align_mem[i];
     int dev_a = EXCEED_MEM_CODE;
     if (origin <= mem_limit_[scope]) {
       dev_a = mem_limit_[scope] - origin;
@@ -999,44 +1045,58 @@ bool TraverseSolver::DoTiling(const TileInfo *info) {
   std::stringstream ss;
   ss << "start to tile from " << init << " to " << dst;
   analyzer_.logger_.AppendLog(DO_TILING, ss);
-  for (int64_t t = init; t <= dst; ++t) {
-    if ((axis->forbid_iso && dst % t != 0) || (check_mod && t % mod != 0)) {
-      continue;
-    }
-    if (info->level == LEVEL1) {
-      cand_.UpdateConstTile(axis, t);
-    } else {
-      cand_.UpdateConstTile(axis, cand_.GetConstTileVal(axis).first, t);
+  // Factors are verified in chunks, memory of all factors of a chunk is inferred in one batch.
+  std::vector<int64_t> factors;
+  const size_t batch = TileCandidate::GetMemInferBatch();
+  bool exceed = false;
+  for (int64_t t = init; t <= dst && !exceed;) {
+    factors.clear();
+    for (; t <= dst && factors.size() < batch; ++t) {
+      if ((axis->forbid_iso && dst % t != 0) || (check_mod && t % mod != 0)) {
+        continue;
+      }
+      if (info->level == LEVEL1) {
+        cand_.UpdateConstTile(axis, t);
+      } else {
+        cand_.UpdateConstTile(axis, cand_.GetConstTileVal(axis).first, t);
+      }
+      if (cand_.SpaceVerify(axis, info->level, info->band)) {
+        factors.emplace_back(t);
+      }
     }
+    std::vector<TileCandidate::MemInferResult> mems = cand_.MemInferSweep(axis, info->level, factors, info->band);
 
-    if (!cand_.SpaceVerify(axis, info->level, info->band)) continue;
-    bool mem_ok = MemoryVerify(info->level, info->band, &deviation);
+    for (size_t i = 0; i < factors.size(); ++i) {
+      int64_t factor = factors[i];
+      bool mem_ok = MemoryVerify(info->level, mems[i], &deviation);
 
-    if (deviation < 0) {
-      ss << "factor " << t << " exceed memory, exit";
-      analyzer_.logger_.AppendLog(DO_TILING, ss);
-      break;
-    }
+      if (deviation < 0) {
+        ss << "factor " << factor << " exceed memory, exit";
+        analyzer_.logger_.AppendLog(DO_TILING, ss);
+        exceed = true;
+        break;
+      }
 
-    if (!mem_ok) continue;
-    success = true;
-    auto tail = dst % t;
-    if (tail == 0) {
-      if (deviation > best_no_iso_devs) continue;
-      ss << "factor " << t << " has " << deviation << " deviation, update to no isolate factor";
-      best_no_iso_val = t;
-      best_no_iso_devs = deviation;
-    } else {
-      if (deviation > best_devs) continue;
-      if (analyzer_.scop_->pragma_allow_tail_tiling_ && tail < GetMaxAlignBytes(axis->data_size)) {
-        ss << "factor " << t << " has " << tail << " tail that may disable multicore, skip.";
-        continue;
+      if (!mem_ok) continue;
+      success = true;
+      auto tail = dst % factor;
+      if (tail == 0) {
+        if (deviation > best_no_iso_devs) continue;
+        ss << "factor " << factor << " has " << deviation << " deviation, update to no isolate factor";
+        best_no_iso_val = factor;
+        best_no_iso_devs = deviation;
+      } else {
+        if (deviation > best_devs) continue;
+        if (analyzer_.scop_->pragma_allow_tail_tiling_ && tail < GetMaxAlignBytes(axis->data_size)) {
+          ss << "factor " << factor << " has " << tail << " tail that may disable multicore, skip.";
+          continue;
+        }
+        ss << "factor " << factor << " has " << deviation << " deviation, update to isolate factor";
+        best_val = factor;
+        best_devs = deviation;
       }
-      ss << "factor " << t << " has " << deviation << " deviation, update to isolate factor";
-      best_val = t;
-      best_devs = deviation;
+      analyzer_.logger_.AppendLog(DO_TILING, ss);
     }
-    analyzer_.logger_.AppendLog(DO_TILING, ss);
   }
 
   int64_t final_factor = (axis->forbid_iso || best_no_iso_val * balance_factor > best_val) ? best_no_iso_val : best_val;
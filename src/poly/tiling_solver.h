@@ -32,6 +32,7 @@ class TilingSolver {
   void CollectTileAxisTopDown();
   double GetNewAllocRatioWhenFlattenFail(const std::string &error_info);
   double GetNewAllocRatioWhenRewriteFail(int64_t memory_bits);
+  int64_t GetLearnedLimitWhenRewriteFail(int64_t memory_size);
   TileCandidate *Solve();
 
   TilingAnalyzer &analyzer_;
@@ -113,6 +114,7 @@ class TraverseSolver : TilingSolver {
   };
   bool IsTilable(TileInfo *info);
   bool MemoryVerify(TileLevel level, int band, int64_t *deviation = nullptr);
+  bool MemoryVerify(TileLevel level, const TileCandidate::MemInferResult &mem, int64_t *deviation = nullptr);
   bool DoTiling(const TileInfo *info);
   int64_t PostprocessFinalFactor(int64_t final_factor, TileAxis *axis);
   void AppendConvPragma();
@@ -16,6 +16,7 @@
 #include "poly/tiling_strategy_manager.h"
 #include <numeric>
 #include <iostream>
+#include "contrib/cce_parm/hardware_profile.h"
 
 namespace akg {
 namespace ir {
@@ -236,7 +237,8 @@ void VectorizedStrategy::AddConstraint() {
     }
     min_byte = min_byte == -1 ? 1 : min_byte;
     CHECK_GT(min_byte, 0);
-    axis->l1_constraints.tile_mod_ = CanonicalSimplify(CastIntToExpr(VECTORIZE_BYTE / min_byte));
+    int64_t vector_bytes = cceconf::HardwareProfile::getInstance()->getVectorBytes();
+    axis->l1_constraints.tile_mod_ = CanonicalSimplify(CastIntToExpr(vector_bytes / min_byte));
   }
 }
 
@@ -464,7 +466,7 @@ int MulticoreStrategy::GetProposalCoreNum() {
   }
 
   if (problem_size < max_core * MIN_CORE_GRANULARITY * MAX_REPEAT) {
-    max_core = static_cast<int>(problem_size / DESIRE_CORE_GRANULARITY);
+    max_core = static_cast<int>(problem_size / cceconf::HardwareProfile::getInstance()->getCoreGranularity());
     if (max_core > 2 && max_core % 2 != 0) {
       max_core--;
     }
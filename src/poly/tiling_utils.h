@@ -42,28 +42,21 @@ class DavinciInfo {
     return hardware_info;
   }
 
+  // the limits are read on every call, they follow the hardware profile loaded last
   int64_t GetMemoryLimitInScope(int scope_idx) {
     CHECK_LT(scope_idx, MEM_SCOPE_BULK);
-    return davinci_mem_limit_[scope_idx];
+    static const char *const scopes[MEM_SCOPE_BULK] = {nullptr,     "local.UB",  "local.L1",
+                                                       "local.L0A", "local.L0B", "local.L0C"};
+    if (scopes[scope_idx] == nullptr) {
+      return 0;
+    }
+    air::MemoryInfo info = air::GetMemoryInfo(scopes[scope_idx]);
+    CHECK(info.defined());
+    return info->max_num_bits / 8;
   }
 
  private:
-  DavinciInfo() { InitDavinciMemoryLimit(); }
-  int64_t davinci_mem_limit_[MEM_SCOPE_BULK]{0};
-
-  void InitDavinciMemoryLimit() {
-    auto CollectLimit = [this](const std::string &scope, DavinciMemScope mem) {
-      air::MemoryInfo info = air::GetMemoryInfo(scope);
-      CHECK(info.defined());
-      davinci_mem_limit_[mem] = info->max_num_bits / 8;
-    };
-    CollectLimit("local.UB", MEM_SCOPE_UB);
-    CollectLimit("local.L1", MEM_SCOPE_L1);
-    CollectLimit("local.L0A", MEM_SCOPE_L0A);
-    CollectLimit("local.L0B", MEM_SCOPE_L0B);
-    CollectLimit("local.L0C", MEM_SCOPE_L0C);
-    davinci_mem_limit_[MEM_SCOPE_GM] = 0;
-  }
+  DavinciInfo() {}
 };
 
 class TileLogger {
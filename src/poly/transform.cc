@@ -22,9 +22,11 @@
 #include <climits>
 #include <fstream>
 #include <queue>
+#include <sstream>
 #include <cmath>
 
 #include "poly/reschedule.h"
+#include "poly/schedule_cache.h"
 #include "poly/dump_log.h"
 
 namespace akg {
@@ -116,7 +118,82 @@ isl::schedule Transform::ComputeSchedule() {
     CHECK(status == isl_stat_ok);
   }
 
-  return constraints_.compute_schedule();
+  isl::schedule sch;
+  std::string cache_key;
+  // a dynamic kernel is scheduled once for every shape, the dynamic tiling reads its parameter bounds
+  bool use_schedule_cache = scop_.enable_schedule_cache_ && !scop_.is_dynamic_;
+  if (use_schedule_cache) {
+    // the scheduler options in effect are part of the key
+    std::ostringstream options;
+    options << isl_options_get_schedule_unit_max_var_coefficient_sum(ctx) << " "
+            << isl_options_get_schedule_nonneg_var_coefficient(ctx) << " "
+            << isl_options_get_schedule_max_coefficient(ctx) << " " << isl_options_get_schedule_max_constant_term(ctx)
+            << " " << isl_options_get_schedule_maximize_band_depth(ctx) << " "
+            << isl_options_get_schedule_maximize_coincidence(ctx) << " "
+            << isl_options_get_schedule_outer_coincidence(ctx) << " " << isl_options_get_schedule_whole_component(ctx)
+            << " " << isl_options_get_schedule_serialize_sccs(ctx) << "\n";
+    cache_key = options.str() + constraints_.to_str();
+    bool hit = LoadCachedSchedule(cache_key, sch);
+    ScheduleCache::GetInstance()->Record(hit);
+    if (hit) {
+      return sch;
+    }
+  }
+
+  if (scop_.isl_max_operations_ <= 0) {
+    sch = constraints_.compute_schedule();
+  } else {
+    // bound the work of the isl scheduler, a quota error keeps the schedule in program order
+    isl_ctx_reset_operations(ctx);
+    isl_ctx_set_max_operations(ctx, static_cast<unsigned long>(scop_.isl_max_operations_));
+    sch = schedule_;
+    try {
+      sch = constraints_.compute_schedule();
+    } catch (const isl::exception_quota &) {
+      LOG(WARNING) << "isl scheduler exceeded " << scop_.isl_max_operations_
+                   << " operations, keep the original schedule";
+      schedule_budget_exceeded_ = true;
+      // the ctx keeps isl_error_quota until reset, later isl calls on it would fail as well
+      isl_ctx_reset_error(ctx);
+      isl_ctx_reset_operations(ctx);
+    }
+    isl_ctx_set_max_operations(ctx, 0);
+    isl_ctx_reset_operations(ctx);
+  }
+
+  if (use_schedule_cache && !schedule_budget_exceeded_) {
+    std::string sch_str = sch.to_str();
+    ScheduleCache::GetInstance()->Insert(cache_key, scop_.schedule_cache_dir_, sch_str);
+    if (scop_.schedule_cache_any_shape_) {
+      ScheduleCache::GetInstance()->Insert(AbstractScheduleKey(cache_key), scop_.schedule_cache_dir_, sch_str);
+    }
+  }
+  return sch;
+}
+
+bool Transform::LoadCachedSchedule(const std::string &key, isl::schedule &schedule) {
+  auto cache = ScheduleCache::GetInstance();
+  std::string cached;
+  if (cache->Lookup(key, scop_.schedule_cache_dir_, &cached)) {
+    isl_schedule *res = isl_schedule_read_from_str(constraints_.ctx().get(), cached.c_str());
+    if (res != nullptr) {
+      schedule = isl::manage(res);
+      return true;
+    }
+  }
+  if (!scop_.schedule_cache_any_shape_ ||
+      !cache->Lookup(AbstractScheduleKey(key), scop_.schedule_cache_dir_, &cached)) {
+    return false;
+  }
+  try {
+    if (ReuseScheduleOnDomain(cached, constraints_, &schedule)) {
+      LOG(INFO) << "reuse cached schedule of a kernel with other extents";
+      return true;
+    }
+  } catch (const isl::exception &e) {
+    LOG(WARNING) << "cannot reuse cached schedule: " << e.what();
+  }
+  return false;
 }
 
 isl::union_map Transform::ComputeAllDependences() {
@@ -127,6 +127,7 @@ class Transform {
   isl::union_map ComputeAllDependences();
 
   isl::schedule ComputeSchedule();
+  bool LoadCachedSchedule(const std::string &key, isl::schedule &schedule);
   isl::schedule SinkLastAxis(const isl::schedule &sch);
   isl::schedule SinkC0(const isl::schedule &sch);
   isl::schedule_node SinkC0Schedule(isl::schedule_node &node);
@@ -246,6 +247,8 @@ class Transform {
                   int size, int64_t current_value, int64_t current_max);
   isl::union_set_list DependenciesTopsort(const isl::union_set_list &filterlist);
   bool HasInvariantDependence() { return has_invariant_dependence_; }
+  // the isl scheduler gave up within isl_max_operations, the schedule is kept in program order
+  bool IsScheduleBudgetExceeded() const { return schedule_budget_exceeded_; }
 
  private:
   bool has_grouped_;
@@ -305,6 +308,8 @@ class Transform {
   std::map<std::string, int> invariant_state_;
 
   bool has_invariant_dependence_ = false;
+
+  bool schedule_budget_exceeded_ = false;
 };
 
 }  // namespace poly
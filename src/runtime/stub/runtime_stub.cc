@@ -19,6 +19,7 @@
 #include <cce/dnn.h>
 #include <dmlc/logging.h>
 
+#include <cstring>
 #include <iostream>
 
 #include "prof_mgr_core.h"
@@ -42,6 +43,15 @@ rtError_t rtEventCreate(rtEvent_t *event) {
   return RT_ERROR_NONE;
 }
 
+rtError_t rtEventDestroy(rtEvent_t event) {
+  delete[] reinterpret_cast<int *>(event);
+  return RT_ERROR_NONE;
+}
+
+rtError_t rtEventRecord(rtEvent_t event, rtStream_t stream) { return RT_ERROR_NONE; }
+
+rtError_t rtEventSynchronize(rtEvent_t event) { return RT_ERROR_NONE; }
+
 rtError_t rtMalloc(void **devPtr, uint64_t size, rtMemType_t type) {
   FUNC_ENTRY
   CHECK_GT(size, 0);
@@ -58,6 +68,20 @@ rtError_t rtFree(void *devPtr) {
   return RT_ERROR_NONE;
 }
 
+rtError_t rtMallocHost(void **hostPtr, uint64_t size) {
+  CHECK_GT(size, 0);
+  *hostPtr = new (std::nothrow) uint8_t[size];
+  if (*hostPtr == nullptr) {
+    return RT_ERROR_MEMORY_ALLOCATION;
+  }
+  return RT_ERROR_NONE;
+}
+
+rtError_t rtFreeHost(void *hostPtr) {
+  delete[] reinterpret_cast<uint8_t *>(hostPtr);
+  return RT_ERROR_NONE;
+}
+
 rtError_t rtStreamCreate(rtStream_t *stream, int32_t priority) {
   *stream = new (std::nothrow) uint32_t;
   if (*stream == nullptr) {
@@ -81,15 +105,22 @@ rtError_t rtStreamSynchronize(rtStream_t stream) {
   return RT_ERROR_NONE;
 }
 
+// device memory of the stub lives on the host, so copies are plain memcpy in every direction
 rtError_t rtMemcpy(void *dst, uint64_t destMax, const void *src, uint64_t count, rtMemcpyKind_t kind) {
   FUNC_ENTRY
+  if (count > destMax) {
+    return RT_ERROR_INVALID_VALUE;
+  }
+  if (count > 0) {
+    memcpy(dst, src, count);
+  }
   return RT_ERROR_NONE;
 }
 
 rtError_t rtMemcpyAsync(void *dst, uint64_t destMax, const void *src, uint64_t count, rtMemcpyKind_t kind,
                         rtStream_t stream) {
   FUNC_ENTRY
-  return RT_ERROR_NONE;
+  return rtMemcpy(dst, destMax, src, count, kind);
 }
 
 rtError_t rtStreamWaitEvent(rtStream_t stream, rtEvent_t event) { return RT_ERROR_NONE; }
@@ -18,6 +18,8 @@
 #include <tvm/schedule_pass.h>
 #include <tvm.h>
 
+#include "build_module.h"
+
 namespace air {
 namespace schedule {
 bool IsElemWise(const Operation &op);
@@ -120,7 +122,155 @@ void GetConvInputName(const Operation &op, std::unordered_set<std::string> &inpu
   }
 }
 
-void AutoInline(Schedule sch) {
+// Rough cycles per element of the CCE vector instructions an expression lowers to.
+constexpr double kSimpleOpCost = 1.0;
+constexpr double kDivOpCost = 4.0;
+constexpr double kTranscendentalOpCost = 8.0;
+// a materialized stage costs one UB store and one UB load per element
+constexpr double kUbStoreLoadCost = 2.0;
+
+// cost of evaluating an expression once, producers that are already inlined are expanded
+class InlineCost : public IRVisitor {
+ public:
+  explicit InlineCost(const std::unordered_map<const Node *, double> &inlined_cost) : inlined_cost_(inlined_cost) {}
+  ~InlineCost() override = default;
+
+  void Visit_(const Add *op) final { Count(kSimpleOpCost, op); }
+  void Visit_(const Sub *op) final { Count(kSimpleOpCost, op); }
+  void Visit_(const Mul *op) final { Count(kSimpleOpCost, op); }
+  void Visit_(const Min *op) final { Count(kSimpleOpCost, op); }
+  void Visit_(const Max *op) final { Count(kSimpleOpCost, op); }
+  void Visit_(const Div *op) final { Count(kDivOpCost, op); }
+  void Visit_(const Mod *op) final { Count(kDivOpCost, op); }
+  void Visit_(const FloorDiv *op) final { Count(kDivOpCost, op); }
+  void Visit_(const FloorMod *op) final { Count(kDivOpCost, op); }
+  void Visit_(const Cast *op) final { Count(kSimpleOpCost, op); }
+
+  void Visit_(const Call *op) final {
+    if (op->call_type == Call::Halide) {
+      auto it = inlined_cost_.find(op->func.get());
+      if (it != inlined_cost_.end()) {
+        cost_ += it->second;
+      }
+    } else if (IsTranscendental(op)) {
+      cost_ += kTranscendentalOpCost;
+    } else {
+      cost_ += kSimpleOpCost;
+    }
+    IRVisitor::Visit_(op);
+  }
+
+  double cost_{0.0};
+
+ private:
+  static bool IsTranscendental(const Call *op) {
+    static const std::unordered_set<std::string> intrinsics = {"exp",  "log", "sqrt",   "rsqrt",
+                                                               "tanh", "pow", "sigmoid"};
+    return op->call_type == Call::PureIntrinsic && intrinsics.count(op->name) != 0;
+  }
+
+  template <typename T>
+  void Count(double cost, const T *op) {
+    cost_ += cost;
+    IRVisitor::Visit_(op);
+  }
+
+  const std::unordered_map<const Node *, double> &inlined_cost_;
+};
+
+// number of times a stage reads op
+class CallCounter : public IRVisitor {
+ public:
+  explicit CallCounter(const Operation &op) : op_(op) {}
+  ~CallCounter() override = default;
+
+  void Visit_(const Call *op) final {
+    if (op->call_type == Call::Halide && op->func.same_as(op_)) {
+      ++count_;
+    }
+    IRVisitor::Visit_(op);
+  }
+
+  int64_t count_{0};
+
+ private:
+  const Operation &op_;
+};
+
+// elements a compute stage evaluates its body for, including reduce axes; negative if not constant
+double IterationSize(const ComputeOpNode *compute) {
+  double size = 1.0;
+  for (const auto &iv : compute->axis) {
+    auto extent = iv->dom->extent.as<IntImm>();
+    if (extent == nullptr) return -1.0;
+    size *= static_cast<double>(extent->value);
+  }
+  for (const auto &iv : compute->reduce_axis) {
+    auto extent = iv->dom->extent.as<IntImm>();
+    if (extent == nullptr) return -1.0;
+    size *= static_cast<double>(extent->value);
+  }
+  return size;
+}
+
+/*
+ * Inlining a stage recomputes its body for every element its consumers read it with. That is free for a single
+ * consumer of the same shape, but multiplies the work of expensive bodies with fan-out, broadcast or reductions.
+ * Keep the stage in UB when the extra computation costs more than storing and loading it once.
+ */
+class InlineCostModel {
+ public:
+  explicit InlineCostModel(const Schedule &sch) : sch_(sch) {}
+  ~InlineCostModel() = default;
+
+  bool ShouldInline(const Operation &op) {
+    const auto compute = op.as<ComputeOpNode>();
+    if (compute == nullptr) return true;
+    InlineCost body_cost(inlined_cost_);
+    for (auto &e : compute->body) {
+      body_cost.Visit(e);
+    }
+    double size = IterationSize(compute);
+    double reads = 0.0;
+    for (const Stage &s : sch_->stages) {
+      if (s->op.same_as(op)) continue;
+      CallCounter counter(op);
+      if (const auto consumer = s->op.as<ComputeOpNode>()) {
+        for (auto &e : consumer->body) {
+          counter.Visit(e);
+        }
+        if (counter.count_ == 0) continue;
+        double consumer_size = IterationSize(consumer);
+        if (consumer_size < 0) {
+          size = -1.0;
+          break;
+        }
+        reads += static_cast<double>(counter.count_) * consumer_size;
+      }
+    }
+    // unknown shapes keep the old behaviour
+    if (size <= 0) {
+      inlined_cost_[op.get()] = body_cost.cost_;
+      return true;
+    }
+    double recompute = body_cost.cost_ * (reads - size);
+    double materialize = size * kUbStoreLoadCost;
+    if (recompute > materialize) {
+      DLOG(INFO) << "keep " << compute->name << " materialized, recompute cost " << recompute << " > store/load cost "
+                << materialize;
+      return false;
+    }
+    inlined_cost_[op.get()] = body_cost.cost_;
+    return true;
+  }
+
+ private:
+  const Schedule &sch_;
+  // cost per element of the stages inlined so far, they are recomputed inside their consumers
+  std::unordered_map<const Node *, double> inlined_cost_;
+};
+
+void AutoInline(Schedule sch, bool use_cost_model) {
   // Note: do not support inline of hybrid ops
   std::unordered_set<Operation, NodeHash, NodeEqual> uninlinable;
   for (const Stage &s : sch->stages) {
@@ -140,10 +290,11 @@ void AutoInline(Schedule sch) {
     }
   }
 
+  InlineCostModel cost_model(sch);
   for (Stage s : sch->stages) {
     if (!s.is_scheduled() && (IsInjective(s->op) || air::schedule::IsElemWise(s->op)) && !CantInline(s->op) &&
         !s->is_output && uninlinable.count(s->op) == 0 && !(has_conv && !IsConvInline(s->op, conv_inputs)) &&
-        (s->op->attrs.count("no_inline") == 0)) {
+        (s->op->attrs.count("no_inline") == 0) && (!use_cost_model || cost_model.ShouldInline(s->op))) {
       static_cast<void>(s.compute_inline());
     }
   }
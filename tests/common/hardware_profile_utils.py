@@ -0,0 +1,56 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""hardware profile of the cost models for the length of a with block"""
+import json
+import os
+import tempfile
+import akg.tvm
+
+
+def dump_profile():
+    ''' the current hardware profile as a dict '''
+    return json.loads(akg.tvm.get_global_func("cce.hardware_profile")())
+
+
+def load_profile(profile):
+    ''' loads a hardware profile dict, the values it does not set are kept '''
+    with tempfile.NamedTemporaryFile("w", suffix=".json", delete=False) as f:
+        json.dump(profile, f)
+    try:
+        assert akg.tvm.get_global_func("cce.load_hardware_profile")(f.name)
+    finally:
+        os.remove(f.name)
+
+
+class Profile(object):
+    ''' loads a partial hardware profile, or the one edit makes of a copy of the current profile,
+    the old profile is loaded back on exit '''
+
+    def __init__(self, profile=None, edit=None):
+        self.profile = profile or {}
+        self.edit = edit
+        self.saved = None
+
+    def __enter__(self):
+        self.saved = dump_profile()
+        if self.edit is not None:
+            profile = self.edit(json.loads(json.dumps(self.saved)))
+        else:
+            profile = dict(self.profile, version=1)
+        load_profile(profile)
+        return self
+
+    def __exit__(self, *args):
+        load_profile(self.saved)
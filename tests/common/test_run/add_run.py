@@ -63,6 +63,8 @@ def add_run(shape1, shape2, dtype, kernel_name="add", scale=1.0, attrs={}, polyh
         if attrs.get("dynamic"):
             for i in range(len(shape1)):
                 args.append(shape1[i])
+            if attrs.get("enable_host_tiling"):
+                args.extend(utils.get_host_tiling_args(kernel_name, shape1))
             block_dim = compute_blockdim(shape1)
             args.append(block_dim)
         output = utils.mod_launch(mod, args, outputs=(2,), expect=expect)
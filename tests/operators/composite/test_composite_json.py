@@ -17,6 +17,7 @@ import os
 import json
 import pytest
 import logging
+import akg
 from akg import composite
 from akg.utils import custom_tiling
 from akg.utils import kernel_exec as utils
@@ -29,6 +30,8 @@ def print_usage():
     logging.info("Usage: test_composite_json.py <JSON_FILE> to run single file.")
     logging.info("Usage: test_composite_json.py -d to run files in a directory, default to be ./json_dir.")
     logging.info("Usage: test_composite_json.py -ci to run ci files.")
+    logging.info("Usage: test_composite_json.py -cpu to run ci files with the cpu backend.")
+    logging.info("Usage: test_composite_json.py -trait to check the c++ trait against generate_trait.")
     logging.info("compile composite op")
 
 def get_result(desc, attrs=None):
@@ -148,6 +151,40 @@ def test_ci(profile=False):
         else:
             logging.info("No significant performance improvement. Do not need to update Baseline!")
 
+@pytest.mark.level1
+@pytest.mark.skipif(not akg.tvm.module.enabled("llvm"), reason="akg is built without llvm")
+def test_ci_cpu():
+    """run the ci json files with the llvm backend, as a reference for the device results"""
+    ci_path = "./need_adapt/"
+    for fi in os.listdir(ci_path):
+        if fi == "base.json":
+            continue
+        with open(ci_path + fi, 'r') as f:
+            desc = json.loads(f.read())
+        desc["process"] = "cpu"
+        if not get_result(json.dumps(desc)):
+            logging.info("----------Error Json name is----------")
+            logging.info(fi)
+            raise ValueError("Precision Error")
+    logging.info("All ops are ok on cpu!")
+
+@pytest.mark.level0
+def test_trait():
+    """the trait computed by the c++ parser is the repository key computed by generate_trait"""
+    ci_path = "./need_adapt/"
+    for fi in os.listdir(ci_path):
+        if fi == "base.json":
+            continue
+        with open(ci_path + fi, 'r') as f:
+            desc = f.read()
+        desc_d = json.loads(desc)
+        assert composite.get_trait(desc) == composite.generate_trait(desc_d), fi
+        # the single parse used by build carries the same trait and the process
+        parsed = composite.parse(desc)
+        assert tuple(t.value for t in parsed.trait) == composite.generate_trait(desc_d), fi
+        process = desc_d.get("process")
+        assert parsed.process == (process if process in ("gpu", "cpu") else "aicore"), fi
+
 def main(argv):
     if len(argv) in [1, 2] and (argv[0].endswith(".info") or argv[0].endswith(".json")):
         use_custom = len(argv) == 2 and argv[1] == 'c'
@@ -158,6 +195,10 @@ def main(argv):
         test_ci(profile=False)
     elif len(argv) == 1 and argv[0] == "-cip":
         test_ci(profile=True)
+    elif len(argv) == 1 and argv[0] == "-cpu":
+        test_ci_cpu()
+    elif len(argv) == 1 and argv[0] == "-trait":
+        test_trait()
     else:
         print_usage()
 
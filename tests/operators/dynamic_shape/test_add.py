@@ -15,3 +15,34 @@ def test_add():
     boot.run("test_resnet50_add_006", "add_run", ([32, 32, 28, 28, 16], [32, 32, 28, 28, 16], "float16", "cce_add_fp16"), "dynamic")
     boot.run("test_resnet50_add_007", "add_run", ([32, 64, 14, 14, 16], [32, 64, 14, 14, 16], "float16", "cce_add_fp16"), "dynamic")
 
+
+
+@pytest.mark.add
+@pytest.mark.level1
+@pytest.mark.env_oncard
+@pytest.mark.platform_x86_ascend_training
+def test_add_shape_specialization():
+    from test_run.add_run import add_run
+    shape = [32, 16, 56, 56, 16]
+    attrs = {
+        "dynamic": True,
+        "enable_shape_specialization": True,
+        # 56 is in no bucket, the launch runs the smallest bucket above it, the last bucket is too small for it
+        "shape_buckets": [dict(("I%d" % i, s) for i, s in enumerate([32, 16, 64, 64, 16])),
+                          dict(("I%d" % i, s) for i, s in enumerate([32, 16, 128, 128, 16])),
+                          dict(("I%d" % i, s) for i, s in enumerate([16, 16, 32, 32, 16]))],
+    }
+    _, _, _, res = add_run(shape, shape, "float16", "cce_add_fp16_bucket", attrs=attrs)
+    assert res
+
+
+@pytest.mark.add
+@pytest.mark.level1
+@pytest.mark.env_oncard
+@pytest.mark.platform_x86_ascend_training
+def test_add_host_tiling():
+    from test_run.add_run import add_run
+    shape = [32, 16, 56, 56, 16]
+    attrs = {"dynamic": True, "enable_host_tiling": True}
+    _, _, _, res = add_run(shape, shape, "float16", "cce_add_fp16_host_tiling", attrs=attrs)
+    assert res
@@ -0,0 +1,97 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Host-device copy throughput benchmark for the cce device api.
+
+Works against the real runtime and against the runtime stub (default build
+without runtime support), where device memory lives on the host.
+
+usage:
+    python cce_copy_benchmark.py [--sizes 1M,16M,256M] [--repeat 5]
+    python cce_copy_benchmark.py --pinned                # host arrays in page-locked memory
+    AKG_CCE_COPY_ENGINE=0 python cce_copy_benchmark.py   # synchronous baseline
+"""
+import argparse
+import json
+import time
+
+import numpy as np
+import akg.tvm
+
+
+def parse_size(size):
+    units = {"K": 1 << 10, "M": 1 << 20, "G": 1 << 30}
+    size = size.strip().upper()
+    if size[-1] in units:
+        return int(size[:-1]) * units[size[-1]]
+    return int(size)
+
+
+def copy_stats(reset=False):
+    func = akg.tvm.get_global_func("device_api.cce.copy_stats", allow_missing=True)
+    if func is None:
+        return {}
+    return json.loads(func(reset))
+
+
+def bench_one(num_bytes, repeat, ctx, host_ctx):
+    host = akg.tvm.nd.array(np.random.randint(0, 255, size=num_bytes, dtype=np.uint8), host_ctx)
+    dev = akg.tvm.nd.empty((num_bytes,), "uint8", ctx)
+    back = np.empty((num_bytes,), dtype=np.uint8)
+
+    # warm up: creates the copy stream and the pinned staging buffers
+    dev.copyfrom(host)
+    dev.copyto(akg.tvm.nd.array(back))
+
+    start = time.time()
+    for _ in range(repeat):
+        dev.copyfrom(host)
+    ctx.sync()
+    h2d = time.time() - start
+
+    out = akg.tvm.nd.empty((num_bytes,), "uint8", host_ctx)
+    start = time.time()
+    for _ in range(repeat):
+        dev.copyto(out)
+    ctx.sync()
+    d2h = time.time() - start
+
+    if not np.array_equal(out.asnumpy(), host.asnumpy()):
+        raise RuntimeError("copy mismatch for %d bytes" % num_bytes)
+    gbytes = float(num_bytes) * repeat / (1 << 30)
+    return gbytes / h2d, gbytes / d2h
+
+
+def main():
+    parser = argparse.ArgumentParser(description="cce host-device copy throughput")
+    parser.add_argument("--sizes", default="64K,1M,16M,128M,512M", help="comma separated sizes, K/M/G suffix allowed")
+    parser.add_argument("--repeat", type=int, default=5)
+    parser.add_argument("--device", type=int, default=0)
+    parser.add_argument("--pinned", action="store_true", help="allocate the host arrays in page-locked memory")
+    args = parser.parse_args()
+
+    ctx = akg.tvm.cce(args.device)
+    host_ctx = akg.tvm.context("cpu_pinned", 0) if args.pinned else akg.tvm.cpu(0)
+    copy_stats(reset=True)
+    print("%12s %12s %12s" % ("bytes", "H2D GiB/s", "D2H GiB/s"))
+    for size in args.sizes.split(","):
+        num_bytes = parse_size(size)
+        h2d, d2h = bench_one(num_bytes, args.repeat, ctx, host_ctx)
+        print("%12d %12.2f %12.2f" % (num_bytes, h2d, d2h))
+    print("copy engine stats: %s" % copy_stats())
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,61 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""access summaries only skip alias checks that fail: syncs and schedules match the check of every pair"""
+import akg
+import akg.tvm
+import akg.topi
+
+
+def chain(shape, dtype):
+    ''' several intermediates live in the unified buffer at once '''
+    a = akg.tvm.placeholder(shape, name="a", dtype=dtype)
+    b = akg.tvm.placeholder(shape, name="b", dtype=dtype)
+    c = akg.topi.add(a, b)
+    d = akg.topi.multiply(c, a)
+    e = akg.topi.subtract(d, b)
+    f = akg.topi.abs(e)
+    return [a, b], f
+
+
+def row_sum(shape, dtype):
+    a = akg.tvm.placeholder(shape, name="a", dtype=dtype)
+    k = akg.tvm.reduce_axis((0, shape[1]), name="k")
+    out = akg.tvm.compute((shape[0],), lambda i: akg.tvm.sum(a[i, k], axis=k), name="out")
+    return [a], out
+
+
+def broadcast_add(shape, dtype):
+    a = akg.tvm.placeholder(shape, name="a", dtype=dtype)
+    b = akg.tvm.placeholder((shape[0], 1), name="b", dtype=dtype)
+    return [a, b], akg.topi.add(a, b)
+
+
+def lower(build, shape, dtype, summary):
+    inputs, out = build(shape, dtype)
+    s = akg.tvm.create_schedule(out.op)
+    attrs = {"enable_access_summary": summary}
+    stmt = akg.lower(s, inputs + [out], [], build.__name__, None, attrs, True, True)
+    return str(stmt)
+
+
+def test_same_dependences():
+    cases = [(chain, (16, 256), "float16"), (chain, (8, 4000), "float32"), (row_sum, (64, 512), "float16"),
+             (broadcast_add, (32, 128), "float16")]
+    for build, shape, dtype in cases:
+        assert lower(build, shape, dtype, True) == lower(build, shape, dtype, False)
+
+
+if __name__ == '__main__':
+    test_same_dependences()
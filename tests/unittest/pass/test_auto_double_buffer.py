@@ -0,0 +1,137 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""software pipeline of the double buffer: the next lane's load runs before the compute of the current one"""
+import akg.tvm
+
+TILE = 128
+
+
+def load_compute_store(extent, in_place=False):
+    ''' for each tile: load it to UB, exp it there, store it back; in place stores to the gm the loads read '''
+    ib = akg.tvm.ir_builder.create()
+    inp = ib.pointer("float16", name="input")
+    out = inp if in_place else ib.pointer("float16", name="output")
+    with ib.for_range(0, extent, "i") as i:
+        buf = ib.allocate("float16", (TILE,), name="buf", scope="local.UB")
+        ib.emit(akg.tvm.call_extern("float16", "copy_gm_to_ubuf", buf.asnode(), inp.asnode(), i * TILE))
+        ib.emit(akg.tvm.call_extern("float16", "vexp", buf.asnode(), buf.asnode()))
+        ib.emit(akg.tvm.call_extern("float16", "copy_ubuf_to_gm", out.asnode(), buf.asnode(), i * TILE))
+    return ib.get()
+
+
+def trace(stmt, events, env=None):
+    ''' the instructions in execution order as (name, UB buffer, tile), loops are run with their bounds '''
+    env = env or {}
+    if isinstance(stmt, akg.tvm.stmt.AttrStmt):
+        trace(stmt.body, events, env)
+    elif isinstance(stmt, akg.tvm.stmt.Allocate):
+        trace(stmt.body, events, env)
+    elif isinstance(stmt, akg.tvm.stmt.Block):
+        trace(stmt.first, events, env)
+        trace(stmt.rest, events, env)
+    elif isinstance(stmt, akg.tvm.stmt.For):
+        for value in range(stmt.min.value, stmt.min.value + stmt.extent.value):
+            trace(stmt.body, events, dict(env, **{stmt.loop_var.name: (stmt.loop_var, value)}))
+    else:
+        assert isinstance(stmt, akg.tvm.stmt.Evaluate)
+        call = stmt.value
+        ub = [a.name for a in call.args if isinstance(a, akg.tvm.expr.Var) and a.name.startswith("buf")]
+        tile = None
+        if call.name != "vexp":
+            vmap = dict((var, akg.tvm.const(value, var.dtype)) for var, value in env.values())
+            tile = akg.tvm.ir_pass.Simplify(akg.tvm.ir_pass.Substitute(call.args[2], vmap)).value // TILE
+        events.append((call.name, ub[0], tile))
+    return events
+
+
+def hoisted(stmt):
+    ''' names of the buffers allocated before the first instruction, outside any loop '''
+    names = []
+    while isinstance(stmt, (akg.tvm.stmt.AttrStmt, akg.tvm.stmt.Allocate)):
+        if isinstance(stmt, akg.tvm.stmt.Allocate):
+            names.append(stmt.buffer_var.name)
+        stmt = stmt.body
+    return names
+
+
+def steady_loop(stmt):
+    loops = []
+    akg.tvm.ir_pass.PostOrderVisit(stmt, lambda op: loops.append(op) if isinstance(op, akg.tvm.stmt.For) else None)
+    return loops
+
+
+def load(buf, tile):
+    return ("copy_gm_to_ubuf", buf, tile)
+
+
+def compute(buf):
+    return ("vexp", buf, None)
+
+
+def store(buf, tile):
+    return ("copy_ubuf_to_gm", buf, tile)
+
+
+def test_even_extent():
+    stmt = akg.tvm.ir_pass.AutoDoubleBuffer(load_compute_store(6), True)
+    # both lanes are allocated once, outside the steady loop
+    assert hoisted(stmt) == ["buf", "buf_db"]
+    loops = steady_loop(stmt)
+    assert len(loops) == 1 and loops[0].loop_var.name == "i.db" and loops[0].extent.value == 2
+    expect = [load("buf", 0)]
+    for pair in range(2):
+        # steady state: the next lane's load is issued before the compute of the current lane
+        i = 2 * pair
+        expect += [load("buf_db", i + 1), compute("buf"), store("buf", i),
+                   load("buf", i + 2), compute("buf_db"), store("buf_db", i + 1)]
+    # epilogue of the last pair, without a load past the end
+    expect += [load("buf_db", 5), compute("buf"), store("buf", 4), compute("buf_db"), store("buf_db", 5)]
+    assert trace(stmt, []) == expect
+
+
+def test_odd_extent():
+    stmt = akg.tvm.ir_pass.AutoDoubleBuffer(load_compute_store(5), True)
+    assert hoisted(stmt) == ["buf", "buf_db"]
+    expect = [load("buf", 0),
+              load("buf_db", 1), compute("buf"), store("buf", 0),
+              load("buf", 2), compute("buf_db"), store("buf_db", 1),
+              load("buf_db", 3), compute("buf"), store("buf", 2), compute("buf_db"), store("buf_db", 3),
+              # the odd remainder runs the original body after the pipeline
+              load("buf", 4), compute("buf"), store("buf", 4)]
+    assert trace(stmt, []) == expect
+
+
+def test_store_read_by_load_keeps_double_buffer():
+    ''' the next load would read gm before the store of the current tile wrote it, the plain double buffer stays '''
+    stmt = akg.tvm.ir_pass.AutoDoubleBuffer(load_compute_store(4, in_place=True), True)
+    assert not hoisted(stmt)
+    expect = []
+    for i in range(4):
+        expect += [load("buf", i), compute("buf"), store("buf", i)]
+    assert trace(stmt, []) == expect
+    assert str(stmt) == str(akg.tvm.ir_pass.AutoDoubleBuffer(load_compute_store(4, in_place=True), False))
+
+
+def test_disabled():
+    stmt = akg.tvm.ir_pass.AutoDoubleBuffer(load_compute_store(6), False)
+    assert "buf_db" not in str(stmt)
+    assert [e[2] for e in trace(stmt, []) if e[0] == "copy_gm_to_ubuf"] == list(range(6))
+
+
+if __name__ == "__main__":
+    test_even_extent()
+    test_odd_extent()
+    test_store_read_by_load_keeps_double_buffer()
+    test_disabled()
@@ -0,0 +1,57 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""the inline cost model keeps an expensive stage read by several consumers materialized"""
+import akg.tvm
+
+# AttachType::kInline of the schedule
+INLINE = 2
+
+
+def fan_out(body):
+    ''' e = body(x) is read by two consumers, which only feed the output '''
+    shape = (16, 256)
+    x = akg.tvm.placeholder(shape, name="x", dtype="float16")
+    e = akg.tvm.compute(shape, lambda i, j: body(x[i, j]), name="e")
+    a = akg.tvm.compute(shape, lambda i, j: e[i, j] * akg.tvm.const(2, "float16"), name="a")
+    b = akg.tvm.compute(shape, lambda i, j: e[i, j] + akg.tvm.const(1, "float16"), name="b")
+    out = akg.tvm.compute(shape, lambda i, j: a[i, j] + b[i, j], name="out")
+    return akg.tvm.create_schedule(out.op), e, a, b
+
+
+def auto_inline(body, use_cost_model):
+    s, e, a, b = fan_out(body)
+    akg.tvm.get_global_func("schedule.AutoInline")(s, use_cost_model)
+    return [s[t].attach_type == INLINE for t in (e, a, b)]
+
+
+def test_exp_fan_out_stays():
+    ''' exp recomputed for both consumers costs more than storing it once in UB '''
+    assert auto_inline(akg.tvm.exp, True) == [False, True, True]
+
+
+def test_exp_fan_out_inlined_without_cost_model():
+    ''' without the cost model every legal stage is inlined, as before '''
+    assert auto_inline(akg.tvm.exp, False) == [True, True, True]
+
+
+def test_cheap_fan_out_inlined():
+    ''' a single add recomputed for the second consumer is cheaper than the UB store and load '''
+    assert auto_inline(lambda v: v + akg.tvm.const(1, "float16"), True) == [True, True, True]
+
+
+if __name__ == "__main__":
+    test_exp_fan_out_stays()
+    test_exp_fan_out_inlined_without_cost_model()
+    test_cheap_fan_out_inlined()
@@ -0,0 +1,76 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import akg
+import akg.tvm
+import akg.topi
+from akg.autodiff import DiffBuildingBlock
+
+
+def fan_out(dtype):
+    ''' out = x * 2 + x * 3, the adjoint of x has two parts '''
+    x = akg.tvm.placeholder((16, 16), name="x", dtype=dtype)
+    a = akg.tvm.compute(x.shape, lambda i, j: x[i, j] * akg.tvm.const(2, dtype), name="a")
+    b = akg.tvm.compute(x.shape, lambda i, j: x[i, j] * akg.tvm.const(3, dtype), name="b")
+    out = akg.tvm.compute(x.shape, lambda i, j: a[i, j] + b[i, j], name="out")
+    head = akg.tvm.placeholder(out.shape, name="head", dtype=dtype)
+    return x, out, head
+
+
+def test_single_compute():
+    ''' the parts are summed by one compute with the tag of the topi.add chain '''
+    x, out, head = fan_out("float16")
+    dx = akg.differentiate(out, [x], head).result[0]
+    assert dx.op.name == "x_adjoint_sum"
+    assert dx.op.tag == "broadcast"
+    assert dx.dtype == "float16"
+    # one read per part, no intermediate sums
+    assert len(dx.op.input_tensors) == 2
+
+
+def test_widest_dtype():
+    ''' the accumulation dtype is the widest dtype of the parts, whatever the order of the dependencies '''
+    x, out, head = fan_out("float16")
+
+    def fdiff(output, inp, head, ad_attrs, new_pld_array):
+        part = DiffBuildingBlock(output, inp, head, ad_attrs, new_pld_array)
+        if output.op.name == "b":
+            return akg.topi.cast(part, "float32")
+        return part
+
+    dx = akg.differentiate(out, [x], head, fdiff=fdiff).result[0]
+    assert dx.op.name == "x_adjoint_sum"
+    assert dx.dtype == "float32"
+
+
+def test_broadcast_widest_dtype():
+    ''' parts of other shapes keep the add chain, which accumulates in the widest dtype as well '''
+    x, out, head = fan_out("float16")
+
+    def fdiff(output, inp, head, ad_attrs, new_pld_array):
+        part = DiffBuildingBlock(output, inp, head, ad_attrs, new_pld_array)
+        if output.op.name == "a":
+            # a float32 row, broadcast over the rows of the other part
+            return akg.tvm.compute((1, 16), lambda i, j: part[i, j].astype("float32"), name="a_row")
+        return part
+
+    dx = akg.differentiate(out, [x], head, fdiff=fdiff).result[0]
+    assert dx.dtype == "float32"
+    assert [int(d) for d in dx.shape] == [16, 16]
+
+
+if __name__ == '__main__':
+    test_single_compute()
+    test_widest_dtype()
+    test_broadcast_widest_dtype()
@@ -0,0 +1,57 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""the autodiff merge groups subtensors by their canonical form, equal structure up to names and operand order"""
+import akg.tvm
+
+SHAPE = (16, 32)
+
+
+def scaled_exp(x, name, swap=False):
+    ''' exp(x) * 2, with its own axis names and the operands of the product in either order '''
+    two = akg.tvm.const(2, x.dtype)
+    e = akg.tvm.compute(SHAPE, lambda i, j: akg.tvm.exp(x[i, j]), name=name + "_exp")
+    if swap:
+        return e, akg.tvm.compute(SHAPE, lambda p, q: two * e[p, q], name=name)
+    return e, akg.tvm.compute(SHAPE, lambda i, j: e[i, j] * two, name=name)
+
+
+def equal_groups(roots):
+    ''' the groups of equal subtensors, as sets of tensor names '''
+    groups = akg.tvm.get_global_func("akg.autodiff.EqualSubtensors")(roots)
+    return sorted(sorted(t.op.name for t in group) for group in groups)
+
+
+def test_equal_dags():
+    ''' two DAGs built apart with other axis names and swapped commutative operands are one class '''
+    x = akg.tvm.placeholder(SHAPE, name="x", dtype="float16")
+    _, left = scaled_exp(x, "left")
+    _, right = scaled_exp(x, "right", swap=True)
+    assert equal_groups([left, right]) == [["left", "right"], ["left_exp", "right_exp"]]
+
+
+def test_different_dag():
+    ''' a DAG that differs in its body, or reads another input, is in no group '''
+    x = akg.tvm.placeholder(SHAPE, name="x", dtype="float16")
+    y = akg.tvm.placeholder(SHAPE, name="y", dtype="float16")
+    _, left = scaled_exp(x, "left")
+    e = akg.tvm.compute(SHAPE, lambda i, j: akg.tvm.exp(x[i, j]), name="other_exp")
+    other = akg.tvm.compute(SHAPE, lambda i, j: e[i, j] + akg.tvm.const(2, "float16"), name="other")
+    _, moved = scaled_exp(y, "moved")
+    assert equal_groups([left, other, moved]) == [["left_exp", "other_exp"]]
+
+
+if __name__ == "__main__":
+    test_equal_dags()
+    test_different_dag()
@@ -0,0 +1,111 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import akg.tvm
+
+# float16 elements of one 32 byte burst
+BURST = 16
+
+
+def ptr(buf, offset, extent, rw):
+    return akg.tvm.call_pure_intrin("handle", "tvm_access_ptr", akg.tvm.const(0, "float16"), buf, offset, extent, rw)
+
+
+def dma(ib, name, dst, dst_offset, src, src_offset, len_burst):
+    extent = len_burst * BURST
+    ib.emit(akg.tvm.call_extern("float16", name, ptr(dst, dst_offset, extent, 2), ptr(src, src_offset, extent, 1),
+                                0, 1, len_burst, 0, 0))
+
+
+def dma_calls(stmt):
+    calls = []
+
+    def visit(op):
+        if isinstance(op, akg.tvm.expr.Call) and op.name.startswith("copy_"):
+            calls.append(op)
+    akg.tvm.ir_pass.PostOrderVisit(stmt, visit)
+    return calls
+
+
+def has_loop(stmt):
+    loops = []
+    akg.tvm.ir_pass.PostOrderVisit(stmt, lambda op: loops.append(op) if isinstance(op, akg.tvm.stmt.For) else None)
+    return len(loops) > 0
+
+
+def test_merge_adjacent():
+    ''' two copies that continue each other on both sides become one burst '''
+    ib = akg.tvm.ir_builder.create()
+    gm = ib.allocate("float16", 1024, name="gm")
+    ub = ib.allocate("float16", 1024, name="ub", scope="local.UB")
+    dma(ib, "copy_ubuf_to_gm", gm, 0, ub, 0, 4)
+    dma(ib, "copy_ubuf_to_gm", gm, 4 * BURST, ub, 4 * BURST, 1)
+    calls = dma_calls(akg.tvm.ir_pass.CoalesceDma(ib.get()))
+    assert len(calls) == 1
+    assert calls[0].args[4].value == 5
+
+
+def test_merge_within_buffer():
+    ''' a copy within one buffer is merged when it writes apart from what it reads '''
+    ib = akg.tvm.ir_builder.create()
+    ub = ib.allocate("float16", 1024, name="ub", scope="local.UB")
+    dma(ib, "copy_ubuf_to_ubuf", ub, 512, ub, 0, 4)
+    dma(ib, "copy_ubuf_to_ubuf", ub, 512 + 4 * BURST, ub, 4 * BURST, 1)
+    calls = dma_calls(akg.tvm.ir_pass.CoalesceDma(ib.get()))
+    assert len(calls) == 1
+    assert calls[0].args[4].value == 5
+
+
+def test_keep_overlapping_copies():
+    ''' the second copy reads what the first one writes, they stay apart '''
+    ib = akg.tvm.ir_builder.create()
+    ub = ib.allocate("float16", 1024, name="ub", scope="local.UB")
+    dma(ib, "copy_ubuf_to_ubuf", ub, 4 * BURST, ub, 0, 4)
+    dma(ib, "copy_ubuf_to_ubuf", ub, 8 * BURST, ub, 4 * BURST, 1)
+    calls = dma_calls(akg.tvm.ir_pass.CoalesceDma(ib.get()))
+    assert len(calls) == 2
+
+
+def test_fold_loop():
+    ''' a loop of single bursts becomes one multi-burst copy '''
+    ib = akg.tvm.ir_builder.create()
+    gm = ib.allocate("float16", 2048, name="gm")
+    ub = ib.allocate("float16", 1024, name="ub", scope="local.UB")
+    with ib.for_range(0, 16, name="i") as i:
+        dma(ib, "copy_gm_to_ubuf", ub, i * 2 * BURST, gm, i * 4 * BURST, 2)
+    stmt = akg.tvm.ir_pass.CoalesceDma(ib.get())
+    calls = dma_calls(stmt)
+    assert not has_loop(stmt)
+    assert len(calls) == 1
+    # nBurst, lenBurst, srcStride, dstStride
+    assert [arg.value for arg in calls[0].args[3:7]] == [16, 2, 2, 0]
+
+
+def test_keep_overlapping_loop():
+    ''' each iteration shifts the burst the previous one wrote, the loop stays '''
+    ib = akg.tvm.ir_builder.create()
+    ub = ib.allocate("float16", 1024, name="ub", scope="local.UB")
+    with ib.for_range(0, 16, name="i") as i:
+        dma(ib, "copy_ubuf_to_ubuf", ub, (i + 1) * BURST, ub, i * BURST, 1)
+    stmt = akg.tvm.ir_pass.CoalesceDma(ib.get())
+    assert has_loop(stmt)
+    assert len(dma_calls(stmt)) == 1
+
+
+if __name__ == "__main__":
+    test_merge_adjacent()
+    test_merge_within_buffer()
+    test_keep_overlapping_copies()
+    test_fold_loop()
+    test_keep_overlapping_loop()
@@ -0,0 +1,71 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""ElimDMA keeps the first of repeated loads into a UB buffer and drops the copies that load it again"""
+import akg.tvm
+
+TILE = 128
+
+
+def unrolled_loads(offsets):
+    ''' one load of a tile into a_ub per offset, each followed by an add reading it into c_ub '''
+    ib = akg.tvm.ir_builder.create()
+    gm = akg.tvm.decl_buffer((TILE * 4,), "float16", name="a")
+    a_ub = ib.allocate("float16", (TILE,), name="a_ub", scope="local.UB")
+    c_ub = ib.allocate("float16", (TILE,), name="c_ub", scope="local.UB")
+    a_ub = akg.tvm.decl_buffer((TILE,), "float16", name="a_ub", data=a_ub.asnode(), scope="local.UB")
+    c_ub = akg.tvm.decl_buffer((TILE,), "float16", name="c_ub", data=c_ub.asnode(), scope="local.UB")
+    for offset in offsets:
+        ib.emit(akg.tvm.call_extern("float16", "copy_gm_to_ubuf", a_ub.access_ptr("w"),
+                                    gm.access_ptr("r", offset=offset), 0, 1, TILE // 16, 0, 0))
+        ib.emit(akg.tvm.call_extern("float16", "vadd", c_ub.access_ptr("w"), a_ub.access_ptr("r"),
+                                    c_ub.access_ptr("r"), 1, 1, 1, 1, 8, 8, 8))
+    return ib.get()
+
+
+def insns(stmt):
+    ''' names of the instructions in program order '''
+    names = []
+
+    def visit(op):
+        if isinstance(op, akg.tvm.stmt.Evaluate) and isinstance(op.value, akg.tvm.expr.Call):
+            names.append(op.value.name)
+
+    akg.tvm.ir_pass.PostOrderVisit(stmt, visit)
+    return names
+
+
+def test_repeated_load_removed():
+    ''' the second load of the same tile is dropped, both adds stay '''
+    stmt = akg.tvm.ir_pass.ElimDMA(unrolled_loads([0, 0]))
+    assert insns(stmt) == ["copy_gm_to_ubuf", "vadd", "vadd"]
+
+
+def test_other_load_between_kept():
+    ''' a load of another tile in between is a new def, the third load reads the first tile again '''
+    stmt = akg.tvm.ir_pass.ElimDMA(unrolled_loads([0, TILE, 0]))
+    assert insns(stmt) == ["copy_gm_to_ubuf", "vadd"] * 3
+
+
+def test_unrolled_kernel():
+    ''' a long unrolled run of the same load keeps only the first, the adds are untouched '''
+    n = 64
+    stmt = akg.tvm.ir_pass.ElimDMA(unrolled_loads([TILE] * n))
+    assert insns(stmt) == ["copy_gm_to_ubuf"] + ["vadd"] * n
+
+
+if __name__ == "__main__":
+    test_repeated_load_removed()
+    test_other_load_between_kept()
+    test_unrolled_kernel()
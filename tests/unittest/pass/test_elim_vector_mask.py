@@ -423,7 +423,159 @@ def test_hoist_18():
     #print(stmt)
     stmt = akg.tvm.ir_pass.ElimVectorMask(stmt)
     #print(stmt)
-    check_result(stmt, [1, 's', 's', 1, 'e', 2, 'e'])
+    # the set at the head of the inner loop is hoisted out of it
+    check_result(stmt, [1, 's', 1, 's', 'e', 2, 'e'])
+
+
+
+def access(buf, rw):
+    return akg.tvm.call_pure_intrin("handle", "tvm_access_ptr", akg.tvm.const(0, buf.dtype), buf, 0, 128, rw)
+
+
+def set_deqscale(ib, value):
+    ib.emit(akg.tvm.call_extern("float16", "set_deqscale", akg.tvm.const(value, "float16")))
+
+
+def vconv_deq(ib, dst, src):
+    ib.emit(akg.tvm.call_extern("float16", "vconv_deq", access(dst, 2), access(src, 1)))
+
+
+def state_sets(stmt, name):
+    ''' the values of the sets of a register, in program order '''
+    sets = []
+
+    def visit(op):
+        if isinstance(op, akg.tvm.expr.Call) and op.name == name:
+            sets.append(op.args[-1])
+    akg.tvm.ir_pass.PostOrderVisit(stmt, visit)
+    return sets
+
+
+def deq_buffers(ib):
+    src = ib.allocate("int32", 128, name="src", scope="local.UB")
+    dst = ib.allocate("float16", 128, name="dst", scope="local.UB")
+    return src, dst
+
+
+def test_state_join_if_else():
+    ''' both branches set the same deqscale, the set after the if is redundant '''
+    n = akg.tvm.var("n")
+    ib = akg.tvm.ir_builder.create()
+    src, dst = deq_buffers(ib)
+    set_deqscale(ib, 1.0)
+    vconv_deq(ib, dst, src)
+    with ib.if_scope(n > 0):
+        set_deqscale(ib, 2.0)
+        vconv_deq(ib, dst, src)
+    with ib.else_scope():
+        set_deqscale(ib, 2.0)
+        vconv_deq(ib, dst, src)
+    set_deqscale(ib, 2.0)
+    vconv_deq(ib, dst, src)
+    stmt = akg.tvm.ir_pass.ElimVectorMask(ib.get())
+    assert [v.value for v in state_sets(stmt, "set_deqscale")] == [1.0, 2.0, 2.0]
+
+
+def test_state_join_if_else_differ():
+    ''' the branches set different deqscales, the set after the if stays '''
+    n = akg.tvm.var("n")
+    ib = akg.tvm.ir_builder.create()
+    src, dst = deq_buffers(ib)
+    with ib.if_scope(n > 0):
+        set_deqscale(ib, 2.0)
+        vconv_deq(ib, dst, src)
+    with ib.else_scope():
+        set_deqscale(ib, 3.0)
+        vconv_deq(ib, dst, src)
+    set_deqscale(ib, 2.0)
+    vconv_deq(ib, dst, src)
+    stmt = akg.tvm.ir_pass.ElimVectorMask(ib.get())
+    assert [v.value for v in state_sets(stmt, "set_deqscale")] == [2.0, 3.0, 2.0]
+
+
+def test_state_loop_back_edge():
+    ''' the value at the loop head joins the entry and the back edge '''
+    for body_value, expect in ((1.0, [1.0]), (2.0, [1.0, 2.0])):
+        ib = akg.tvm.ir_builder.create()
+        src, dst = deq_buffers(ib)
+        set_deqscale(ib, 1.0)
+        with ib.for_range(0, 4, "i"):
+            vconv_deq(ib, dst, src)
+            set_deqscale(ib, body_value)
+            vconv_deq(ib, dst, src)
+        stmt = akg.tvm.ir_pass.ElimVectorMask(ib.get())
+        assert [v.value for v in state_sets(stmt, "set_deqscale")] == expect
+
+
+def loop_of(stmt):
+    loops = []
+
+    def visit(op):
+        if isinstance(op, akg.tvm.stmt.For):
+            loops.append(op)
+    akg.tvm.ir_pass.PostOrderVisit(stmt, visit)
+    assert len(loops) == 1
+    return loops[0]
+
+
+def test_state_hoist():
+    ''' a set at the head of the body is hoisted out of the loop, unless its value changes in the loop '''
+    ib = akg.tvm.ir_builder.create()
+    src, dst = deq_buffers(ib)
+    with ib.for_range(0, 4, "i"):
+        set_deqscale(ib, 2.0)
+        vconv_deq(ib, dst, src)
+    stmt = akg.tvm.ir_pass.ElimVectorMask(ib.get())
+    assert len(state_sets(stmt, "set_deqscale")) == 1
+    assert not state_sets(loop_of(stmt), "set_deqscale")
+
+    ib = akg.tvm.ir_builder.create()
+    src, dst = deq_buffers(ib)
+    with ib.for_range(0, 4, "i") as i:
+        ib.emit(akg.tvm.call_extern("float16", "set_deqscale", i.astype("float16")))
+        vconv_deq(ib, dst, src)
+    stmt = akg.tvm.ir_pass.ElimVectorMask(ib.get())
+    assert len(state_sets(loop_of(stmt), "set_deqscale")) == 1
+
+
+def mask_from_memory(write):
+    ''' set_vector_mask(n[0]); vadd; write; set_vector_mask(n[0]); vadd, the number of sets left '''
+    ib = akg.tvm.ir_builder.create()
+    n = ib.allocate("int32", 8, name="n", scope="local.UB")
+    y = ib.allocate("int32", 8, name="y", scope="local.UB")
+    a = ib.allocate("float16", 128, name="a", scope="local.UB")
+
+    def masked_vadd():
+        ib.emit(akg.tvm.call_extern("uint64", "set_vector_mask", akg.tvm.const(0, "uint64"), n[0].astype("uint64")))
+        ib.emit(akg.tvm.call_extern("float16", "vadd", access(a, 2), access(a, 1), access(a, 1)))
+
+    masked_vadd()
+    write(ib, n, y)
+    masked_vadd()
+    stmt = akg.tvm.ir_pass.ElimVectorMask(ib.get())
+    return len(state_sets(stmt, "set_vector_mask"))
+
+
+def test_state_invalidate_memory():
+    ''' a mask read from memory is set again after the memory is written '''
+    def store_n(ib, n, y):
+        n[0] = 5
+
+    def store_y(ib, n, y):
+        y[0] = 5
+
+    def intrin_n(ib, n, y):
+        ib.emit(akg.tvm.call_extern("int32", "vadds", access(n, 2), access(y, 1), akg.tvm.const(1, "int32")))
+
+    def intrin_y(ib, n, y):
+        ib.emit(akg.tvm.call_extern("int32", "vadds", access(y, 2), access(n, 1), akg.tvm.const(1, "int32")))
+
+    assert mask_from_memory(store_n) == 2
+    assert mask_from_memory(intrin_n) == 2
+    # n is only read, the second set is redundant
+    assert mask_from_memory(store_y) == 1
+    assert mask_from_memory(intrin_y) == 1
+
 
 if __name__ == '__main__':
     test_elim_1()
@@ -446,3 +598,8 @@ if __name__ == '__main__':
     test_hoist_16()
     test_hoist_17()
     test_hoist_18()
+    test_state_join_if_else()
+    test_state_join_if_else_differ()
+    test_state_loop_back_edge()
+    test_state_hoist()
+    test_state_invalidate_memory()
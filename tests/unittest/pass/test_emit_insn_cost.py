@@ -0,0 +1,169 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""emit_insn keeps the cheapest pattern under the instruction cost table, ties keep the mask rate choice"""
+import os
+import akg.tvm
+from hardware_profile_utils import Profile
+
+ROWS = 9
+COLS = 10
+ROW_STRIDE = 32
+# fp16 elements reduced into each output, 64 repeats of a vector instruction
+REDUCE_LEN = 8192
+
+
+def strided_abs():
+    ''' y[i, j] = |x[i, j]| on rows of 10 fp16 elements, 32 apart: 2d_pattern by mask rate, partial_3d_pattern
+    needs fewer repeats over strided blocks but one more instruction for the tail of the rows '''
+    ib = akg.tvm.ir_builder.create()
+    zero = akg.tvm.const(0, "int32")
+    x = ib.pointer("float16", name="x_local_UB")
+    y = ib.pointer("float16", name="y_local_UB")
+    with ib.new_scope():
+        ib.scope_attr(zero, "pragma_emit_insn", "vec_single_abs")
+        with ib.for_range(0, ROWS, "i") as i:
+            with ib.for_range(0, COLS, "j") as j:
+                y[i * ROW_STRIDE + j] = akg.tvm.abs(x[i * ROW_STRIDE + j])
+    return ib.get()
+
+
+def sum_last_axis():
+    ''' y[i] = sum(x[i, :]) over 8192 fp16 elements: the bisection reduction halves the rows with vadd down to one
+    repeat, the vector reduction runs vcadd over all 64 repeats and then over the partial sums '''
+    ib = akg.tvm.ir_builder.create()
+    zero = akg.tvm.const(0, "int32")
+    x = ib.pointer("float16", name="x_local_UB")
+    y = ib.pointer("float16", name="y_local_UB")
+    with ib.new_scope():
+        ib.scope_attr(zero, "pragma_emit_insn", "vec_binary_add")
+        with ib.for_range(0, 2, "i") as i:
+            with ib.for_range(0, REDUCE_LEN, "j") as j:
+                y[i] = y[i] + x[i * REDUCE_LEN + j]
+    return ib.get()
+
+
+def emit(stmt, insn="vabs"):
+    ''' the comments of the emitted insn, which contains the instruction insn '''
+    os.environ["COMMENT_LEVEL"] = "3"
+    try:
+        res = akg.tvm.ir_pass.EmitInsn(stmt, True, False, {}, False)
+    finally:
+        del os.environ["COMMENT_LEVEL"]
+    comments = {}
+    calls = []
+
+    def visit(op):
+        if isinstance(op, akg.tvm.stmt.AttrStmt) and op.attr_key == "pragma_insn_comment":
+            for item in op.value.value.split("#")[1:]:
+                key, _, value = item.partition(" ")
+                comments[key] = value
+        if isinstance(op, akg.tvm.expr.Call) and op.name == insn:
+            calls.append(op)
+    akg.tvm.ir_pass.PostOrderVisit(res, visit)
+    assert calls
+    return comments
+
+
+def insn_cost(comments):
+    ''' (name, cost) of each candidate in the order they were tried, and the chosen one '''
+    report, _, chosen = comments["Insn_cost"].rpartition(" -> ")
+    candidates = []
+    for item in report.split():
+        name, _, cost = item.partition("[")
+        candidates.append((name, int(cost.rstrip("]"))))
+    return candidates, chosen
+
+
+def intrin_cost(latency, cycles_per_repeat, names=None):
+    ''' sets every intrinsic cost of the hardware profile, or only the ones of names while the others are free '''
+    def edit(profile):
+        for name in names or []:
+            profile["intrinsics"].setdefault(name, {"default": {}})
+        for name, dtypes in profile["intrinsics"].items():
+            for entry in dtypes.values():
+                chosen = names is None or name in names
+                entry["latency"] = latency if chosen else 0
+                entry["cycles_per_repeat"] = cycles_per_repeat if chosen else 0
+        return profile
+    return Profile(edit=edit)
+
+
+def test_tie_keeps_mask_rate_choice():
+    ''' every candidate is free, the first one is the mask rate choice and stays '''
+    with intrin_cost(0, 0):
+        comments = emit(strided_abs())
+    candidates, chosen = insn_cost(comments)
+    assert len(candidates) > 1
+    assert all(cost == 0 for _, cost in candidates)
+    assert candidates[0][0] == "2d_pattern"
+    assert chosen == "2d_pattern"
+    assert comments["Pattern"] == "2d_pattern"
+
+
+def test_latency_keeps_fewer_insns():
+    ''' each instruction costs the same whatever its repeats, one 2d instruction beats the body and tail '''
+    with intrin_cost(1000, 0):
+        comments = emit(strided_abs())
+    candidates, chosen = insn_cost(comments)
+    costs = dict(candidates)
+    assert chosen == "2d_pattern"
+    assert costs["2d_pattern"] < costs["partial_3d_pattern"]
+    assert comments["Pattern"] == "2d_pattern"
+
+
+def test_repeats_flip_to_partial_3d():
+    ''' each repeat dominates, two strided repeats beat one repeat per row '''
+    with intrin_cost(0, 1000):
+        comments = emit(strided_abs())
+    candidates, chosen = insn_cost(comments)
+    costs = dict(candidates)
+    assert candidates[0][0] == "2d_pattern"
+    assert chosen == "partial_3d_pattern"
+    assert costs["partial_3d_pattern"] == min(costs.values())
+    assert costs["partial_3d_pattern"] < costs["2d_pattern"]
+    # the comments are the ones of the chosen candidate
+    assert comments["Pattern"] == "partial_3d_pattern"
+
+
+def test_reduction_default_profile():
+    ''' with the default costs the 64 vcadd repeats are cheaper than six vadd halvings before one vcadd '''
+    comments = emit(sum_last_axis(), "vcadd")
+    candidates, chosen = insn_cost(comments)
+    costs = dict(candidates)
+    assert [name for name, _ in candidates] == ["bisection", "vector_reduction"]
+    assert chosen == "vector_reduction"
+    assert costs["vector_reduction"] < costs["bisection"]
+    # the comments are the ones of the vector reduction, not of the bisection
+    assert "Bisect_optimize" not in comments
+    assert comments["Compute_type"] == "reduce_last_axis"
+
+
+def test_reduction_forced_to_bisection():
+    ''' each vcadd repeat dominates, the bisection runs vcadd over one repeat and wins '''
+    with intrin_cost(0, 1000, ["vcadd"]):
+        comments = emit(sum_last_axis(), "vcadd")
+    candidates, chosen = insn_cost(comments)
+    costs = dict(candidates)
+    assert chosen == "bisection"
+    assert costs["bisection"] < costs["vector_reduction"]
+    assert comments["Bisect_optimize"] == "enabled"
+
+
+if __name__ == "__main__":
+    test_tie_keeps_mask_rate_choice()
+    test_latency_keeps_fewer_insns()
+    test_repeats_flip_to_partial_3d()
+    test_reduction_default_profile()
+    test_reduction_forced_to_bisection()
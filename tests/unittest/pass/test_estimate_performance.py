@@ -0,0 +1,103 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import akg.tvm
+
+REPEAT = 128
+FULL_MASK = 128
+
+
+def set_mask(ib, lo):
+    ib.emit(akg.tvm.call_extern("float16", "set_vector_mask", akg.tvm.const(0, "uint64"),
+                                akg.tvm.const(lo, "uint64")))
+
+
+def vadd(ib, buf, repeat):
+    ptr = akg.tvm.call_pure_intrin("handle", "tvm_access_ptr", akg.tvm.const(0, "float16"), buf, 0, 128, 3)
+    ib.emit(akg.tvm.call_extern("float16", "vadd", ptr, ptr, ptr, akg.tvm.const(repeat, "int32"), 1, 1, 1, 8, 8, 8))
+
+
+def barrier(ib):
+    ib.emit(akg.tvm.call_extern("int32", "pipe_barrier", akg.tvm.const(2, "int32")))
+
+
+def effective(stmt):
+    ''' full vector repeats the vector instructions amount to '''
+    return akg.tvm.ir_pass.EstimatePerformance(stmt)["pipe_v_effective"].value
+
+
+def test_else_ignores_then_mask():
+    ''' a mask set in the then branch does not price the else branch, only the larger branch counts '''
+    ib = akg.tvm.ir_builder.create()
+    n = akg.tvm.var("n")
+    buf = ib.allocate("float16", 128, name="buf", scope="local.UB")
+    with ib.if_scope(n > 0):
+        set_mask(ib, 0xf)
+        vadd(ib, buf, 1)
+    with ib.else_scope():
+        vadd(ib, buf, REPEAT)
+    # priced with the mask of the then branch the else branch would only amount to 4 full repeats
+    assert effective(ib.get()) == REPEAT
+
+
+def test_branch_max():
+    ''' lanes and syncs of an if take the larger branch, not the sum of both '''
+    ib = akg.tvm.ir_builder.create()
+    n = akg.tvm.var("n")
+    buf = ib.allocate("float16", 128, name="buf", scope="local.UB")
+    vadd(ib, buf, REPEAT)
+    barrier(ib)
+    with ib.if_scope(n > 0):
+        vadd(ib, buf, 2 * REPEAT)
+        barrier(ib)
+        barrier(ib)
+    with ib.else_scope():
+        vadd(ib, buf, 3 * REPEAT)
+        barrier(ib)
+    res = akg.tvm.ir_pass.EstimatePerformance(ib.get())
+    assert res["pipe_v_effective"].value == REPEAT + 3 * REPEAT
+    assert res["sync"].value == 1 + 2
+
+
+def test_mask_after_if():
+    ''' after the if the mask is known when both branches leave the same one, else it is taken as full '''
+    for else_mask, bits in ((0xf, 4), (0xff, FULL_MASK)):
+        ib = akg.tvm.ir_builder.create()
+        n = akg.tvm.var("n")
+        buf = ib.allocate("float16", 128, name="buf", scope="local.UB")
+        with ib.if_scope(n > 0):
+            set_mask(ib, 0xf)
+        with ib.else_scope():
+            set_mask(ib, else_mask)
+        vadd(ib, buf, REPEAT)
+        assert effective(ib.get()) == REPEAT * bits // FULL_MASK
+
+
+def test_mask_without_else():
+    ''' an if without else may leave the mask set before it '''
+    ib = akg.tvm.ir_builder.create()
+    n = akg.tvm.var("n")
+    buf = ib.allocate("float16", 128, name="buf", scope="local.UB")
+    set_mask(ib, 0xf)
+    with ib.if_scope(n > 0):
+        set_mask(ib, 0xff)
+    vadd(ib, buf, REPEAT)
+    assert effective(ib.get()) == REPEAT
+
+
+if __name__ == "__main__":
+    test_else_ignores_then_mask()
+    test_branch_max()
+    test_mask_after_if()
+    test_mask_without_else()
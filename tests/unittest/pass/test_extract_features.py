@@ -0,0 +1,89 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import math
+import akg.tvm
+
+TRIPS = 4
+N_BURST = 2
+LEN_BURST = 4
+REPEAT = 8
+
+
+def access(buf, rw):
+    return akg.tvm.call_pure_intrin("handle", "tvm_access_ptr", akg.tvm.const(0, "float16"), buf, 0, 128, rw)
+
+
+def copy_mask_vadd():
+    ''' a loop of copy in, set_vector_mask with 4 lanes and vadd '''
+    ib = akg.tvm.ir_builder.create()
+    gm = ib.allocate("float16", 128, name="gm")
+    ub = ib.allocate("float16", 128, name="ub", scope="local.UB")
+    with ib.for_range(0, TRIPS, name="i"):
+        ib.emit(akg.tvm.call_extern("float16", "copy_gm_to_ubuf", access(ub, 2), access(gm, 1),
+                                    0, N_BURST, LEN_BURST, 0, 0))
+        ib.emit(akg.tvm.call_extern("float16", "set_vector_mask", akg.tvm.const(0, "uint64"),
+                                    akg.tvm.const(0xf, "uint64")))
+        ib.emit(akg.tvm.call_extern("float16", "vadd", access(ub, 2), access(ub, 1), access(ub, 1),
+                                    akg.tvm.const(REPEAT, "int32"), 1, 1, 1, 8, 8, 8))
+    return ib.get()
+
+
+def log_scale(v):
+    return math.log2(1.0 + v)
+
+
+def test_features():
+    names = [n.value for n in akg.tvm.ir_pass.FeatureNames()]
+    res = akg.tvm.ir_pass.ExtractFeatures([copy_mask_vadd(), copy_mask_vadd()])
+    assert len(res) == 2
+    for features in res:
+        assert len(features) == len(names)
+        f = dict(zip(names, [v.value for v in features]))
+        assert f["num_loops"] == 1
+        assert f["max_loop_depth"] == 1
+        assert math.isclose(f["dma_count"], log_scale(TRIPS), rel_tol=1e-5)
+        assert math.isclose(f["dma_bursts"], log_scale(TRIPS * N_BURST), rel_tol=1e-5)
+        assert math.isclose(f["dma_bytes"], log_scale(TRIPS * N_BURST * LEN_BURST * 32), rel_tol=1e-5)
+        assert math.isclose(f["insn_mte2"], log_scale(TRIPS), rel_tol=1e-5)
+        assert math.isclose(f["vector_repeats"], log_scale(TRIPS * REPEAT), rel_tol=1e-5)
+        assert math.isclose(f["mask_density"], 4.0 / 128, rel_tol=1e-5)
+
+
+def test_mask_in_branches():
+    ''' a mask set in the then branch prices neither the else branch nor, when they differ, the code after the if '''
+    ib = akg.tvm.ir_builder.create()
+    n = akg.tvm.var("n")
+    ub = ib.allocate("float16", 128, name="ub", scope="local.UB")
+
+    def vadd():
+        ib.emit(akg.tvm.call_extern("float16", "vadd", access(ub, 2), access(ub, 1), access(ub, 1),
+                                    akg.tvm.const(REPEAT, "int32"), 1, 1, 1, 8, 8, 8))
+    with ib.if_scope(n > 0):
+        ib.emit(akg.tvm.call_extern("float16", "set_vector_mask", akg.tvm.const(0, "uint64"),
+                                    akg.tvm.const(0xf, "uint64")))
+        vadd()
+    with ib.else_scope():
+        vadd()
+    vadd()
+    names = [name.value for name in akg.tvm.ir_pass.FeatureNames()]
+    features = akg.tvm.ir_pass.ExtractFeatures([ib.get()])[0]
+    f = dict(zip(names, [v.value for v in features]))
+    assert math.isclose(f["vector_repeats"], log_scale(3 * REPEAT), rel_tol=1e-5)
+    assert math.isclose(f["mask_density"], (4.0 + 128 + 128) / (3 * 128), rel_tol=1e-5)
+
+
+if __name__ == "__main__":
+    test_features()
+    test_mask_in_branches()
@@ -0,0 +1,46 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""footprints computed by poly_footprint_threads workers equal the serial ones"""
+import akg
+import akg.tvm
+
+NUM_TAPS = 9
+
+
+def lower_taps(threads):
+    ''' out(i, j) = x(i, j) + x(i, j + 1) + ... + x(i, j + 8), nine accesses of x '''
+    x = akg.tvm.placeholder((32, 64 + NUM_TAPS), name="x", dtype="float16")
+
+    def taps(i, j):
+        res = x[i, j]
+        for k in range(1, NUM_TAPS):
+            res = res + x[i, j + k]
+        return res
+
+    out = akg.tvm.compute((32, 64), taps, name="out")
+    s = akg.tvm.create_schedule(out.op)
+    attrs = {"poly_footprint_threads": threads}
+    stmt = akg.lower(s, [x, out], [], "taps", None, attrs, True, True)
+    return str(stmt)
+
+
+def test_threads_match_serial():
+    serial = lower_taps(1)
+    assert lower_taps(4) == serial
+    assert lower_taps(8) == serial
+
+
+if __name__ == '__main__':
+    test_threads_match_serial()
@@ -0,0 +1,74 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""memory sizes and the core count of a loaded hardware profile reach the passes that read them"""
+import akg.tvm
+from akg import backend
+from hardware_profile_utils import Profile, dump_profile, load_profile
+
+
+def test_memory_size():
+    ''' a new size of local.UB is the limit tiling and storage rewrite read from the memory info '''
+    ub_info = akg.tvm.get_global_func("tvm.info.mem.local.UB")
+    size = ub_info().max_num_bits // 8
+    with Profile({"memory": {"local.UB": {"size": size // 2}}}):
+        assert ub_info().max_num_bits == size // 2 * 8
+        dump = dump_profile()
+        assert dump["memory"]["local.UB"] == {"size": size // 2}
+    assert ub_info().max_num_bits == size * 8
+
+
+def test_core_num():
+    ''' without a block dim the multicore split takes the core count of the profile '''
+    def split(core_num):
+        ib = akg.tvm.ir_builder.create()
+        zero = akg.tvm.const(0, "int32")
+        a = ib.pointer("float32", name="A")
+        with ib.for_range(0, 100, "i") as i:
+            with ib.new_scope():
+                ib.scope_attr(zero, "pragma_emit_insn", "dma_copy")
+                with ib.for_range(0, 1024, "j") as j:
+                    a[i * 1024 + j] = akg.tvm.const(1, a.dtype)
+        with Profile({"core_num": core_num}):
+            stmt = akg.tvm.ir_pass.InjectMultiCore(ib.get(), 0, 0, False, False, False)
+        assert stmt.attr_key == "thread_extent"
+        return stmt.value.value
+
+    assert split(2) == 2
+    assert split(4) == 4
+
+
+def test_round_trip():
+    ''' loading a dump gives the same dump, sizes and the core count of the product section stay unset '''
+    saved = dump_profile()
+    with Profile({"memory": {"local.UB": {"size": 1024}}, "core_num": 3}):
+        load_profile(dump_profile())
+        dump = dump_profile()
+        assert dump["memory"]["local.UB"] == {"size": 1024}
+        assert dump["core_num"] == 3
+        load_profile(dump)
+        assert dump_profile() == dump
+    assert dump_profile() == saved
+    load_profile(saved)
+    assert dump_profile() == saved
+    # the size of the product section is not pinned by the dump
+    if saved["memory"]["local.UB"]["size"] < 0:
+        product = backend.CceProductParams().get_params_("Unified_Buffer")
+        assert akg.tvm.get_global_func("cce.hardware_profile_memory_size")("local.UB") == product
+
+
+if __name__ == "__main__":
+    test_memory_size()
+    test_core_num()
+    test_round_trip()
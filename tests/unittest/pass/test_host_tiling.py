@@ -0,0 +1,89 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""the host tiling written to the kernel json gives the same tile factors in a process that did not lower it"""
+import os
+import shutil
+import tempfile
+import akg
+import akg.tvm
+from akg.backend import cce_runtime
+from akg.utils import kernel_exec as utils
+
+KERNEL = "add_host_tiling"
+SHAPES = ([32, 16, 56, 56, 16], [1, 1, 7, 7, 16], [8, 4, 14, 14, 16])
+
+
+def lower_add():
+    ''' dynamic add of two NC1HWC0 tensors, its tile factors are computed on the host '''
+    shape = [akg.tvm.var("I%d" % i) for i in range(5)]
+    a = akg.tvm.placeholder(shape, "float16", name="a")
+    b = akg.tvm.placeholder(shape, "float16", name="b")
+    out = akg.tvm.compute(shape, lambda *i: a(*i) + b(*i), name="out")
+    s = akg.tvm.create_schedule(out.op)
+    attrs = {"dynamic": True, "enable_double_buffer": False, "enable_host_tiling": True}
+    with akg.build_config(add_lower_pass=[], dump_pass_ir=False):
+        akg.lower(s, [a, b, out], shape, KERNEL, None, attrs, True, True)
+
+
+def write_kernel_json():
+    ''' kernel json of KERNEL as written after the device code is compiled '''
+    os.makedirs("kernel_meta")
+    with open(os.path.join("kernel_meta", KERNEL + ".o"), "wb") as f:
+        f.write(b"\0")
+    cce_runtime.tvm_callback_cce_postproc('extern "C" __global__ __aicore__ void %s_kernel0() {}' % KERNEL)
+    return os.path.join("kernel_meta", KERNEL + ".json")
+
+
+def test_save_load_lookup():
+    ''' lookup by name reads the kernel json of a kernel that was not lowered here '''
+    cwd = os.getcwd()
+    work_dir = tempfile.mkdtemp()
+    os.chdir(work_dir)
+    try:
+        lower_add()
+        expect = [utils.get_host_tiling_args(KERNEL, shape) for shape in SHAPES]
+        assert all(expect)
+        json_file = write_kernel_json()
+
+        # same kernel json under a name no lowering has registered, as a loading process sees it
+        loaded = KERNEL + "_loaded"
+        assert not akg.tvm.get_global_func("akg.host_tiling.tile_vars")(loaded)
+        shutil.copy(json_file, os.path.join("kernel_meta", loaded + ".json"))
+        assert [utils.get_host_tiling_args(loaded, shape) for shape in SHAPES] == expect
+
+        # the saved tiling of the loaded kernel is the one it was loaded from
+        save = akg.tvm.get_global_func("akg.host_tiling.save")
+        assert save(loaded) == save(KERNEL)
+    finally:
+        os.chdir(cwd)
+        shutil.rmtree(work_dir)
+
+
+def test_no_host_tiling():
+    ''' a kernel json without host tiling gives no tile arguments '''
+    cwd = os.getcwd()
+    work_dir = tempfile.mkdtemp()
+    os.chdir(work_dir)
+    try:
+        assert not utils.load_host_tiling("add_static")
+        assert utils.get_host_tiling_args("add_static", [1]) == []
+    finally:
+        os.chdir(cwd)
+        shutil.rmtree(work_dir)
+
+
+if __name__ == "__main__":
+    test_save_load_lookup()
+    test_no_host_tiling()
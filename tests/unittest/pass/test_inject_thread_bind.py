@@ -28,7 +28,7 @@ def test_single_axis_001():
                 A[i * 1024 + j] = akg.tvm.const(1, A.dtype)
     stmt = ib.get()
     # print(stmt)
-    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 4, 0, False)
+    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 4, 0, False, False, False)
     # print(stmt)
     assert(stmt.attr_key == "thread_extent")
     assert(stmt.value.value == 4)
@@ -47,7 +47,7 @@ def test_single_axis_002():
                 A[i * 1024 + j] = akg.tvm.const(1, A.dtype)
     stmt = ib.get()
     # print(stmt)
-    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 4, 0, False)
+    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 4, 0, False, False, False)
     # print(stmt)
     assert(stmt.attr_key == "thread_extent")
     assert(stmt.value.value == 4)
@@ -66,7 +66,7 @@ def test_single_axis_003():
                 A[i * 1024 + j] = akg.tvm.const(1, A.dtype)
     stmt = ib.get()
     # print(stmt)
-    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 8, 0, False)
+    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 8, 0, False, False, False)
     # print(stmt)
     assert(stmt.attr_key == "thread_extent")
     assert(stmt.value.value == 7)
@@ -85,7 +85,7 @@ def test_multi_axis_001():
                     A[i * 8192 + k * 1024 + j] = akg.tvm.const(1, A.dtype)
     stmt = ib.get()
     # print(stmt)
-    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 8, 0, False)
+    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 8, 0, False, False, False)
     # print(stmt)
     assert(stmt.attr_key == "thread_extent")
     assert(stmt.value.value == 8)
@@ -105,7 +105,7 @@ def test_multi_axis_002():
                     A[(i * 6 + k) * 1024 + j] = akg.tvm.const(1, A.dtype)
     stmt = ib.get()
     # print(stmt)
-    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 8, 0, False)
+    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 8, 0, False, False, False)
     # print(stmt)
     assert(stmt.attr_key == "thread_extent")
     assert(stmt.value.value == 6)
@@ -125,7 +125,7 @@ def test_dep_between_core_001():
                     A[(i * 8 + k) * 7 + j] = akg.tvm.const(1, A.dtype)
     stmt = ib.get()
     # print(stmt)
-    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 8, 0, False)
+    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 8, 0, False, False, False)
     # print(stmt)
     assert(not isinstance(stmt, akg.tvm.stmt.AttrStmt))
 
@@ -148,7 +148,7 @@ def test_dep_between_core_002():
                     A[(i * 8 + k) * 32 + j] = AL[j]
     stmt = ib.get()
     # print(stmt)
-    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 8, 0, False)
+    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 8, 0, False, False, False)
     # print(stmt)
     assert(stmt.attr_key == "thread_extent")
     assert(stmt.value.value == 2)
@@ -168,7 +168,7 @@ def test_dep_between_core_003():
                     A[(i * 8 + k) * 11 + j] = akg.tvm.const(1, A.dtype)
     stmt = ib.get()
     # print(stmt)
-    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 8, 0, False)
+    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 8, 0, False, False, False)
     # print(stmt)
     assert(stmt.attr_key == "thread_extent")
     assert(stmt.value.value == 8)
@@ -193,7 +193,7 @@ def test_plan_sibling_loop():
                 B[i * 1024 + j] = akg.tvm.const(1, B.dtype)
     stmt = ib.get()
     # print(stmt)
-    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 4, 0, False)
+    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 4, 0, False, False, False)
     # print(stmt)
     assert(not isinstance(stmt, akg.tvm.stmt.AttrStmt))
 
@@ -214,7 +214,7 @@ def test_plan_sibling_attrstmt():
         ib.emit(akg.tvm.call_pure_intrin("float32", "foo", zero))
     stmt = ib.get()
     # print(stmt)
-    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 4, 0, False)
+    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 4, 0, False, False, False)
     # print(stmt)
     assert(not isinstance(stmt, akg.tvm.stmt.AttrStmt))
 
@@ -231,12 +231,92 @@ def test_storage_scope_overtop_tolerant():
             AL[0] = A[i * 32]
     stmt = ib.get()
     # print(stmt)
-    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 8, 0, False)
+    stmt = akg.tvm.ir_pass.InjectMultiCore(stmt, 8, 0, False, False, False)
     # print(stmt)
     assert(stmt.attr_key == "thread_extent")
     assert(stmt.value.value == 8)
 
 
+def outer_copy(rows, cols, row_len):
+    ''' rows x cols independent copies of row_len floats, the two outer axes are the block axes '''
+    ib = akg.tvm.ir_builder.create()
+    zero = akg.tvm.const(0, "int32")
+    A = ib.pointer("float32", name='A')
+    with ib.for_range(0, rows, 'i') as i:
+        with ib.for_range(0, cols, 'j') as j:
+            with ib.new_scope():
+                ib.scope_attr(zero, "pragma_emit_insn", "dma_copy")
+                with ib.for_range(0, row_len, 'k') as k:
+                    A[(i * cols + j) * row_len + k] = akg.tvm.const(1, A.dtype)
+    return ib.get()
+
+
+def find(stmt, pred):
+    found = []
+
+    def visit(op):
+        if pred(op):
+            found.append(op)
+    akg.tvm.ir_pass.PostOrderVisit(stmt, visit)
+    return found
+
+
+def fused_loops(stmt):
+    return find(stmt, lambda op: isinstance(op, akg.tvm.stmt.For) and op.loop_var.name == "fused_idx")
+
+
+def fused_rows(stmt, row_len):
+    ''' rows copied by each core of a fused plan, replaying the guard and the index of every fused iteration '''
+    block_var = stmt.node.var
+    loop, = fused_loops(stmt)
+    let, = find(stmt, lambda op: isinstance(op, akg.tvm.stmt.LetStmt) and op.var.name == "fused_pos")
+    store, = find(stmt, lambda op: isinstance(op, akg.tvm.stmt.Store))
+    guard, = find(stmt, lambda op: isinstance(op, akg.tvm.stmt.IfThenElse))
+    k, = find(store.index, lambda op: isinstance(op, akg.tvm.expr.Var) and op.name == "k")
+    rows = []
+    for b in range(stmt.value.value):
+        core = []
+        for f in range(loop.extent.value):
+            vmap = {block_var: akg.tvm.const(b, "int32"), loop.loop_var: akg.tvm.const(f, "int32")}
+            if not akg.tvm.ir_pass.Simplify(akg.tvm.ir_pass.Substitute(guard.condition, vmap)).value:
+                continue
+            vmap[let.var] = akg.tvm.ir_pass.Substitute(let.value, vmap)
+            vmap[k] = akg.tvm.const(0, "int32")
+            offset = akg.tvm.ir_pass.Simplify(akg.tvm.ir_pass.Substitute(store.index, vmap)).value
+            core.append(offset // row_len)
+        rows.append(core)
+    return rows
+
+
+def test_balance_uneven_split():
+    ''' 3 x 11 rows on 8 cores: nested takes 6 rows per core, fused takes 5 over 7 cores with a guarded tail '''
+    nested = akg.tvm.ir_pass.InjectMultiCore(outer_copy(3, 11, 1024), 8, 0, False, False, False)
+    assert nested.value.value == 6
+    stmt = akg.tvm.ir_pass.InjectMultiCore(outer_copy(3, 11, 1024), 8, 0, False, False, True)
+    assert stmt.attr_key == "thread_extent"
+    assert stmt.value.value == 7
+    assert isinstance(stmt.body, akg.tvm.stmt.For) and stmt.body.loop_var.name == "fused_idx"
+    assert stmt.body.extent.value == 5
+    assert isinstance(stmt.body.body, akg.tvm.stmt.IfThenElse)
+    assert not fused_loops(nested)
+    rows = fused_rows(stmt, 1024)
+    # 33 = 5 * 5 + 4 * 2: each row once, the first cores take the extra one
+    assert [len(core) for core in rows] == [5, 5, 5, 5, 5, 4, 4]
+    assert sorted(r for core in rows for r in core) == list(range(33))
+
+
+def test_balance_not_triggered():
+    ''' balancing keeps the nested plan when the fused index and guard cost more than the rows they save '''
+    # small rows: one row costs less than the div, mod and guard of a fused iteration
+    stmt = akg.tvm.ir_pass.InjectMultiCore(outer_copy(3, 11, 8), 8, 0, False, False, True)
+    assert stmt.value.value == 6
+    assert not fused_loops(stmt)
+    # 2 x 17 on 32 cores: both plans run two rows per core, the fused one pays for its index
+    stmt = akg.tvm.ir_pass.InjectMultiCore(outer_copy(2, 17, 1024), 32, 0, False, False, True)
+    assert stmt.value.value == 18
+    assert not fused_loops(stmt)
+
+
 if __name__ == '__main__':
     test_single_axis_001()
     test_single_axis_002()
@@ -249,3 +329,5 @@ if __name__ == '__main__':
     test_plan_sibling_loop()
     test_plan_sibling_attrstmt()
     test_storage_scope_overtop_tolerant()
+    test_balance_uneven_split()
+    test_balance_not_triggered()
@@ -0,0 +1,59 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""a pooled isl ctx, reset after a kernel that changed its options, schedules like a fresh one"""
+import akg
+import akg.tvm
+import akg.topi
+
+# scheduler options that each set an isl option of the ctx away from its default
+POLLUTING_ATTRS = {"pragma_disable_loop_fusion": True, "pragma_disable_schedule_shift": True,
+                   "pragma_disable_loop_reversal": True}
+
+
+def stats():
+    ''' (allocated, reused) isl contexts of the pool since the process started '''
+    allocated, reused = akg.tvm.get_global_func("akg.poly.isl_ctx_pool_stats")()
+    return allocated.value, reused.value
+
+
+def lower_mul_sum(attrs):
+    ''' a product reduced over its last axis, two statements for the scheduler to fuse '''
+    a = akg.tvm.placeholder((16, 256), name="a", dtype="float16")
+    b = akg.tvm.placeholder((16, 256), name="b", dtype="float16")
+    out = akg.topi.sum(akg.topi.multiply(a, b), axis=1)
+    s = akg.tvm.create_schedule(out.op)
+    # the schedule cache would skip the isl scheduler on the second compile
+    attrs = dict(attrs, enable_schedule_cache=False)
+    stmt = akg.lower(s, [a, b, out], [], "mul_sum", None, attrs, True, True)
+    return str(stmt)
+
+
+def test_reset_ctx_schedules_like_fresh():
+    akg.tvm.get_global_func("akg.poly.isl_ctx_pool_clear")()
+    allocated, reused = stats()
+    fresh = lower_mul_sum({})
+    assert stats()[0] > allocated
+
+    lower_mul_sum(POLLUTING_ATTRS)
+    allocated, reused = stats()
+    pooled = lower_mul_sum({})
+    # every context of the last compile came back from the pool
+    assert stats()[0] == allocated
+    assert stats()[1] > reused
+    assert pooled == fresh
+
+
+if __name__ == "__main__":
+    test_reset_ctx_schedules_like_fresh()
@@ -0,0 +1,51 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""tiling chosen with the compiled memory model, in batches or not, equals the one of the reference timetable walk"""
+import akg
+import akg.tvm
+import akg.topi
+
+
+def lower_add(attrs):
+    ''' the long inner axis makes the solver try far more factors than one batch holds '''
+    a = akg.tvm.placeholder((16, 4000), name="a", dtype="float16")
+    b = akg.tvm.placeholder((16, 4000), name="b", dtype="float16")
+    out = akg.topi.add(a, b)
+    s = akg.tvm.create_schedule(out.op)
+    stmt = akg.lower(s, [a, b, out], [], "add", None, attrs, True, True)
+    return str(stmt)
+
+
+def lower_sum(attrs):
+    ''' a reduction keeps buffers of different shapes live, so the model has several entries '''
+    a = akg.tvm.placeholder((64, 2000), name="a", dtype="float32")
+    k = akg.tvm.reduce_axis((0, 2000), name="k")
+    out = akg.tvm.compute((64,), lambda i: akg.tvm.sum(a[i, k], axis=k), name="out")
+    s = akg.tvm.create_schedule(out.op)
+    stmt = akg.lower(s, [a, out], [], "row_sum", None, attrs, True, True)
+    return str(stmt)
+
+
+def test_batch_matches_reference():
+    for lower in (lower_add, lower_sum):
+        # the walk over the timetable the model was compiled from, one candidate at a time
+        reference = lower({"mem_infer_reference": True})
+        assert lower({"mem_infer_batch": 1}) == reference
+        assert lower({"mem_infer_batch": 7}) == reference
+        assert lower({"mem_infer_batch": 64}) == reference
+
+
+if __name__ == '__main__':
+    test_batch_matches_reference()
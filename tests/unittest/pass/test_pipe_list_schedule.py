@@ -0,0 +1,113 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import akg.tvm
+from hardware_profile_utils import Profile
+
+PIPE_V = 2
+PIPE_MTE2 = 5
+PIPE_MTE3 = 6
+INSNS = ("copy_gm_to_ubuf", "vabs", "copy_ubuf_to_gm")
+
+
+def access(buf, rw):
+    return akg.tvm.call_pure_intrin("handle", "tvm_access_ptr", akg.tvm.const(0, "float16"), buf, 0, 128, rw)
+
+
+def emit(ib, pipe, name, dst, src):
+    cp = akg.tvm.thread_axis("cce")
+    with ib.new_scope():
+        ib.scope_attr(cp, "coproc_scope", pipe)
+        ib.emit(akg.tvm.call_extern("float16", name, access(dst, 2), access(src, 1)))
+
+
+def load_abs_store(num):
+    ''' num independent chains of copy in, vabs, copy out; the copy out waits for the vector pipe '''
+    ib = akg.tvm.ir_builder.create()
+    # allocate first, the instructions form one sequence
+    bufs = []
+    for i in range(num):
+        bufs.append((ib.allocate("float16", 128, name="src%d" % i),
+                     ib.allocate("float16", 128, name="in%d" % i, scope="local.UB"),
+                     ib.allocate("float16", 128, name="out%d" % i, scope="local.UB"),
+                     ib.allocate("float16", 128, name="dst%d" % i)))
+    for src, ub_in, ub_out, dst in bufs:
+        emit(ib, PIPE_MTE2, INSNS[0], ub_in, src)
+        emit(ib, PIPE_V, INSNS[1], ub_out, ub_in)
+        emit(ib, PIPE_MTE3, INSNS[2], dst, ub_out)
+    return ib.get()
+
+
+def insn_order(stmt):
+    ''' (chain, step) of the instructions in program order '''
+    order = []
+
+    def visit(op):
+        if isinstance(op, akg.tvm.expr.Call) and op.name in INSNS:
+            dst = op.args[0].args[1].name_hint
+            order.append((int(dst.lstrip("abcdefghijklmnopqrstuvwxyz")), INSNS.index(op.name)))
+    akg.tvm.ir_pass.PostOrderVisit(stmt, visit)
+    return order
+
+
+def source_order(num):
+    return [(i, step) for i in range(num) for step in range(len(INSNS))]
+
+
+def count_syncs(stmt):
+    num = [0]
+
+    def visit(op):
+        if isinstance(op, akg.tvm.expr.Call) and op.name in ("cce.coproc_dep_push", "cce.coproc_sync"):
+            num[0] += 1
+    akg.tvm.ir_pass.PostOrderVisit(akg.tvm.ir_pass.InjectSync(stmt), visit)
+    return num[0]
+
+
+def pipe_latency(latency):
+    ''' overrides the pipe latencies of the hardware profile '''
+    return Profile({"pipes": {k: {"latency": v} for k, v in latency.items()}})
+
+
+def test_hoist_copy_in():
+    ''' the next copy in is issued before the copy out that waits for the vector pipe '''
+    stmt = load_abs_store(3)
+    res = akg.tvm.ir_pass.PipeListSchedule(stmt)
+    assert insn_order(res) == [(0, 0), (0, 1), (1, 0), (0, 2), (1, 1), (2, 0), (1, 2), (2, 1), (2, 2)]
+    assert count_syncs(res) <= count_syncs(stmt)
+
+
+def test_keep_order_of_more_events():
+    ''' with a slow vector pipe all copies in go first, six of them would wait on four event ids '''
+    with pipe_latency({"pipe_v": 1000, "pipe_mte2": 10, "pipe_mte3": 10}):
+        stmt = load_abs_store(3)
+        res = akg.tvm.ir_pass.PipeListSchedule(stmt)
+        assert insn_order(res) != source_order(3)
+        stmt = load_abs_store(6)
+        res = akg.tvm.ir_pass.PipeListSchedule(stmt)
+        assert insn_order(res) == source_order(6)
+
+
+def test_no_more_syncs():
+    for num in range(2, 8):
+        stmt = load_abs_store(num)
+        res = akg.tvm.ir_pass.PipeListSchedule(stmt)
+        assert sorted(insn_order(res)) == source_order(num)
+        assert count_syncs(res) <= count_syncs(stmt)
+
+
+if __name__ == "__main__":
+    test_hoist_copy_in()
+    test_keep_order_of_more_events()
+    test_no_more_syncs()
@@ -0,0 +1,91 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""a cached isl schedule gives the IR of a fresh one, and is only reused for the same model and options"""
+import akg
+import akg.tvm
+import akg.topi
+
+
+def stats():
+    ''' (hits, misses) of the schedule cache since the last clear '''
+    hits, misses = akg.tvm.get_global_func("akg.poly.schedule_cache_stats")()
+    return hits.value, misses.value
+
+
+def clear():
+    akg.tvm.get_global_func("akg.poly.schedule_cache_clear")()
+
+
+def lower_add(attrs, shape=(16, 4000)):
+    a = akg.tvm.placeholder(shape, name="a", dtype="float16")
+    b = akg.tvm.placeholder(shape, name="b", dtype="float16")
+    out = akg.topi.add(a, b)
+    s = akg.tvm.create_schedule(out.op)
+    stmt = akg.lower(s, [a, b, out], [], "add", None, dict(attrs), True, True)
+    return str(stmt)
+
+
+def lower_dynamic_add(attrs):
+    shape = [akg.tvm.var("I0"), akg.tvm.var("I1")]
+    a = akg.tvm.placeholder(shape, name="a", dtype="float16")
+    b = akg.tvm.placeholder(shape, name="b", dtype="float16")
+    out = akg.topi.add(a, b)
+    s = akg.tvm.create_schedule(out.op)
+    attrs = dict(attrs, dynamic=True, enable_double_buffer=False)
+    stmt = akg.lower(s, [a, b, out], shape, "add_dynamic", None, attrs, True, True)
+    return str(stmt)
+
+
+def test_hit_matches_fresh_schedule():
+    ''' the second compile reuses the schedule of the first, both equal a compile without the cache '''
+    clear()
+    fresh = lower_add({"enable_schedule_cache": False})
+    assert stats() == (0, 0)
+    first = lower_add({})
+    hits, misses = stats()
+    assert hits == 0 and misses > 0
+    second = lower_add({})
+    assert stats() == (misses, misses)
+    assert first == fresh
+    assert second == fresh
+
+
+def test_options_miss():
+    ''' scheduler options from the attrs are part of the key, other options compute their own schedule '''
+    clear()
+    lower_add({})
+    _, misses = stats()
+    lower_add({"pragma_disable_loop_fusion": True})
+    hits, misses_options = stats()
+    assert hits == 0
+    assert misses_options > misses
+    # another extent is another model as well
+    lower_add({}, (16, 2000))
+    assert stats()[0] == 0
+
+
+def test_dynamic_shape_not_cached():
+    ''' a dynamic kernel never reads nor fills the cache '''
+    clear()
+    fresh = lower_dynamic_add({"enable_schedule_cache": False})
+    assert lower_dynamic_add({}) == fresh
+    assert lower_dynamic_add({}) == fresh
+    assert stats() == (0, 0)
+
+
+if __name__ == "__main__":
+    test_hit_matches_fresh_schedule()
+    test_options_miss()
+    test_dynamic_shape_not_cached()
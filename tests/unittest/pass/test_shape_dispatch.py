@@ -0,0 +1,94 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""the shape dispatcher calls the smallest bucket covering the shape, without a card"""
+import akg.tvm
+from akg.utils import dynamic_shape as ds_util
+
+
+def kernel(name, n, m):
+    ''' an empty kernel taking one tensor and the shape vars, like a bucket kernel or the generic one '''
+    buf = akg.tvm.decl_buffer((n, m), "float16", name="A")
+    body = akg.tvm.make.Evaluate(akg.tvm.const(0, "int32"))
+    return akg.tvm.ir_pass.MakeAPI(body, name, [buf, n, m], 0, True)
+
+
+def dispatcher(buckets):
+    n = akg.tvm.var("n")
+    m = akg.tvm.var("m")
+    specs = [kernel("add_bucket%d" % i, n, m) for i in range(len(buckets))]
+    make = akg.tvm.get_global_func("_MakeShapeDispatcher")
+    return make("add", kernel("add_generic", n, m), specs, buckets)
+
+
+def callee(func, shape):
+    ''' name of the kernel the dispatcher calls for shape, a dict {var name: value} '''
+    branches = []
+
+    def visit(op):
+        # the argument checks of MakeAPI have branches too, keep the ones calling a kernel
+        if isinstance(op, akg.tvm.stmt.IfThenElse) and isinstance(op.then_case, akg.tvm.stmt.Evaluate) and \
+                isinstance(op.then_case.value, akg.tvm.expr.Call) and op.then_case.value.name == "tvm_call_packed":
+            branches.append(op)
+    akg.tvm.ir_pass.PostOrderVisit(func.body, visit)
+    # post order visits the innermost branch first
+    for branch in reversed(branches):
+        names = dict()
+
+        def collect(op):
+            if isinstance(op, akg.tvm.expr.Var) and op.name in shape:
+                names[op] = akg.tvm.const(shape[op.name], op.dtype)
+        akg.tvm.ir_pass.PostOrderVisit(branch.condition, collect)
+        cond = akg.tvm.ir_pass.Simplify(akg.tvm.ir_pass.Substitute(branch.condition, names))
+        assert isinstance(cond, akg.tvm.expr.IntImm)
+        if cond.value:
+            return branch.then_case.value.args[0].value
+    return branches[-1].else_case.value.args[0].value
+
+
+def test_smallest_covering_bucket():
+    ''' buckets in any order, a shape between buckets runs the next larger one '''
+    func = dispatcher([{"n": 64, "m": 16}, {"n": 16, "m": 16}, {"n": 128, "m": 16}, {"n": 32, "m": 16}])
+    assert callee(func, {"n": 56, "m": 16}) == "add_bucket0"
+    assert callee(func, {"n": 64, "m": 16}) == "add_bucket0"
+    assert callee(func, {"n": 16, "m": 16}) == "add_bucket1"
+    assert callee(func, {"n": 1, "m": 1}) == "add_bucket1"
+    assert callee(func, {"n": 17, "m": 16}) == "add_bucket3"
+    assert callee(func, {"n": 100, "m": 8}) == "add_bucket2"
+
+
+def test_uncovered_shape_runs_generic():
+    ''' a shape above every bucket in any var goes to the generic kernel '''
+    func = dispatcher([{"n": 64, "m": 16}, {"n": 16, "m": 32}])
+    assert callee(func, {"n": 65, "m": 16}) == "add_generic"
+    assert callee(func, {"n": 32, "m": 32}) == "add_generic"
+    assert callee(func, {"n": 16, "m": 20}) == "add_bucket1"
+
+
+def test_bucket_shape_limits():
+    ''' a bucket bounds its vars and the tensor axes they size, the var bound of poly is exclusive '''
+    n = akg.tvm.var("n")
+    m = akg.tvm.var("m")
+    a = akg.tvm.placeholder((n, m, 16), "float16", name="input_1")
+    nodes = ds_util.bucket_shape_limits({"n": 64, "m": 32}, [a])
+    var_bounds = dict((d.tensor_name, d.poly_upper_bound) for d in nodes if d.poly_upper_bound > 0)
+    axis_limits = dict((d.pos, d.dyn_shape_limit) for d in nodes if d.tensor_name == "input_1")
+    assert var_bounds == {"n": 65, "m": 33}
+    assert axis_limits == {0: 64, 1: 32}
+
+
+if __name__ == "__main__":
+    test_smallest_covering_bucket()
+    test_uncovered_shape_runs_generic()
+    test_bucket_shape_limits()
@@ -0,0 +1,58 @@
+# Copyright 2026 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""after a local.UB rewrite failure the retry learns a limit that fits at once, and tiles like a fresh analysis"""
+import akg
+import akg.tvm
+import akg.topi
+
+
+def stats():
+    ''' (retries, retries that reused the analysis, local.UB limit of the last solve) '''
+    retries, reused, ub_limit = akg.tvm.get_global_func("akg.poly.tiling_retry_stats")()
+    return retries.value, reused.value, ub_limit.value
+
+
+def lower_add(ub_limit):
+    ''' large enough for the tiles to be bounded by the local.UB limit the solver plans for '''
+    a = akg.tvm.placeholder((64, 16384), name="a", dtype="float16")
+    b = akg.tvm.placeholder((64, 16384), name="b", dtype="float16")
+    out = akg.topi.add(a, b)
+    s = akg.tvm.create_schedule(out.op)
+    attrs = {"tiling_ub_limit": ub_limit}
+    stmt = akg.lower(s, [a, b, out], [], "add", None, attrs, True, True)
+    return str(stmt)
+
+
+def test_retry_fits_in_one_step():
+    ub_size = akg.tvm.get_global_func("tvm.info.mem.local.UB")().max_num_bits // 8
+    clear = akg.tvm.get_global_func("akg.poly.tiling_retry_stats_clear")
+
+    # planning for twice the local.UB size makes StorageRewriteCCE fail on the first attempt
+    clear()
+    retried = lower_add(2 * ub_size)
+    retries, reused, learned = stats()
+    assert retries == 1
+    assert reused == 1
+    assert 0 < learned <= ub_size
+
+    # a fresh analysis given the learned limit fits without a retry and chooses the same tiling
+    clear()
+    fresh = lower_add(learned)
+    assert stats() == (0, 0, learned)
+    assert fresh == retried
+
+
+if __name__ == "__main__":
+    test_retry_fits_in_one_step()
@@ -27,7 +27,27 @@ casefiles=(
 "pass/test_copy_propagation.py"
 "pass/test_utils_detect_non_linear_index.py"
 "pass/test_insn_info.py"
-"pass/test_buffer_align.py")
+"pass/test_buffer_align.py"
+"pass/test_autodiff_adjoint_sum.py"
+"pass/test_footprint_threads.py"
+"pass/test_mem_infer_batch.py"
+"pass/test_pipe_list_schedule.py"
+"pass/test_estimate_performance.py"
+"pass/test_extract_features.py"
+"pass/test_coalesce_dma.py"
+"pass/test_access_summary.py"
+"pass/test_emit_insn_cost.py"
+"pass/test_hardware_profile.py"
+"pass/test_shape_dispatch.py"
+"pass/test_host_tiling.py"
+"pass/test_schedule_cache.py"
+"pass/test_inject_thread_bind.py"
+"pass/test_auto_inline.py"
+"pass/test_autodiff_canonicalize.py"
+"pass/test_isl_ctx_pool.py"
+"pass/test_tiling_retry.py"
+"pass/test_auto_double_buffer.py"
+"pass/test_elim_dma.py")
 
 for case in ${casefiles[@]}
 do
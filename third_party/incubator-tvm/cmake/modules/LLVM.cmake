@@ -15,6 +15,10 @@
 # specific language governing permissions and limitations
 # under the License.
 
+#
+# 2026.10.16 - Modify current directory of tvm.
+#
+
 # LLVM rules
 add_definitions(-DDMLC_USE_FOPEN64=0)
 
@@ -26,7 +30,7 @@ if(NOT USE_LLVM STREQUAL "OFF")
   message(STATUS "Set TVM_LLVM_VERSION=" ${TVM_LLVM_VERSION})
   # Set flags that are only needed for LLVM target
   add_definitions(-DTVM_LLVM_VERSION=${TVM_LLVM_VERSION})
-  file(GLOB COMPILER_LLVM_SRCS src/codegen/llvm/*.cc)
+  file(GLOB COMPILER_LLVM_SRCS ${TVM_DIR}/src/codegen/llvm/*.cc)
   list(APPEND TVM_LINKER_LIBS ${LLVM_LIBS})
   list(APPEND COMPILER_SRCS ${COMPILER_LLVM_SRCS})
   if(NOT MSVC)
@@ -24,6 +24,7 @@
 
 /*
  * 2019.12.30 - Add a new type return value of cce.
+ * 2026.10.16 - Add the name of page-locked host memory.
  */
 
 #ifndef TVM_RUNTIME_DEVICE_API_H_
@@ -212,6 +213,7 @@ inline const char* DeviceName(int type) {
   switch (type) {
     case kDLCPU: return "cpu";
     case kDLGPU: return "gpu";
+    case kDLCPUPinned: return "cpu_pinned";
     case kDLOpenCL: return "opencl";
     case kDLSDAccel: return "sdaccel";
     case kDLAOCL: return "aocl";
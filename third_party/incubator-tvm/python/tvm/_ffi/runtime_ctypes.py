@@ -18,6 +18,7 @@
 # pylint: disable=invalid-name
 
 # 2019.12.30 - Add new type code for cce.
+# 2026.10.16 - Add the context of page-locked host memory.
 
 from __future__ import absolute_import
 
@@ -136,6 +137,7 @@ class TVMContext(ctypes.Structure):
     MASK2STR = {
         1 : 'cpu',
         2 : 'gpu',
+        3 : 'cpu_pinned',
         4 : 'opencl',
         5 : 'aocl',
         6 : 'sdaccel',
@@ -156,6 +158,7 @@ class TVMContext(ctypes.Structure):
         'gpu': 2,
         'cuda': 2,
         'nvptx': 2,
+        'cpu_pinned': 3,
         'cl': 4,
         'opencl': 4,
         'aocl' : 5,
@@ -0,0 +1,301 @@
+/*!
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file cce_copy_engine.cc
+ * \brief Pipelined host-device copy through pinned staging buffers
+ */
+
+/*!
+ * 2026.10.16 - Add file cce_copy_engine.cc.
+ */
+
+#include "runtime/cce/cce_copy_engine.h"
+
+#include <dmlc/logging.h>
+#include <tvm/runtime/registry.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "runtime/cce/cce_common.h"
+
+#ifdef CCE_USE_COPY_ENGINE
+namespace air {
+namespace runtime {
+namespace {
+constexpr size_t kDefaultChunkSize = 8 * 1024 * 1024;
+constexpr size_t kDefaultMinStagedSize = 1024 * 1024;
+// copies on the synchronous path are split into blocks, because the runtime
+// cannot copy very large pageable (non page-locked) buffers in one call.
+constexpr size_t kSyncBlockSize = 1024 * 1024 * 1024;
+// two staging buffers are in use at a time, keep a few more for concurrent users.
+constexpr size_t kMaxCachedBuffers = 4;
+
+size_t GetEnvSize(const char* name, size_t dft) {
+  const char* value = getenv(name);
+  if (value == nullptr || *value == '\0') {
+    return dft;
+  }
+  char* end = nullptr;
+  auto res = strtoull(value, &end, 10);
+  if (end == value) {
+    LOG(WARNING) << "ignore invalid value of " << name << ": " << value;
+    return dft;
+  }
+  return static_cast<size_t>(res);
+}
+
+inline const char* Offset(const void* ptr, size_t offset) { return static_cast<const char*>(ptr) + offset; }
+
+inline char* Offset(void* ptr, size_t offset) { return static_cast<char*>(ptr) + offset; }
+}  // namespace
+
+CcePinnedBufferPool::~CcePinnedBufferPool() {
+  for (auto ptr : free_list_) {
+    static_cast<void>(rtFreeHost(ptr));
+  }
+}
+
+void* CcePinnedBufferPool::Acquire() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!free_list_.empty()) {
+      void* ptr = free_list_.back();
+      free_list_.pop_back();
+      return ptr;
+    }
+  }
+  return AllocHost(buffer_size_);
+}
+
+void CcePinnedBufferPool::Release(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_list_.size() < max_cached_) {
+      free_list_.push_back(ptr);
+      return;
+    }
+  }
+  FreeHost(ptr);
+}
+
+void* CcePinnedBufferPool::AllocHost(size_t size) {
+  void* ptr = nullptr;
+  CCE_CALL(rtMallocHost(&ptr, size));
+  std::lock_guard<std::mutex> lock(mutex_);
+  pinned_regions_[reinterpret_cast<uintptr_t>(ptr)] = size;
+  ++num_allocated_;
+  return ptr;
+}
+
+void CcePinnedBufferPool::FreeHost(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pinned_regions_.erase(reinterpret_cast<uintptr_t>(ptr));
+  }
+  CCE_CALL(rtFreeHost(ptr));
+}
+
+size_t CcePinnedBufferPool::num_allocated() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_allocated_;
+}
+
+bool CcePinnedBufferPool::IsPinned(const void* ptr, size_t size) const {
+  auto addr = reinterpret_cast<uintptr_t>(ptr);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = pinned_regions_.upper_bound(addr);
+  if (it == pinned_regions_.begin()) {
+    return false;
+  }
+  --it;
+  return addr + size <= it->first + it->second;
+}
+
+CceCopyEngine::CceCopyEngine()
+    : enabled_(GetEnvSize("AKG_CCE_COPY_ENGINE", 1) != 0),
+      min_staged_size_(GetEnvSize("AKG_CCE_COPY_MIN_SIZE", kDefaultMinStagedSize)),
+      pool_(std::max<size_t>(GetEnvSize("AKG_CCE_COPY_CHUNK_SIZE", kDefaultChunkSize), 1), kMaxCachedBuffers) {}
+
+CceCopyEngine::~CceCopyEngine() {
+  for (auto event : events_) {
+    if (event != nullptr) {
+      static_cast<void>(rtEventDestroy(event));
+    }
+  }
+  if (stream_ != nullptr) {
+    static_cast<void>(rtStreamDestroy(stream_));
+  }
+}
+
+CceCopyStats CceCopyEngine::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+CceCopyStats CceCopyEngine::ResetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CceCopyStats res = stats_;
+  stats_ = CceCopyStats();
+  return res;
+}
+
+CceCopyEngine* CceCopyEngine::Global() {
+  static CceCopyEngine inst;
+  return &inst;
+}
+
+void CceCopyEngine::EnsureStream() {
+  int32_t device_id = 0;
+  CCE_CALL(rtGetDevice(&device_id));
+  if (stream_ != nullptr && device_id == device_id_) {
+    return;
+  }
+  // streams and events belong to the device they were created on
+  for (auto& event : events_) {
+    if (event != nullptr) {
+      CCE_CALL(rtEventDestroy(event));
+      event = nullptr;
+    }
+  }
+  if (stream_ != nullptr) {
+    CCE_CALL(rtStreamDestroy(stream_));
+    stream_ = nullptr;
+  }
+  CCE_CALL(rtStreamCreate(&stream_, 0));
+  for (auto& event : events_) {
+    CCE_CALL(rtEventCreate(&event));
+  }
+  device_id_ = device_id;
+}
+
+void CceCopyEngine::Copy(const void* from, void* to, size_t num_bytes, rtMemcpyKind_t kind) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stats_.num_copies;
+  stats_.bytes += num_bytes;
+  if (!enabled_ || num_bytes < min_staged_size_) {
+    ++stats_.num_sync;
+    SyncCopy(from, to, num_bytes, kind);
+    return;
+  }
+
+  EnsureStream();
+  bool direct = kind == RT_MEMCPY_DEVICE_TO_DEVICE ||
+                (kind == RT_MEMCPY_HOST_TO_DEVICE && pool_.IsPinned(from, num_bytes)) ||
+                (kind == RT_MEMCPY_DEVICE_TO_HOST && pool_.IsPinned(to, num_bytes));
+  if (direct) {
+    ++stats_.num_direct;
+    DirectCopy(from, to, num_bytes, kind);
+  } else if (kind == RT_MEMCPY_HOST_TO_DEVICE) {
+    ++stats_.num_staged;
+    StagedHostToDevice(from, to, num_bytes);
+  } else if (kind == RT_MEMCPY_DEVICE_TO_HOST) {
+    ++stats_.num_staged;
+    StagedDeviceToHost(from, to, num_bytes);
+  } else {
+    ++stats_.num_sync;
+    SyncCopy(from, to, num_bytes, kind);
+  }
+}
+
+void CceCopyEngine::SyncCopy(const void* from, void* to, size_t num_bytes, rtMemcpyKind_t kind) {
+  for (size_t offset = 0; offset < num_bytes; offset += kSyncBlockSize) {
+    size_t len = std::min(kSyncBlockSize, num_bytes - offset);
+    CCE_CALL(rtMemcpy(Offset(to, offset), len, Offset(from, offset), len, kind));
+  }
+}
+
+void CceCopyEngine::DirectCopy(const void* from, void* to, size_t num_bytes, rtMemcpyKind_t kind) {
+  size_t chunk = pool_.buffer_size();
+  for (size_t offset = 0; offset < num_bytes; offset += chunk) {
+    size_t len = std::min(chunk, num_bytes - offset);
+    CCE_CALL(rtMemcpyAsync(Offset(to, offset), len, Offset(from, offset), len, kind, stream_));
+  }
+  CCE_CALL(rtStreamSynchronize(stream_));
+}
+
+void CceCopyEngine::StagedHostToDevice(const void* from, void* to, size_t num_bytes) {
+  size_t chunk = pool_.buffer_size();
+  void* staging[kNumStages] = {pool_.Acquire(), pool_.Acquire()};
+  size_t idx = 0;
+  for (size_t offset = 0; offset < num_bytes; offset += chunk, ++idx) {
+    size_t len = std::min(chunk, num_bytes - offset);
+    size_t stage = idx % kNumStages;
+    // the staging buffer is free again once the transfer issued kNumStages chunks ago has finished
+    if (idx >= kNumStages) {
+      CCE_CALL(rtEventSynchronize(events_[stage]));
+    }
+    memcpy(staging[stage], Offset(from, offset), len);
+    CCE_CALL(rtMemcpyAsync(Offset(to, offset), len, staging[stage], len, RT_MEMCPY_HOST_TO_DEVICE, stream_));
+    CCE_CALL(rtEventRecord(events_[stage], stream_));
+  }
+  CCE_CALL(rtStreamSynchronize(stream_));
+  for (auto ptr : staging) {
+    pool_.Release(ptr);
+  }
+}
+
+void CceCopyEngine::StagedDeviceToHost(const void* from, void* to, size_t num_bytes) {
+  size_t chunk = pool_.buffer_size();
+  void* staging[kNumStages] = {pool_.Acquire(), pool_.Acquire()};
+  size_t num_chunks = (num_bytes + chunk - 1) / chunk;
+  // issue chunk i, then unpack chunk i - 1 on the host while chunk i is in flight
+  for (size_t idx = 0; idx <= num_chunks; ++idx) {
+    if (idx < num_chunks) {
+      size_t offset = idx * chunk;
+      size_t len = std::min(chunk, num_bytes - offset);
+      size_t stage = idx % kNumStages;
+      CCE_CALL(rtMemcpyAsync(staging[stage], len, Offset(from, offset), len, RT_MEMCPY_DEVICE_TO_HOST, stream_));
+      CCE_CALL(rtEventRecord(events_[stage], stream_));
+    }
+    if (idx > 0) {
+      size_t prev_offset = (idx - 1) * chunk;
+      size_t prev_len = std::min(chunk, num_bytes - prev_offset);
+      size_t prev_stage = (idx - 1) % kNumStages;
+      CCE_CALL(rtEventSynchronize(events_[prev_stage]));
+      memcpy(Offset(to, prev_offset), staging[prev_stage], prev_len);
+    }
+  }
+  for (auto ptr : staging) {
+    pool_.Release(ptr);
+  }
+}
+
+TVM_REGISTER_GLOBAL("device_api.cce.copy_stats").set_body([](TVMArgs args, TVMRetValue* rv) {
+  auto engine = CceCopyEngine::Global();
+  bool reset = args.size() > 0 && static_cast<bool>(args[0]);
+  CceCopyStats stats = reset ? engine->ResetStats() : engine->stats();
+  std::string res = "{\"num_copies\": " + std::to_string(stats.num_copies) +
+                    ", \"num_staged\": " + std::to_string(stats.num_staged) +
+                    ", \"num_direct\": " + std::to_string(stats.num_direct) +
+                    ", \"num_sync\": " + std::to_string(stats.num_sync) +
+                    ", \"bytes\": " + std::to_string(stats.bytes) +
+                    ", \"pinned_buffers\": " + std::to_string(engine->pool().num_allocated()) + "}";
+  *rv = res;
+});
+}  // namespace runtime
+}  // namespace air
+#endif  // CCE_USE_COPY_ENGINE
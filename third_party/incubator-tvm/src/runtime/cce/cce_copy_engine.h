@@ -0,0 +1,141 @@
+/*!
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file cce_copy_engine.h
+ * \brief Pipelined host-device copy through pinned staging buffers
+ */
+
+/*!
+ * 2026.10.16 - Add file cce_copy_engine.h.
+ */
+
+#ifndef TVM_RUNTIME_CCE_CCE_COPY_ENGINE_H_
+#define TVM_RUNTIME_CCE_CCE_COPY_ENGINE_H_
+
+#include <runtime/rt.h>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+// the kc air runtime only provides synchronous copies with a different contract
+#if defined(USE_CCE_RT) && !defined(USE_KC_AIR)
+#define CCE_USE_COPY_ENGINE 1
+#endif
+
+namespace air {
+namespace runtime {
+/*!
+ * \brief Pool of page-locked host buffers of a fixed size.
+ *
+ *  Buffers are allocated with rtMallocHost on first use and kept for reuse, so
+ *  the pinning cost is paid once per process instead of once per copy.
+ */
+class CcePinnedBufferPool {
+ public:
+  explicit CcePinnedBufferPool(size_t buffer_size, size_t max_cached)
+      : buffer_size_(buffer_size), max_cached_(max_cached) {}
+  ~CcePinnedBufferPool();
+
+  /*! \brief get one buffer of buffer_size() bytes, allocating if the free list is empty */
+  void* Acquire();
+  /*! \brief return a buffer obtained by Acquire */
+  void Release(void* ptr);
+  /*! \brief allocate a pinned host region of arbitrary size, backs kDLCPUPinned arrays */
+  void* AllocHost(size_t size);
+  /*! \brief free a region obtained by AllocHost */
+  void FreeHost(void* ptr);
+  /*! \brief whether [ptr, ptr + size) lies inside one pinned region owned by the pool */
+  bool IsPinned(const void* ptr, size_t size) const;
+
+  size_t buffer_size() const { return buffer_size_; }
+  size_t num_allocated() const;
+
+ private:
+  size_t buffer_size_;
+  size_t max_cached_;
+  size_t num_allocated_{0};
+  std::vector<void*> free_list_;
+  // start address -> size of every live pinned region, used to detect pinned user pointers
+  std::map<uintptr_t, size_t> pinned_regions_;
+  mutable std::mutex mutex_;
+};
+
+/*! \brief Statistics of one CceCopyEngine, reset on demand */
+struct CceCopyStats {
+  uint64_t num_copies{0};
+  uint64_t num_staged{0};
+  uint64_t num_direct{0};
+  uint64_t num_sync{0};
+  uint64_t bytes{0};
+};
+
+/*!
+ * \brief Copy engine used by CceDeviceAPI when no stream is set.
+ *
+ *  Large copies are split into chunks and issued on a dedicated copy stream.
+ *  A pageable host side goes through two pinned staging buffers: while chunk i
+ *  is in flight on the device, the host packs (or unpacks) chunk i + 1 into the
+ *  other buffer. A pinned host side is copied chunk by chunk without staging.
+ *  Small copies keep the synchronous rtMemcpy path.
+ *
+ *  Tunables (read once from the environment):
+ *   - AKG_CCE_COPY_ENGINE: set to 0 to fall back to the synchronous path.
+ *   - AKG_CCE_COPY_CHUNK_SIZE: bytes per chunk, default 8 MiB.
+ *   - AKG_CCE_COPY_MIN_SIZE: copies below this size stay synchronous, default 1 MiB.
+ */
+class CceCopyEngine {
+ public:
+  CceCopyEngine();
+  ~CceCopyEngine();
+
+  /*! \brief blocking copy; returns when the destination holds the data */
+  void Copy(const void* from, void* to, size_t num_bytes, rtMemcpyKind_t kind);
+
+  CcePinnedBufferPool& pool() { return pool_; }
+  /*! \brief snapshot of the statistics, safe against concurrent copies */
+  CceCopyStats stats() const;
+  /*! \brief reset the statistics, returning their values before the reset */
+  CceCopyStats ResetStats();
+
+  static CceCopyEngine* Global();
+
+ private:
+  static constexpr size_t kNumStages = 2;
+
+  void EnsureStream();
+  void SyncCopy(const void* from, void* to, size_t num_bytes, rtMemcpyKind_t kind);
+  void DirectCopy(const void* from, void* to, size_t num_bytes, rtMemcpyKind_t kind);
+  void StagedHostToDevice(const void* from, void* to, size_t num_bytes);
+  void StagedDeviceToHost(const void* from, void* to, size_t num_bytes);
+
+  bool enabled_{true};
+  size_t min_staged_size_;
+  CcePinnedBufferPool pool_;
+  CceCopyStats stats_;
+  int32_t device_id_{-1};
+  rtStream_t stream_{nullptr};
+  rtEvent_t events_[kNumStages]{nullptr, nullptr};
+  mutable std::mutex mutex_;
+};
+}  // namespace runtime
+}  // namespace air
+#endif  // TVM_RUNTIME_CCE_CCE_COPY_ENGINE_H_
@@ -24,6 +24,8 @@
 
 /*!
  * 2019.12.30 - Add file cce_device_api.cc.
+ * 2026.10.16 - Route blocking copies through CceCopyEngine.
+ *             - Allocate page-locked host memory for kDLCPUPinned.
  */
 
 #include <tvm/runtime/device_api.h>
@@ -32,7 +34,9 @@
 #include <dmlc/thread_local.h>
 #include <runtime/rt.h>
 #include <tvm/runtime/registry.h>
+#include <cstring>
 #include "runtime/cce/cce_common.h"
+#include "runtime/cce/cce_copy_engine.h"
 #include "prof_mgr_core.h"
 
 namespace air {
@@ -79,6 +83,12 @@ class CceDeviceAPI final : public DeviceAPI {
 
   void* AllocDataSpace(TVMContext ctx, size_t size, size_t alignment, TVMType type_hint) final {
     void* ptr = nullptr;
+#ifdef CCE_USE_COPY_ENGINE
+    if (ctx.device_type == kDLCPUPinned) {
+      // the copy engine transfers page-locked host regions without staging
+      return CceCopyEngine::Global()->pool().AllocHost(size);
+    }
+#endif
 
     // alignment check here
     CCE_CALL(rtSetDevice(ctx.device_id));
@@ -88,6 +98,12 @@ class CceDeviceAPI final : public DeviceAPI {
   }
 
   void FreeDataSpace(TVMContext ctx, void* ptr) final {
+#ifdef CCE_USE_COPY_ENGINE
+    if (ctx.device_type == kDLCPUPinned) {
+      CceCopyEngine::Global()->pool().FreeHost(ptr);
+      return;
+    }
+#endif
     if (ptr != nullptr) {
       CCE_CALL(rtSetDevice(ctx.device_id));
       CCE_CALL(rtFree(ptr));
@@ -96,7 +112,7 @@ class CceDeviceAPI final : public DeviceAPI {
 
   void CopyDataFromTo(const void* from, size_t from_offset, void* to, size_t to_offset, size_t num_bytes,
                       TVMContext ctx_from, TVMContext ctx_to, TVMType type_hint, TVMStreamHandle stream) final {
-    LOG(INFO) << " from " << from << " to " << to << " ctx_from " << ctx_from;
+    DLOG(INFO) << " from " << from << " to " << to << " ctx_from " << ctx_from;
     auto cce_stream = static_cast<rtStream_t>(stream);
     from = static_cast<const char*>(from) + from_offset;
     to = static_cast<char*>(to) + to_offset;
@@ -108,12 +124,14 @@ class CceDeviceAPI final : public DeviceAPI {
       } else {
         LOG(FATAL) << "expect the same device id copy between Cce";
       }
-    } else if (ctx_from.device_type == kDLCce && ctx_to.device_type == kDLCPU) {
+    } else if (ctx_from.device_type == kDLCce && IsHost(ctx_to)) {
       CCE_CALL(rtSetDevice(ctx_from.device_id));
       CceCopy(from, to, num_bytes, RT_MEMCPY_DEVICE_TO_HOST, cce_stream);
-    } else if (ctx_from.device_type == kDLCPU && ctx_to.device_type == kDLCce) {
+    } else if (IsHost(ctx_from) && ctx_to.device_type == kDLCce) {
       CCE_CALL(rtSetDevice(ctx_to.device_id));
       CceCopy(from, to, num_bytes, RT_MEMCPY_HOST_TO_DEVICE, cce_stream);
+    } else if (IsHost(ctx_from) && IsHost(ctx_to)) {
+      memcpy(to, from, num_bytes);
     } else {
       LOG(FATAL) << "expect copy from/to Cce or between Cce";
     }
@@ -152,6 +170,8 @@ class CceDeviceAPI final : public DeviceAPI {
   }
 
  private:
+  static bool IsHost(TVMContext ctx) { return ctx.device_type == kDLCPU || ctx.device_type == kDLCPUPinned; }
+
   static void CceCopy(const void* from, void* to, size_t num_bytes, rtMemcpyKind_t kind, rtStream_t stream) {
     if (stream != RT_STREAM_DEFAULT) {
 #ifdef USE_CCE_RT
@@ -160,24 +180,11 @@ class CceDeviceAPI final : public DeviceAPI {
       CCE_CALL(rtMemcpyAsync(to, const_cast<void*>(from), num_bytes, kind, stream));
 #endif
     } else {
-#ifdef USE_CCE_RT
-#ifdef USE_KC_AIR
+#ifdef CCE_USE_COPY_ENGINE
+      // pipelined copy through pinned staging buffers on a dedicated copy stream
+      CceCopyEngine::Global()->Copy(from, to, num_bytes, kind);
+#elif defined(USE_CCE_RT)
       CCE_CALL(rtMemcpy(to, num_bytes, from, num_bytes, kind));
-#else
-
-      // because cce runtime cannot support large size memcpy when des/src is alloc by general
-      // malloc(not page-pinned), so we copy with large size by small blocks.
-      size_t block_size = 1024 * 1024 * 1024;
-      for (size_t i = 0; i < num_bytes / block_size; i++) {
-        CCE_CALL(rtMemcpy(to, block_size, const_cast<void*>(from), block_size, kind));
-        from = reinterpret_cast<char*>(const_cast<void*>(from)) + block_size;
-        to = reinterpret_cast<char*>(to) + block_size;
-      }
-      size_t remain = num_bytes % block_size;
-      if (remain > 0) {
-        CCE_CALL(rtMemcpy(to, remain, const_cast<void*>(from), remain, kind));
-      }
-#endif
 #else
       CCE_CALL(rtMemcpy(to, const_cast<void*>(from), num_bytes, kind));
 #endif
@@ -195,5 +202,12 @@ TVM_REGISTER_GLOBAL("device_api.cce").set_body([](TVMArgs args, TVMRetValue* rv)
   DeviceAPI* ptr = CceDeviceAPI::Global().get();
   *rv = static_cast<void*>(ptr);
 });
+
+#ifdef CCE_USE_COPY_ENGINE
+TVM_REGISTER_GLOBAL("device_api.cpu_pinned").set_body([](TVMArgs args, TVMRetValue* rv) {
+  DeviceAPI* ptr = CceDeviceAPI::Global().get();
+  *rv = static_cast<void*>(ptr);
+});
+#endif
 }  // namespace runtime
 }  // namespace air
@@ -24,6 +24,7 @@
 
 /*
  * 2019.12.30 - Add nullptr check and param init.
+ * 2026.10.16 - Allow copies between page-locked host memory and a device.
  */
 
 #include <dmlc/logging.h>
@@ -181,11 +182,13 @@ void NDArray::CopyFromTo(DLTensor* from,
 
   CHECK(from->ctx.device_type == to->ctx.device_type
         || from->ctx.device_type == kDLCPU
-        || to->ctx.device_type == kDLCPU)
+        || to->ctx.device_type == kDLCPU
+        || from->ctx.device_type == kDLCPUPinned
+        || to->ctx.device_type == kDLCPUPinned)
     << "Can not copy across different ctx types directly";
 
   // Use the context that is *not* a cpu context to get the correct device
-  // api manager.
+  // api manager, pinned host memory belongs to the device api that pinned it.
   TVMContext ctx = from->ctx.device_type != kDLCPU ? from->ctx : to->ctx;
 
   DeviceAPI::Get(ctx)->CopyDataFromTo(